@@ -0,0 +1,31 @@
+#!/bin/bash
+
+# Usage: chain.sh EBMC SECOND OPTIONS... FIRST
+# Runs EBMC with a fresh --proof-cache on FIRST, and then with the
+# same cache on SECOND. The output of both runs is shown, followed
+# by the cache. The exit code is the one of the second run.
+
+set -e
+
+ebmc=$1
+second=$2
+shift 2
+first=${@: -1}
+options=("${@:1:$#-1}")
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+cache="$work/cache.json"
+
+"$ebmc" "${options[@]}" --proof-cache "$cache" "$first" || true
+
+echo "Second run"
+
+status=0
+"$ebmc" "${options[@]}" --proof-cache "$cache" "$second" || status=$?
+
+echo "Proof cache"
+cat "$cache"
+
+exit $status
@@ -0,0 +1,18 @@
+module main(input clk);
+
+  reg [3:0] x, y;
+
+  initial x = 0;
+  initial y = 0;
+
+  always @(posedge clk) begin
+    if(x < 10)
+      x <= x + 1;
+    if(y < 9)
+      y <= y + 1;
+  end
+
+  p1: assert property (x <= 10);
+  p2: assert property (y <= 10);
+
+endmodule
@@ -0,0 +1,16 @@
+module main(input clk);
+
+  reg [3:0] x;
+
+  initial x = 0;
+
+  always @(posedge clk)
+    if(x == 5)
+      x <= 0;
+    else
+      x <= x + 1;
+
+  // holds, but is not 1-inductive
+  p1: assert property (x != 8);
+
+endmodule
@@ -0,0 +1,14 @@
+module main(input clk);
+
+  reg [3:0] x;
+
+  initial x = 0;
+
+  always @(posedge clk)
+    if(x < 10)
+      x <= x + 1;
+
+  // 1-inductive
+  p1: assert property (x <= 10);
+
+endmodule
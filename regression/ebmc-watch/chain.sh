@@ -0,0 +1,59 @@
+#!/bin/bash
+
+# Usage: chain.sh EBMC EDITED[:TARGET] OPTIONS... DESIGN
+# Runs EBMC --watch in a copy of the test directory, replaces the copy
+# of TARGET, which is DESIGN unless given, by EDITED once the first
+# check is done, and stops EBMC once the edited design has been
+# checked. The output of EBMC is then shown.
+
+set -e
+
+ebmc=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+edited=${2%%:*}
+target=${2#*:}
+if [ "$target" = "$2" ]; then
+  target=""
+fi
+shift 2
+design=${@: -1}
+options=("${@:1:$#-1}")
+target=${target:-$design}
+
+work=$(mktemp -d)
+output=$(mktemp)
+trap 'rm -rf "$work" "$output"' EXIT
+
+cp -r . "$work"
+cd "$work"
+
+"$ebmc" --watch "${options[@]}" "$design" > "$output" 2>&1 &
+pid=$!
+
+# waits until EBMC has finished the given number of checks
+wait_for_checks()
+{
+  for i in $(seq 1 600); do
+    if [ "$(grep -c '^Watching ' "$output")" -ge "$1" ]; then
+      return 0
+    fi
+    sleep 0.1
+  done
+  echo "timeout waiting for check $1"
+  return 1
+}
+
+status=0
+
+if wait_for_checks 1; then
+  cp "$edited" "$target"
+  wait_for_checks 2 || status=1
+else
+  status=1
+fi
+
+kill "$pid"
+wait "$pid" || true
+
+cat "$output"
+
+exit $status
@@ -0,0 +1,15 @@
+module main(input clk);
+
+  reg [7:0] x;
+
+  initial x = 0;
+
+  always @(posedge clk)
+    if(x < 10)
+      x <= x + 1;
+
+  p1: assert property (x <= 10);
+
+  p2: assert property (x != 3);
+
+endmodule
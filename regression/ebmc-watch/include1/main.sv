@@ -0,0 +1,15 @@
+`include "limit.vh"
+
+module main(input clk);
+
+  reg [3:0] x;
+
+  initial x = 0;
+
+  always @(posedge clk)
+    if(x < `LIMIT)
+      x <= x + 1;
+
+  p1: assert property (x <= 10);
+
+endmodule
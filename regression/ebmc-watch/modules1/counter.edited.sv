@@ -0,0 +1,9 @@
+module counter(input clk, output reg [3:0] x);
+
+  initial x = 0;
+
+  always @(posedge clk)
+    if(x < 12)
+      x <= x + 1;
+
+endmodule
@@ -0,0 +1,9 @@
+module main(input clk);
+
+  wire [3:0] y;
+
+  counter c(clk, y);
+
+  p1: assert property (y <= 10);
+
+endmodule
@@ -0,0 +1,10 @@
+module other(input clk);
+
+  reg z;
+
+  initial z = 0;
+
+  always @(posedge clk)
+    z <= !z;
+
+endmodule
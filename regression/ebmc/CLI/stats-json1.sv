@@ -0,0 +1,10 @@
+module main(input clk);
+
+  reg [7:0] counter = 0;
+
+  always @(posedge clk)
+    counter = counter + 1;
+
+  p1: assert property (counter != 10);
+
+endmodule
@@ -0,0 +1,17 @@
+module main(input clk);
+
+  reg [7:0] x;
+
+  initial x = 0;
+
+  always @(posedge clk)
+    if(x < 10)
+      x <= x + 1;
+
+  // true, and 1-inductive
+  p1: assert property (x <= 10);
+
+  // false
+  p2: assert property (x != 3);
+
+endmodule
@@ -0,0 +1,17 @@
+module main(input clk);
+
+  reg [7:0] x, y;
+
+  initial x = 0;
+  initial y = 0;
+
+  always @(posedge clk) begin
+    if(x < 10)
+      x <= x + 1;
+    y <= x;
+  end
+
+  // true, but not 1-inductive
+  p1: assert property (y != 11);
+
+endmodule
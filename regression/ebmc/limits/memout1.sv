@@ -0,0 +1,14 @@
+module main(input clk);
+
+  reg [63:0] x;
+
+  initial x = 3;
+
+  // a 64-bit multiplier in each timeframe
+  always @(posedge clk)
+    x <= x * x;
+
+  // true, x stays odd
+  p1: assert property (x[0]);
+
+endmodule
@@ -0,0 +1,16 @@
+module main(input clk);
+
+  reg [63:0] x;
+
+  initial x = 0;
+
+  always @(posedge clk)
+    x <= x + 1;
+
+  // false, but only after 2^64-1 steps
+  p1: assert property (x != 64'hffff_ffff_ffff_ffff);
+
+  // false
+  p2: assert property (x != 3);
+
+endmodule
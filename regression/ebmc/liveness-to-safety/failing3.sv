@@ -0,0 +1,18 @@
+module main(input clk);
+
+  reg my_bit;
+  reg [15:0] counter;
+
+  initial my_bit=0;
+  initial counter=0;
+
+  always @(posedge clk) begin
+    my_bit = 0;
+    counter = counter + 1;
+  end
+
+  // expected to fail, with a loop that does not
+  // need to wait for the unrelated counter to wrap around
+  p0: assert property (s_eventually my_bit);
+
+endmodule
@@ -0,0 +1,14 @@
+module main(input clk);
+
+  reg [2:0] state;
+
+  initial state = 3'b001;
+
+  // a one-hot state machine
+  always @(posedge clk)
+    state <= {state[1:0], state[2]};
+
+  // true, but not 1-inductive without the one-hot invariant
+  p1: assert property (state != 3'b011);
+
+endmodule
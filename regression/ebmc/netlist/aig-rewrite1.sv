@@ -0,0 +1,17 @@
+module main(input clk, input [7:0] a, input [7:0] b, input [3:0] s);
+
+  reg [7:0] acc = 0;
+
+  // deep chains, and redundant logic
+  wire all_ones = &a;
+  wire any_one = |b;
+  wire mux = s[0] ? (s[1] & s[2]) : (s[1] & s[2] & s[3]);
+
+  always @(posedge clk)
+    acc = acc + (all_ones ? 1 : 0) + (mux & any_one ? 2 : 0);
+
+  p1: assert property (all_ones == (a == 255));
+  p2: assert property (mux == (s[1] && s[2] && (s[0] || s[3])));
+  p3: assert property (acc != 3);
+
+endmodule
@@ -0,0 +1,20 @@
+module main(input clk, input sel, input [7:0] a, input [7:0] b);
+
+  reg [7:0] x = 0, y = 0, acc = 0;
+
+  // XOR, MUX and wide AND structures in the netlist
+  wire [7:0] d = x ^ y;
+  wire [7:0] m = sel ? a : b;
+  wire all = &acc;
+
+  always @(posedge clk) begin
+    x = x + 1;
+    y = y + 1;
+    acc = acc ^ m;
+  end
+
+  p1: assert property (d == 0);
+  p2: assert property (!all);
+  p3: assert property (x != 3);
+
+endmodule
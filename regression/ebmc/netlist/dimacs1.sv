@@ -0,0 +1,10 @@
+module main(input clk);
+
+  reg [3:0] x = 0;
+
+  always @(posedge clk)
+    x = x + 1;
+
+  p1: assert property (x != 10);
+
+endmodule
@@ -0,0 +1,23 @@
+module main(input clk, input [7:0] a, input [7:0] b);
+
+  reg [7:0] x = 0, y = 0;
+
+  // two different ways of computing the same comparator
+  wire lt1 = a < b;
+  wire lt2 = !(a >= b);
+
+  // a flag derived twice
+  wire z1 = x == 0;
+  wire z2 = ~|x;
+
+  always @(posedge clk) begin
+    x = lt1 ? x + 1 : x;
+    y = lt2 ? y + 1 : y;
+  end
+
+  p1: assert property (lt1 == lt2);
+  p2: assert property (z1 == z2);
+  p3: assert property (x == y);
+  p4: assert property (x != 2);
+
+endmodule
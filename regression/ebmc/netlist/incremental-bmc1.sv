@@ -0,0 +1,13 @@
+module main(input clk);
+
+  reg [7:0] x = 0;
+
+  always @(posedge clk)
+    x = x + 1;
+
+  // the shortest counterexamples have 4 and 6 states
+  p1: assert property (x != 3);
+  p2: assert property (x != 5);
+  p3: assert property (x <= 20);
+
+endmodule
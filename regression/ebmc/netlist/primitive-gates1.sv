@@ -0,0 +1,23 @@
+module main(input a, b, c, input [3:0] x, y);
+
+  wire w1, w2, w3, w4, w5, w6;
+  wire [3:0] v1, v2;
+
+  and g1(w1, a, b);
+  and g2(w2, a, b); // structurally identical to g1
+  nand g3(w3, a, b, c);
+  xor g4(w4, a, b, c);
+  xnor g5(w5, a, b);
+  or g6[3:0](v1, x, y);
+  nor g7[3:0](v2, x, y);
+  buf g8(w6, a);
+
+  always assert p1: w1 == w2;
+  always assert p2: w3 == !(a && b && c);
+  always assert p3: w4 == (a ^ b ^ c);
+  always assert p4: w5 == !(a ^ b);
+  always assert p5: v1 == (x | y);
+  always assert p6: v2 == ~(x | y);
+  always assert p7: w6 == a;
+
+endmodule
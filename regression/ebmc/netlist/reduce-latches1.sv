@@ -0,0 +1,20 @@
+module main(input clk, input [7:0] in);
+
+  // stuck at the reset value
+  reg [3:0] stuck = 5;
+
+  // replicated valid bits
+  reg valid1 = 0, valid2 = 0, not_valid = 1;
+
+  always @(posedge clk) begin
+    stuck = stuck;
+    valid1 = !valid1;
+    valid2 = !valid2;
+    not_valid = !not_valid;
+  end
+
+  p1: assert property (stuck == 5);
+  p2: assert property (valid1 == valid2 && valid1 != not_valid);
+  p3: assert property (in != 4 || valid1);
+
+endmodule
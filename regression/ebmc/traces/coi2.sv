@@ -0,0 +1,16 @@
+module main(input clk);
+
+  reg [7:0] x, y;
+
+  initial x = 0;
+  initial y = 0;
+
+  always @(posedge clk) begin
+    x <= x + 1;
+    y <= x;
+  end
+
+  // false; y reads x, but does not influence it
+  p1: assert property (x != 3);
+
+endmodule
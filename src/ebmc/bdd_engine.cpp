@@ -8,6 +8,8 @@ Author: Daniel Kroening, daniel.kroening@inf.ethz.ch
 
 #include "bdd_engine.h"
 
+#include <util/ebmc_limits.h>
+#include <util/ebmc_statistics.h>
 #include <util/expr_util.h>
 #include <util/format_expr.h>
 
@@ -195,6 +197,11 @@ property_checker_resultt bdd_enginet::operator()()
     netlist = make_netlist(
       transition_system, properties, message.get_message_handler());
 
+    if(cmdline.isset("memory-diet"))
+      netlist_memory_diet(transition_system);
+
+    simplify_netlist(netlist, cmdline, message.get_message_handler());
+
     message.statistics() << "Latches: " << netlist.var_map.latches.size()
                          << ", nodes: " << netlist.number_of_nodes()
                          << messaget::eom;
@@ -216,11 +223,15 @@ property_checker_resultt bdd_enginet::operator()()
 
     message.status() << "Building BDD for netlist" << messaget::eom;
 
-    allocate_vars(netlist.var_map);
-    build_BDDs();
+    {
+      ebmc_phaset phase("build BDDs");
+      allocate_vars(netlist.var_map);
+      build_BDDs();
+    }
 
     message.statistics() << "BDD nodes: " << mgr.number_of_nodes()
                          << messaget::eom;
+    ebmc_statistics().count("BDD nodes", mgr.number_of_nodes());
 
     if(cmdline.isset("show-bdds"))
     {
@@ -246,7 +257,10 @@ property_checker_resultt bdd_enginet::operator()()
     }
 
     for(propertyt &p : properties.properties)
+    {
       check_property(p);
+      properties.result_found(p);
+    }
 
     return property_checker_resultt{properties};
   }
@@ -515,16 +529,30 @@ void bdd_enginet::check_property(propertyt &property)
   message.status() << "Checking " << property.name << messaget::eom;
   property.status=propertyt::statust::UNKNOWN;
 
-  if(is_AGp(property.normalized_expr))
+  ebmc_property_clockt property_clock;
+
+  try
   {
-    check_AGp(property);
+    // the earlier properties may have used up the time
+    ebmc_limits().check();
+
+    if(is_AGp(property.normalized_expr))
+    {
+      check_AGp(property);
+    }
+    else if(is_CTL(property.normalized_expr))
+    {
+      check_CTL(property);
+    }
+    else
+      DATA_INVARIANT(false, "unexpected normalized property");
   }
-  else if(is_CTL(property.normalized_expr))
+  catch(const ebmc_limit_exceededt &limit)
   {
-    check_CTL(property);
+    message.warning() << "Giving up on " << property.name << ": "
+                      << limit.reason << messaget::eom;
+    property.inconclusive(limit.reason);
   }
-  else
-    DATA_INVARIANT(false, "unexpected normalized property");
 }
 
 /*******************************************************************\
@@ -557,6 +585,24 @@ void bdd_enginet::check_AGp(propertyt &property)
 
   while(true)
   {
+    if(auto reason = ebmc_limits().exceeded())
+    {
+      message.warning() << "Giving up on " << property.name << ": " << *reason
+                        << messaget::eom;
+
+      // the iterations so far have ruled out counterexamples
+      // with fewer transitions than iterations
+      if(iteration == 0)
+        property.inconclusive(*reason);
+      else
+      {
+        property.bound = iteration - 1;
+        property.inconclusive(
+          *reason + ", checked up to bound " + std::to_string(iteration - 1));
+      }
+      break;
+    }
+
     iteration++;
     message.statistics() << "Iteration " << iteration << messaget::eom;
 
@@ -570,9 +616,9 @@ void bdd_enginet::check_AGp(propertyt &property)
 
     if(!intersection.is_false())
     {
+      compute_counterexample(property, iteration);
       property.refuted();
       message.status() << "Property refuted" << messaget::eom;
-      compute_counterexample(property, iteration);
       break;
     }
 
@@ -804,6 +850,8 @@ bdd_enginet::BDD bdd_enginet::fixedpoint(std::function<BDD(BDD)> tau, BDD x)
   // Apply tau(x) until saturation.
   while(true)
   {
+    ebmc_limits().check();
+
     BDD image = tau(x);
 
     // fixpoint?
@@ -8,13 +8,18 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include "bmc.h"
 
+#include <util/ebmc_limits.h>
+#include <util/ebmc_statistics.h>
+
 #include <solvers/prop/literal_expr.h>
+#include <temporal-logic/temporal_logic.h>
 #include <trans-word-level/lasso.h>
 #include <trans-word-level/trans_trace_word_level.h>
 #include <trans-word-level/unwind.h>
 
 #include "ebmc_error.h"
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 
@@ -39,13 +44,38 @@ void bmc_with_assumptions(
 
     message.status() << "Checking " << property.name << messaget::eom;
 
+    ebmc_phaset phase(id2string(property.identifier));
+    ebmc_property_clockt property_clock;
+
     auto assumption = not_exprt{conjunction(property.timeframe_handles)};
 
+    // the earlier properties may have used up the time
+    if(auto reason = ebmc_limits().exceeded())
+    {
+      message.warning() << "Giving up on " << property.name << ": " << *reason
+                        << messaget::eom;
+      property.inconclusive(*reason);
+      properties.result_found(property);
+      continue;
+    }
+
+    ebmc_statistics().count("SAT calls");
     decision_proceduret::resultt dec_result = solver(assumption);
 
     switch(dec_result)
     {
     case decision_proceduret::resultt::D_SATISFIABLE:
+      {
+        ebmc_phaset trace_phase("trace");
+        property.witness_trace = compute_trans_trace(
+          property.timeframe_handles,
+          solver,
+          bound + 1,
+          ns,
+          transition_system.main_symbol->name,
+          property.trace_variables);
+      }
+
       if(property.is_exists_path())
       {
         property.proved();
@@ -56,13 +86,6 @@ void bmc_with_assumptions(
         property.refuted();
         message.result() << "SAT: counterexample found" << messaget::eom;
       }
-
-      property.witness_trace = compute_trans_trace(
-        property.timeframe_handles,
-        solver,
-        bound + 1,
-        ns,
-        transition_system.main_symbol->name);
       break;
 
     case decision_proceduret::resultt::D_UNSATISFIABLE:
@@ -89,6 +112,8 @@ void bmc_with_assumptions(
       property.failure();
       throw ebmc_errort() << "Unexpected result from decision procedure";
     }
+
+    properties.result_found(property);
   }
 }
 
@@ -112,14 +137,32 @@ void bmc_with_iterative_constraint_strengthening(
     return false;
   };
 
+  // each query is about all the remaining properties
+  ebmc_property_timest property_times;
+
   while(true)
   {
+    if(auto reason = ebmc_limits().exceeded())
+    {
+      message.warning() << "Giving up: " << *reason << messaget::eom;
+      properties.limit_exceeded(*reason);
+      return;
+    }
+
     // At least one of the remaining properties
     // should be falsified.
     exprt::operandst disjuncts;
 
     for(auto &property : properties.properties)
     {
+      if(property.is_unknown() && property_times.exceeded(property.identifier))
+      {
+        message.warning() << "Giving up on " << property.name
+                          << ": property timeout" << messaget::eom;
+        property.limit_exceeded("property timeout");
+        properties.result_found(property);
+      }
+
       if(property.is_unknown())
       {
         for(auto &h : property.timeframe_handles)
@@ -127,35 +170,70 @@ void bmc_with_iterative_constraint_strengthening(
       }
     }
 
+    if(disjuncts.empty())
+      return;
+
     // This constraint is strenthened in each iteration.
     solver.set_to_true(disjunction(disjuncts));
 
+    ebmc_statistics().count("SAT calls");
+    auto start = ebmc_property_timest::clockt::now();
     decision_proceduret::resultt dec_result = solver();
+    auto time = ebmc_property_timest::clockt::now() - start;
+
+    for(auto &property : properties.properties)
+      if(property.is_unknown())
+        property_times.charge(property.identifier, time);
 
     switch(dec_result)
     {
     case decision_proceduret::resultt::D_SATISFIABLE:
+    {
       // Found a trace for at least one further property with unknown state
       message.result() << "SAT: path found" << messaget::eom;
 
+      // The properties refuted by this model share one full trace,
+      // which is read from the solver when first needed.
+      std::optional<trans_tracet> full_trace;
+
       for(auto &property : properties.properties)
       {
         if(property.is_unknown() && trace_found(property))
         {
+          ebmc_phaset trace_phase("trace");
+          if(property.trace_variables.has_value())
+          {
+            property.witness_trace = compute_trans_trace(
+              property.timeframe_handles,
+              solver,
+              bound + 1,
+              ns,
+              transition_system.main_symbol->name,
+              property.trace_variables);
+          }
+          else
+          {
+            if(!full_trace.has_value())
+            {
+              full_trace = compute_trans_trace(
+                solver, bound + 1, ns, transition_system.main_symbol->name);
+            }
+
+            property.witness_trace = full_trace;
+            compute_property_failed(
+              property.timeframe_handles, solver, *property.witness_trace);
+          }
+
           if(property.is_exists_path())
             property.proved();
           else // universal path property
             property.refuted();
 
-          property.witness_trace = compute_trans_trace(
-            property.timeframe_handles,
-            solver,
-            bound + 1,
-            ns,
-            transition_system.main_symbol->name);
+          properties.result_found(property);
         }
       }
-      break; // next iteration of while loop
+    }
+    break; // next iteration of while loop
 
     case decision_proceduret::resultt::D_UNSATISFIABLE:
       message.result() << "UNSAT: No path found within bound" << messaget::eom;
@@ -168,6 +246,8 @@ void bmc_with_iterative_constraint_strengthening(
             property.refuted_with_bound(bound);
           else // universal path property
             property.proved_with_bound(bound);
+
+          properties.result_found(property);
         }
       }
       return;
@@ -222,6 +302,14 @@ static bool have_supported_property(ebmc_propertiest &properties)
   return have_supported;
 }
 
+/// The time frame handles of these properties depend on their
+/// time frame only.
+static bool is_invariant(const ebmc_propertiest::propertyt &property)
+{
+  const auto &expr = property.normalized_expr;
+  return is_Gp(expr) || is_AGp(expr) || is_SVA_always_p(expr);
+}
+
 property_checker_resultt bmc(
   std::size_t bound,
   bool convert_only,
@@ -252,13 +340,23 @@ property_checker_resultt bmc(
   auto &solver = solver_wrapper.decision_procedure();
   auto no_timeframes = bound + 1;
 
-  ::unwind(
-    transition_system.trans_expr,
-    message_handler,
-    solver,
-    no_timeframes,
-    ns,
-    true);
+  {
+    ebmc_phaset phase("unwind");
+    ::unwind(
+      transition_system.trans_expr,
+      message_handler,
+      solver,
+      no_timeframes,
+      ns,
+      true);
+  }
+
+  if(auto reason = ebmc_limits().exceeded())
+  {
+    message.warning() << "Giving up: " << *reason << messaget::eom;
+    properties.limit_exceeded(*reason);
+    return property_checker_resultt{std::move(properties)};
+  }
 
   // convert the properties
   message.status() << "Properties" << messaget::eom;
@@ -288,6 +386,14 @@ property_checker_resultt bmc(
     // If it's an assumption, then add it as constraint.
     if(property.is_assumed())
       solver.set_to_true(conjunction(property.timeframe_handles));
+    else if(property.seed_bound.has_value() && is_invariant(property))
+    {
+      // The time frames up to the seed bound satisfy the invariant.
+      const auto &handles = property.timeframe_handles;
+      auto frames = std::min(*property.seed_bound + 1, handles.size());
+      for(std::size_t t = 0; t < frames; t++)
+        solver.set_to_true(handles[t]);
+    }
   }
 
   // lasso constraints, if needed
@@ -330,6 +436,8 @@ property_checker_resultt bmc(
 
     auto sat_start_time = std::chrono::steady_clock::now();
 
+    ebmc_phaset phase("solve");
+
     if(bmc_with_assumptions)
     {
       ::bmc_with_assumptions(
@@ -173,7 +173,10 @@ property_checker_resultt completeness_threshold(
       // Turn "PROVED up to bound k" into "PROVED" if k>=CT
       auto property_ct_opt = completeness_threshold(property);
       if(property_ct_opt.has_value())
+      {
         property.proved("CT=" + integer2string(*property_ct_opt));
+        properties.result_found(property);
+      }
       else
         property.unknown();
     }
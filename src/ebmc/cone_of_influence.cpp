@@ -0,0 +1,266 @@
+/*******************************************************************\
+
+Module: Cone of Influence
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Cone of Influence
+
+#include "cone_of_influence.h"
+
+#include <util/mathematical_expr.h>
+#include <util/std_expr.h>
+
+#include <optional>
+
+/*******************************************************************\
+
+Function: collect_conjuncts
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void collect_conjuncts(const exprt &expr, std::vector<exprt> &dest)
+{
+  if(expr.id() == ID_and)
+  {
+    for(auto &op : expr.operands())
+      collect_conjuncts(op, dest);
+  }
+  else if(!expr.is_true())
+    dest.push_back(expr);
+}
+
+/*******************************************************************\
+
+Function: variables
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the identifiers of the symbols and next-state symbols
+
+\*******************************************************************/
+
+static std::unordered_set<irep_idt> variables(const exprt &expr)
+{
+  std::unordered_set<irep_idt> result;
+
+  expr.visit_pre([&result](const exprt &node) {
+    if(node.id() == ID_symbol || node.id() == ID_next_symbol)
+      result.insert(node.get(ID_identifier));
+  });
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: defined_variable
+
+  Inputs: the conjunct, and ID_symbol or ID_next_symbol
+
+ Outputs: the variable that the conjunct defines, if it is of the
+          form v = e or next(v) = e, where e does not depend on
+          the left-hand side
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::optional<irep_idt>
+defined_variable(const exprt &conjunct, const irep_idt &lhs_id)
+{
+  if(conjunct.id() != ID_equal)
+    return {};
+
+  const auto &equal = to_equal_expr(conjunct);
+
+  if(equal.lhs().id() != lhs_id)
+    return {};
+
+  const irep_idt &identifier = equal.lhs().get(ID_identifier);
+  bool cyclic = false;
+
+  equal.rhs().visit_pre(
+    [&identifier, &lhs_id, &cyclic](const exprt &node)
+    {
+      if(node.id() == lhs_id && node.get(ID_identifier) == identifier)
+        cyclic = true;
+    });
+
+  if(cyclic)
+    return {};
+
+  return identifier;
+}
+
+/*******************************************************************\
+
+Function: cone_of_influencet::cone_of_influencet
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+cone_of_influencet::cone_of_influencet(const transt &trans_expr)
+{
+  collect_conjuncts(trans_expr.init(), all_conjuncts);
+  const std::size_t init_end = all_conjuncts.size();
+  collect_conjuncts(trans_expr.invar(), all_conjuncts);
+  const std::size_t invar_end = all_conjuncts.size();
+  collect_conjuncts(trans_expr.trans(), all_conjuncts);
+
+  // The initial values (v = e in the initial state predicate),
+  // the combinational definitions (v = e in the invariant) and
+  // the next-state functions (next(v) = e in the transition
+  // relation) are the definitions of v. A variable that has more
+  // than one definition of a kind is constrained by them.
+  std::vector<std::optional<irep_idt>> defined;
+  defined.reserve(all_conjuncts.size());
+  std::unordered_map<irep_idt, std::size_t> initial_values, definitions;
+
+  for(std::size_t c = 0; c < all_conjuncts.size(); c++)
+  {
+    if(c < init_end)
+    {
+      defined.push_back(defined_variable(all_conjuncts[c], ID_symbol));
+      if(defined.back().has_value())
+        initial_values[*defined.back()]++;
+    }
+    else
+    {
+      defined.push_back(defined_variable(
+        all_conjuncts[c], c < invar_end ? ID_symbol : ID_next_symbol));
+      if(defined.back().has_value())
+        definitions[*defined.back()]++;
+    }
+  }
+
+  conjunct_variables.reserve(all_conjuncts.size());
+
+  for(std::size_t c = 0; c < all_conjuncts.size(); c++)
+  {
+    conjunct_variables.push_back(variables(all_conjuncts[c]));
+
+    const auto &count = c < init_end ? initial_values : definitions;
+
+    if(defined[c].has_value() && count.at(*defined[c]) == 1)
+    {
+      // the defined variable depends on the right-hand side,
+      // but not the other way around
+      uses[*defined[c]].push_back(c);
+    }
+    else
+    {
+      // a constraint relates all its variables
+      for(auto &identifier : conjunct_variables.back())
+        uses[identifier].push_back(c);
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: cone_of_influencet::closure
+
+  Inputs:
+
+ Outputs: the conjuncts that are in the cone of influence
+
+ Purpose: worklist closure over the conjuncts
+
+\*******************************************************************/
+
+std::vector<bool> cone_of_influencet::closure(
+  const exprt &expr,
+  std::unordered_set<irep_idt> &result) const
+{
+  result = variables(expr);
+  std::vector<irep_idt> queue(result.begin(), result.end());
+  std::vector<bool> done(conjunct_variables.size(), false);
+
+  while(!queue.empty())
+  {
+    irep_idt identifier = queue.back();
+    queue.pop_back();
+
+    auto uses_it = uses.find(identifier);
+    if(uses_it == uses.end())
+      continue;
+
+    for(auto c : uses_it->second)
+    {
+      if(done[c])
+        continue;
+
+      done[c] = true;
+
+      for(auto &other : conjunct_variables[c])
+        if(result.insert(other).second)
+          queue.push_back(other);
+    }
+  }
+
+  return done;
+}
+
+/*******************************************************************\
+
+Function: cone_of_influencet::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::unordered_set<irep_idt>
+cone_of_influencet::operator()(const exprt &expr) const
+{
+  std::unordered_set<irep_idt> result;
+  closure(expr, result);
+  return result;
+}
+
+/*******************************************************************\
+
+Function: cone_of_influencet::conjuncts
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::vector<exprt> cone_of_influencet::conjuncts(const exprt &expr) const
+{
+  std::unordered_set<irep_idt> variables;
+  auto done = closure(expr, variables);
+
+  std::vector<exprt> result;
+
+  // the conjuncts without variables constrain everything
+  for(std::size_t c = 0; c < all_conjuncts.size(); c++)
+    if(done[c] || conjunct_variables[c].empty())
+      result.push_back(all_conjuncts[c]);
+
+  return result;
+}
@@ -0,0 +1,58 @@
+/*******************************************************************\
+
+Module: Cone of Influence
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Cone of Influence
+
+#ifndef EBMC_CONE_OF_INFLUENCE_H
+#define EBMC_CONE_OF_INFLUENCE_H
+
+#include <util/expr.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class transt;
+
+/// The cone of influence of an expression in a transition system:
+/// the variables that the expression depends on, transitively via
+/// the conjuncts of the initial state predicate, the invariant and
+/// the transition relation.
+/// A conjunct that defines a variable, e.g., next(v) = e, is followed
+/// from v to the variables of e only; any other conjunct is a
+/// constraint, and relates all its variables.
+/// The conjuncts are indexed once, and then shared by all queries.
+class cone_of_influencet
+{
+public:
+  explicit cone_of_influencet(const transt &);
+
+  std::unordered_set<irep_idt> operator()(const exprt &) const;
+
+  /// the conjuncts in the cone of influence of the expression,
+  /// in the order of the transition system
+  std::vector<exprt> conjuncts(const exprt &) const;
+
+protected:
+  std::vector<exprt> all_conjuncts;
+
+  // the variables of each conjunct
+  std::vector<std::unordered_set<irep_idt>> conjunct_variables;
+
+  // the conjuncts that are in the cone of each variable:
+  // its definitions, and the constraints that it occurs in
+  std::unordered_map<irep_idt, std::vector<std::size_t>> uses;
+
+  // the variables in the cone of influence, and the conjuncts
+  // that are reached
+  std::vector<bool>
+  closure(const exprt &, std::unordered_set<irep_idt> &variables) const;
+};
+
+#endif // EBMC_CONE_OF_INFLUENCE_H
@@ -8,11 +8,125 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "dimacs_writer.h"
 
+#include <util/invariant.h>
+#include <util/tempfile.h>
+
+#include <iostream>
+
+dimacs_cnf_writert::dimacs_cnf_writert(
+  std::ostream &_out,
+  formatt _format,
+  message_handlert &_message_handler)
+  : dimacs_cnft(_message_handler), out(_out), format(_format)
+{
+}
+
 dimacs_cnf_writert::~dimacs_cnf_writert()
 {
+  if(format == formatt::DIMACS)
+    finish_dimacs();
+  else
+    write_header();
+
+  out.flush();
+
   log.statistics() << no_variables() << " variables and "
                    << no_clauses() << " clauses"
                    << messaget::eom;
+}
+
+/// The header is written when the first clause is, which
+/// keeps any messages given before out of the formula.
+void dimacs_cnf_writert::write_header()
+{
+  if(header_written)
+    return;
+
+  header_written = true;
+
+  if(format == formatt::ICNF)
+  {
+    out << "p inccnf\n";
+    return;
+  }
+
+  header_position = out.tellp();
+
+  if(header_position == std::streampos(-1))
+  {
+    // not seekable
+    out.clear();
+    spool_file = std::make_unique<temporary_filet>("ebmc_dimacs", ".cnf");
+    spool = std::make_unique<std::ofstream>(spool_file->name());
+  }
+  else
+  {
+    // leave space for the numbers
+    out << std::string(header_width - 1, ' ') << '\n';
+  }
+}
+
+std::ostream &dimacs_cnf_writert::clause_stream()
+{
+  write_header();
+  return spool ? *spool : out;
+}
+
+void dimacs_cnf_writert::finish_dimacs()
+{
+  write_header();
+
+  std::string header =
+    "p cnf " + std::to_string(no_variables()) + ' ' +
+    std::to_string(no_clauses());
+
+  if(spool)
+  {
+    spool->close();
+    out << header << '\n';
+    std::ifstream in(spool_file->name());
+    out << in.rdbuf();
+  }
+  else
+  {
+    auto end_position = out.tellp();
+    out.seekp(header_position);
+    header.resize(header_width - 1, ' ');
+    out << header;
+    out.seekp(end_position);
+  }
+}
+
+void dimacs_cnf_writert::lcnf(const bvt &bv)
+{
+  bvt clause;
+
+  // drop satisfied clauses and false literals
+  if(process_clause(bv, clause))
+    return;
+
+  auto &stream = clause_stream();
+
+  for(auto l : clause)
+    stream << l.dimacs() << ' ';
+
+  stream << "0\n";
+  clause_count++;
+}
+
+void dimacs_cnf_writert::write_assumptions(const bvt &assumptions)
+{
+  PRECONDITION(format == formatt::ICNF);
+
+  write_header();
+
+  out << 'a';
+
+  for(auto l : assumptions)
+  {
+    PRECONDITION(!l.is_constant());
+    out << ' ' << l.dimacs();
+  }
 
-  write_dimacs_cnf(out);
+  out << " 0\n";
 }
@@ -11,23 +11,70 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <solvers/sat/dimacs_cnf.h>
 
+#include <fstream>
+#include <memory>
+
+class temporary_filet;
+
+/// Writes the clauses as they are added, instead of keeping them.
+/// In DIMACS format, the header with the number of clauses is
+/// written into space left at the beginning when the stream is
+/// seekable, and otherwise, the clauses go to a temporary file
+/// first. In iCNF format, there is no such header, and the
+/// assumptions for each bound are given with write_assumptions.
 class dimacs_cnf_writert:public dimacs_cnft
 {
 public:
+  enum class formatt
+  {
+    DIMACS,
+    ICNF
+  };
+
   dimacs_cnf_writert(std::ostream &_out, message_handlert &_message_handler)
-    : dimacs_cnft(_message_handler), out(_out)
+    : dimacs_cnf_writert(_out, formatt::DIMACS, _message_handler)
   {
   }
 
+  dimacs_cnf_writert(
+    std::ostream &,
+    formatt,
+    message_handlert &);
+
   virtual ~dimacs_cnf_writert();
 
   std::string solver_text() const override
   {
-    return "DIMACS CNF Writer";
+    return format == formatt::ICNF ? "iCNF Writer" : "DIMACS CNF Writer";
   }
 
+  void lcnf(const bvt &) override;
+
+  size_t no_clauses() const override
+  {
+    return clause_count;
+  }
+
+  /// iCNF only: a cube of assumptions, for the clauses so far
+  void write_assumptions(const bvt &);
+
 protected:
   std::ostream &out;
+  formatt format;
+  std::size_t clause_count = 0;
+
+  // DIMACS: the position of the header, if the stream is seekable
+  bool header_written = false;
+  std::streampos header_position;
+  static constexpr std::size_t header_width = 48;
+
+  // DIMACS: the clauses, if the stream is not seekable
+  std::unique_ptr<temporary_filet> spool_file;
+  std::unique_ptr<std::ofstream> spool;
+
+  std::ostream &clause_stream();
+  void write_header();
+  void finish_dimacs();
 };
 
 #endif // CPROVER_DIMACS_WRITER_H
@@ -139,6 +139,8 @@ bool ebmc_baset::make_netlist(netlistt &netlist)
   {
     netlist = ::make_netlist(
       transition_system, properties, message.get_message_handler());
+
+    simplify_netlist(netlist, cmdline, message.get_message_handler());
   }
   
   catch(const std::string &error_str)
@@ -9,6 +9,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "ebmc_parse_options.h"
 
 #include <util/config.h>
+#include <util/ebmc_limits.h>
+#include <util/ebmc_statistics.h>
 #include <util/exit_codes.h>
 #include <util/help_formatter.h>
 #include <util/string2int.h>
@@ -18,6 +20,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "diatest.h"
 #include "ebmc_base.h"
 #include "ebmc_error.h"
+#include "ebmc_server.h"
 #include "ebmc_version.h"
 #include "format_hooks.h"
 #include "instrument_buechi.h"
@@ -32,8 +35,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "ranking_function.h"
 #include "show_properties.h"
 #include "show_trans.h"
+#include "watch.h"
 
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 #include "cegar/bmc_cegar.h"
 
@@ -46,6 +53,101 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "coverage/coverage.h"
 #endif
 
+/// Writes the phase timers and counters to the given file
+/// when going out of scope, on any exit path of doit().
+class stats_json_writert
+{
+public:
+  explicit stats_json_writert(const cmdlinet &cmdline)
+  {
+    if(cmdline.isset("stats-json"))
+      file_name = cmdline.get_value("stats-json");
+  }
+
+  ~stats_json_writert()
+  {
+    if(file_name.empty())
+      return;
+
+    auto &root = ebmc_statistics().root;
+    root.entered = 1;
+    root.wall_time =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+        .count();
+    root.cpu_time = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    try
+    {
+      auto outfile = output_filet{file_name};
+      outfile.stream() << ebmc_statistics().json() << '\n';
+    }
+    catch(...)
+    {
+      std::cerr << "failed to write statistics to " << file_name << '\n';
+    }
+  }
+
+protected:
+  std::string file_name;
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  std::clock_t cpu_start = std::clock();
+};
+
+/*******************************************************************\
+
+Function: set_limits
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: --timeout, --per-property-timeout and --memout
+
+\*******************************************************************/
+
+static void set_limits(const cmdlinet &cmdline)
+{
+  auto number = [&cmdline](const char *option)
+  {
+    auto value = string2optional_size_t(cmdline.get_value(option));
+    if(!value.has_value())
+      throw ebmc_errort() << "failed to parse value of --" << option;
+    return *value;
+  };
+
+  // the timeouts may be fractional, e.g., 0.5 seconds
+  auto seconds = [&cmdline](const char *option)
+  {
+    const std::string value = cmdline.get_value(option);
+    std::size_t end = 0;
+    double result = 0;
+
+    try
+    {
+      result = std::stod(value, &end);
+    }
+    catch(const std::exception &)
+    {
+      end = 0;
+    }
+
+    if(end == 0 || end != value.size() || !std::isfinite(result) || result < 0)
+      throw ebmc_errort() << "failed to parse value of --" << option;
+
+    return result;
+  };
+
+  if(cmdline.isset("timeout"))
+    ebmc_limits().set_timeout(seconds("timeout"));
+
+  if(cmdline.isset("per-property-timeout"))
+    ebmc_limits().set_property_timeout(seconds("per-property-timeout"));
+
+  if(cmdline.isset("memout"))
+    ebmc_limits().memout = number("memout") * 1024; // MB to kB
+}
+
 /*******************************************************************\
 
 Function: ebmc_parse_optionst::doit
@@ -60,9 +162,13 @@ Function: ebmc_parse_optionst::doit
 
 int ebmc_parse_optionst::doit()
 {
+  stats_json_writert stats_json_writer{cmdline};
+
   if(cmdline.isset("verbosity"))
     ui_message_handler.set_verbosity(
       unsafe_string2unsigned(cmdline.get_value("verbosity")));
+  else if(cmdline.isset("server"))
+    ui_message_handler.set_verbosity(messaget::M_WARNING); // keep stdout clean
   else
     ui_message_handler.set_verbosity(messaget::M_STATUS); // default
 
@@ -83,6 +189,8 @@ int ebmc_parse_optionst::doit()
 
   try
   {
+    set_limits(cmdline);
+
     if(cmdline.isset("diatest"))
     {
       if(!cmdline.isset("statebits"))
@@ -206,12 +314,27 @@ int ebmc_parse_optionst::doit()
       // return do_two_phase_induction();
     }
 
+    if(cmdline.isset("watch"))
+      return watch(cmdline, ui_message_handler);
+
+    // With --server, the responses go to stdout, and the messages,
+    // including those of loading the design, go to stderr.
+    stream_message_handlert log_message_handler{std::cerr};
+    ui_message_handlert server_message_handler{log_message_handler};
+    server_message_handler.set_verbosity(
+      cmdline.isset("verbosity")
+        ? unsafe_string2unsigned(cmdline.get_value("verbosity"))
+        : messaget::M_STATUS);
+
+    auto &message_handler = cmdline.isset("server") ? server_message_handler
+                                                    : ui_message_handler;
+
     // get the transition system
-    auto transition_system = get_transition_system(cmdline, ui_message_handler);
+    auto transition_system = get_transition_system(cmdline, message_handler);
 
     // get the properties
     auto properties = ebmc_propertiest::from_command_line(
-      cmdline, transition_system, ui_message_handler);
+      cmdline, transition_system, message_handler);
 
     if(cmdline.isset("show-properties"))
     {
@@ -227,11 +350,26 @@ int ebmc_parse_optionst::doit()
 
     // LTL/SVA to Buechi?
     if(cmdline.isset("buechi"))
-      instrument_buechi(transition_system, properties, ui_message_handler);
+      instrument_buechi(cmdline, transition_system, properties, message_handler);
 
     // possibly apply liveness-to-safety
     if(cmdline.isset("liveness-to-safety"))
-      liveness_to_safety(transition_system, properties);
+    {
+      auto signature_bits = unsafe_string2unsigned(
+        cmdline.value_opt("loop-signature").value_or("0"));
+      liveness_to_safety(transition_system, properties, signature_bits);
+    }
+
+    if(cmdline.isset("server"))
+    {
+      return ebmc_server(
+        cmdline,
+        transition_system,
+        properties,
+        std::cin,
+        std::cout,
+        message_handler);
+    }
 
     if(cmdline.isset("smv-word-level"))
     {
@@ -287,6 +425,7 @@ int ebmc_parse_optionst::doit()
     {
       auto netlist =
         make_netlist(transition_system, properties, ui_message_handler);
+      simplify_netlist(netlist, cmdline, ui_message_handler);
       netlist.print(std::cout);
       return 0;
     }
@@ -295,6 +434,7 @@ int ebmc_parse_optionst::doit()
     {
       auto netlist =
         make_netlist(transition_system, properties, ui_message_handler);
+      simplify_netlist(netlist, cmdline, ui_message_handler);
       auto filename = cmdline.value_opt("outfile").value_or("-");
       output_filet outfile{filename};
       outfile.stream() << "digraph netlist {\n";
@@ -307,6 +447,7 @@ int ebmc_parse_optionst::doit()
     {
       auto netlist =
         make_netlist(transition_system, properties, ui_message_handler);
+      simplify_netlist(netlist, cmdline, ui_message_handler);
       auto filename = cmdline.value_opt("outfile").value_or("-");
       output_filet outfile{filename};
       outfile.stream() << "-- Generated by EBMC " << EBMC_VERSION << '\n';
@@ -321,6 +462,9 @@ int ebmc_parse_optionst::doit()
     {
       auto netlist =
         make_netlist(transition_system, properties, ui_message_handler);
+      if(cmdline.isset("memory-diet"))
+        netlist_memory_diet(transition_system);
+      simplify_netlist(netlist, cmdline, ui_message_handler);
       const namespacet ns(transition_system.symbol_table);
       return do_bmc_cegar(netlist, properties, ns, ui_message_handler);
     }
@@ -384,22 +528,41 @@ void ebmc_parse_optionst::help()
     "\n"
     "Additonal options:\n"
     " {y--bound} {unr}               \t set bound (default: 1)\n"
+    " {y--timeout} {us}              \t give up after s seconds\n"
+    " {y--per-property-timeout} {us} \t give up on a property after s seconds\n"
+    " {y--memout} {umb}              \t give up when using more than mb megabytes\n"
     " {y--module} {umodule}          \t set top module (deprecated)\n"
     " {y--top} {umodule}             \t set top module\n"
     " {y-p} {uexpr}                  \t specify a property\n"
     " {y--outfile} {ufile name}      \t set output file name (default: stdout)\n"
+    "                                \t names ending in .gz or .zst are compressed\n"
     " {y--json-result} {ufile name}  \t use JSON for property status and traces\n"
+    " {y--json-lines} {ufile name}   \t write each property result as it is found\n"
+    " {y--server}                    \t answer JSON requests on stdin, one per line\n"
+    " {y--watch}                     \t check again whenever an input file changes\n"
     " {y--trace}                     \t generate a trace for failing properties\n"
     " {y--vcd} {ufile name}          \t generate traces in VCD format\n"
+    " {y--fst} {ufile name}          \t generate traces in FST format\n"
     " {y--waveform}                  \t show a waveform for failing properties\n"
     " {y--numbered-trace}            \t give a trace with identifiers numbered by timeframe\n"
     " {y--show-properties}           \t list the properties in the model\n"
     " {y--property} {uid}            \t check the property with given ID\n"
     " {y--liveness-to-safety}        \t translate liveness properties to safety properties\n"
+    "    {y--loop-signature} {ubits} \t detect loops by a signature of the state first\n"
     " {y--buechi}                    \t translate LTL/SVA properties to Buechi acceptance\n"
+    "    {y--ltl2tgba}               \t use Spot's ltl2tgba for the translation\n"
+    "    {y--buechi-encoding} {uenc} \t encode the automaton state as binary, one-hot or gray\n"
+    " {y--memory-diet}               \t release the transition system once the netlist is built\n"
+    " {y--reduce-latches}            \t remove constant and equivalent latches from the netlist\n"
+    " {y--fraig}                     \t merge equivalent netlist nodes (SAT sweeping)\n"
+    " {y--aig-rewrite}               \t rewrite and balance the netlist\n"
+    " {y--stats-json} {ufile name}   \t write phase timers and counters as JSON\n"
     "\n"
     "Methods:\n"
     " {y--k-induction}               \t do k-induction with k=bound\n"
+    " {y--k-liveness}                \t prove liveness properties with k-liveness, for k up to bound\n"
+    " {y--mine-invariants}           \t strengthen k-induction with invariants mined from simulation\n"
+    " {y--proof-cache} {ufile name}  \t reuse the results of earlier runs stored in the file\n"
     " {y--bdd}                       \t use (unbounded) BDD engine\n"
     " {y--ic3}                       \t use IC3 engine with options described below\n"
     "    {y--constr}                 \t use constraints specified in 'file.cnstr'\n"
@@ -428,6 +591,8 @@ void ebmc_parse_optionst::help()
     "Solvers:\n"
     " {y--aig}                       \t bit-level SAT with AIGs\n"
     " {y--dimacs}                    \t output bit-level CNF in DIMACS format\n"
+    " {y--icnf}                      \t output bit-level incremental CNF, with\n"
+    "                                \t one assumption per bound\n"
     " {y--smt2}                      \t output word-level SMT 2 formula\n"
     " {y--boolector}                 \t use Boolector as solver\n"
     " {y--cvc4}                      \t use CVC4 as solver\n"
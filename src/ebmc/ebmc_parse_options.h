@@ -30,8 +30,8 @@ public:
         "(show-traces)"
         "(modules-xml):"
         "(show-properties)(property):p:(trace)(waveform)(numbered-trace)"
-        "(dimacs)(module):(top):"
-        "(po)(cegar)(k-induction)(2pi)(bound2):"
+        "(dimacs)(icnf)(module):(top):"
+        "(po)(cegar)(k-induction)(k-liveness)(2pi)(bound2):"
         "(outfile):(xml-ui)(verbosity):(gui)"
         "(json-modules):(json-properties):(json-result):"
         "(neural-liveness)(neural-engine):"
@@ -45,13 +45,16 @@ public:
         "(minisat)(cadical)"
         "(aig)(stop-induction)(stop-minimize)(start):(coverage)(naive)"
         "(compute-ct)(dot-netlist)(smv-netlist)(smv-word-level)"
-        "(vcd):"
+        "(vcd):(fst):"
         "(random-traces)(trace-steps):(random-seed):(traces):"
         "(random-trace)(random-waveform)"
         "(bmc-with-assumptions)"
-        "(liveness-to-safety)(buechi)"
+        "(liveness-to-safety)(loop-signature):(buechi)(ltl2tgba)(buechi-encoding):"
         "I:D:(preprocess)(systemverilog)(vl2smv-extensions)"
-        "(warn-implicit-nets)",
+        "(warn-implicit-nets)"
+        "(memory-diet)(reduce-latches)(fraig)(aig-rewrite)(stats-json):"
+        "(mine-invariants)(proof-cache):(server)(watch)(json-lines):"
+        "(timeout):(per-property-timeout):(memout):",
         argc,
         argv,
         std::string("EBMC ") + EBMC_VERSION),
@@ -14,6 +14,7 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <temporal-logic/normalize_property.h>
 #include <verilog/sva_expr.h>
 
+#include "cone_of_influence.h"
 #include "ebmc_error.h"
 
 std::string ebmc_propertiest::propertyt::status_as_string() const
@@ -181,6 +182,8 @@ ebmc_propertiest ebmc_propertiest::from_command_line(
     p.description = expr_as_string;
     p.name = "command-line assertion";
 
+    properties.restrict_traces(cmdline, transition_system);
+
     return properties;
   }
   else
@@ -192,6 +195,36 @@ ebmc_propertiest ebmc_propertiest::from_command_line(
     // We optionally may select a subset.
     properties.select_property(cmdline, message_handler);
 
+    properties.restrict_traces(cmdline, transition_system);
+
     return properties;
   }
 }
+
+void ebmc_propertiest::restrict_traces(
+  const cmdlinet &cmdline,
+  const transition_systemt &transition_system)
+{
+  // these show all variables
+  if(
+    cmdline.isset("trace") || cmdline.isset("vcd") || cmdline.isset("fst") ||
+    cmdline.isset("waveform") || cmdline.isset("numbered-trace") ||
+    cmdline.isset("json-result") || cmdline.isset("xml-ui"))
+  {
+    return;
+  }
+
+  const cone_of_influencet cone_of_influence(transition_system.trans_expr);
+  const auto inputs = transition_system.inputs();
+
+  for(auto &p : properties)
+  {
+    if(p.is_disabled())
+      continue;
+
+    p.trace_variables = cone_of_influence(p.normalized_expr);
+
+    for(auto &input : inputs)
+      p.trace_variables->insert(input.get_identifier());
+  }
+}
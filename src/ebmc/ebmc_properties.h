@@ -19,6 +19,9 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include "transition_system.h"
 
+#include <functional>
+#include <unordered_set>
+
 class ebmc_propertiest
 {
 public:
@@ -52,8 +55,17 @@ public:
 
     std::size_t bound = 0;
     std::optional<trans_tracet> witness_trace;
+    // the variables to extract for the witness trace; all if not given
+    std::optional<std::unordered_set<irep_idt>> trace_variables;
     std::optional<std::string> failure_reason;
     std::optional<std::string> proof_via;
+    // A property that is checked again when normalized_expr is refuted,
+    // as normalized_expr is stronger than the property; a proof of
+    // normalized_expr is a proof of the property.
+    std::optional<exprt> confirmation_expr;
+    // The property is known to hold in the time frames up to this
+    // bound, e.g., from the proof cache. BMC takes these as given.
+    std::optional<std::size_t> seed_bound;
 
     bool has_witness_trace() const
     {
@@ -188,13 +200,28 @@ public:
       proof_via = {};
     }
 
-    void inconclusive()
+    void inconclusive(const std::optional<std::string> &reason = {})
     {
       status = statust::INCONCLUSIVE;
-      failure_reason = {};
+      failure_reason = reason;
       proof_via = {};
     }
 
+    /// Gives up on the property when a resource limit is exceeded.
+    /// The bound, if given, is the largest bound that has been checked.
+    void limit_exceeded(
+      const std::string &reason,
+      std::optional<std::size_t> _bound = {})
+    {
+      if(_bound.has_value())
+      {
+        bound = *_bound;
+        inconclusive(reason + ", checked up to bound " + std::to_string(bound));
+      }
+      else
+        inconclusive(reason);
+    }
+
     std::string status_as_string() const;
 
     propertyt() = default;
@@ -213,6 +240,18 @@ public:
   typedef std::list<propertyt> propertiest;
   propertiest properties;
 
+  /// Is given the results as soon as the engines find them, e.g.,
+  /// to implement --json-lines. The engines copy it along with the
+  /// properties; copies with other expressions must not have it.
+  std::function<void(const propertyt &)> observer;
+
+  /// The engines call this with each new result of a property.
+  void result_found(const propertyt &property) const
+  {
+    if(observer)
+      observer(property);
+  }
+
   bool has_unfinished_property() const
   {
     for(const auto &p : properties)
@@ -239,6 +278,11 @@ public:
   static ebmc_propertiest
   from_transition_system(const transition_systemt &, message_handlert &);
 
+  /// Restricts the witness traces to the cone of influence of
+  /// each property and the inputs, unless the options show
+  /// all variables of the traces.
+  void restrict_traces(const cmdlinet &, const transition_systemt &);
+
   /// Implements --property ID.
   /// Throws when given an unknown identifier.
   void select_property(const cmdlinet &, message_handlert &);
@@ -275,6 +319,23 @@ public:
         p.unknown();
   }
 
+  /// Gives up on the properties in UNKNOWN state when a resource
+  /// limit is exceeded; they become INCONCLUSIVE. The bound, if
+  /// given, is the largest bound that has been checked.
+  void limit_exceeded(
+    const std::string &reason,
+    std::optional<std::size_t> bound = {})
+  {
+    for(auto &p : properties)
+    {
+      if(p.is_unknown() && !p.is_assumption())
+      {
+        p.limit_exceeded(reason, bound);
+        result_found(p);
+      }
+    }
+  }
+
   /// Resets properties in UNSUPPORTED state to UNKNOWN/ASSUMED.
   void reset_unsupported()
   {
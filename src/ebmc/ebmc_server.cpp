@@ -0,0 +1,465 @@
+/*******************************************************************\
+
+Module: EBMC Server Mode
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// EBMC Server Mode
+
+#include "ebmc_server.h"
+
+#include <util/cmdline.h>
+#include <util/ebmc_limits.h>
+#include <util/json.h>
+#include <util/string2int.h>
+#include <util/ui_message.h>
+
+#include <json/json_parser.h>
+#include <langapi/language.h>
+#include <langapi/mode.h>
+#include <temporal-logic/normalize_property.h>
+#include <verilog/sva_expr.h>
+
+#include "ebmc_error.h"
+#include "ebmc_properties.h"
+#include "ebmc_solver_factory.h"
+#include "output_file.h"
+#include "proof_cache.h"
+#include "property_checker.h"
+#include "random_traces.h"
+#include "report_results.h"
+#include "transition_system.h"
+
+#include <algorithm>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <set>
+#include <sstream>
+
+/*******************************************************************\
+
+   Class: ebmc_servert
+
+ Purpose:
+
+\*******************************************************************/
+
+class ebmc_servert
+{
+public:
+  ebmc_servert(
+    const cmdlinet &_cmdline,
+    transition_systemt &_transition_system,
+    ebmc_propertiest &_properties,
+    ui_message_handlert &_message_handler)
+    : cmdline(_cmdline),
+      transition_system(_transition_system),
+      properties(_properties),
+      message_handler(_message_handler)
+  {
+    if(cmdline.isset("json-lines"))
+    {
+      // stdout carries the responses
+      if(cmdline.get_value("json-lines") == "-")
+        throw ebmc_errort() << "--server can't write --json-lines to stdout";
+
+      json_lines.emplace(cmdline.get_value("json-lines"));
+    }
+  }
+
+  int operator()(std::istream &, std::ostream &);
+
+protected:
+  const cmdlinet &cmdline;
+  transition_systemt &transition_system;
+  ebmc_propertiest &properties;
+  ui_message_handlert &message_handler;
+
+  // for --json-lines, with the results of all requests
+  std::optional<output_filet> json_lines;
+
+  void check(const json_objectt &request, json_objectt &response);
+  void random_trace(const json_objectt &request, json_objectt &response);
+  void show_properties(json_objectt &response);
+  void assume(const json_objectt &request, json_objectt &response);
+
+  // for the identifiers of the assumptions given as expressions
+  std::size_t number_of_assumptions = 0;
+
+  static void
+  error_response(json_objectt &response, const std::string &message)
+  {
+    response["status"] = json_stringt{"error"};
+    response["message"] = json_stringt{message};
+  }
+
+  static std::optional<std::size_t>
+  number(const json_objectt &request, const std::string &key)
+  {
+    auto &value = request[key];
+    if(value.is_null())
+      return {};
+    auto result = string2optional_size_t(value.value);
+    if(!value.is_number() || !result.has_value())
+      throw ebmc_errort() << "expected number for " << key;
+    return result;
+  }
+};
+
+/*******************************************************************\
+
+Function: ebmc_servert::check
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ebmc_servert::check(const json_objectt &request, json_objectt &response)
+{
+  // the options of the request replace those of the command line
+  cmdlinet request_cmdline = cmdline;
+
+  const char *engines[] = {"bdd", "aig", "k-induction", "k-liveness", "ic3"};
+
+  for(auto engine : engines)
+    request_cmdline.set(engine, false);
+
+  auto &engine = request["engine"].value;
+
+  if(engine.empty() || engine == "bmc")
+  {
+  }
+  else if(std::find(std::begin(engines), std::end(engines), engine) !=
+          std::end(engines))
+  {
+    request_cmdline.set(engine, true);
+  }
+  else
+    throw ebmc_errort() << "unknown engine " << engine;
+
+  auto bound = number(request, "bound");
+  if(bound.has_value())
+    request_cmdline.set("bound", std::to_string(*bound));
+
+  // otherwise, the heuristic engine would run
+  if(engine == "bmc" && !request_cmdline.isset("bound"))
+    throw ebmc_errort() << "engine bmc requires a bound";
+
+  // The traces are given in the response, and must not go to
+  // stdout, which carries the responses, or to the files of the
+  // command line, which each request would overwrite.
+  // The file of --json-lines is kept open for all requests.
+  for(auto option :
+      {"trace",
+       "numbered-trace",
+       "waveform",
+       "json-result",
+       "vcd",
+       "fst",
+       "json-lines"})
+  {
+    request_cmdline.set(option, false);
+  }
+
+  // The engines modify both.
+  auto request_transition_system = transition_system;
+  auto request_properties = properties;
+
+  auto &selection = request["properties"];
+
+  if(selection.is_array())
+  {
+    std::set<irep_idt> selected;
+    for(auto &identifier : to_json_array(selection))
+      selected.insert(identifier.value);
+
+    for(auto &property : request_properties.properties)
+      if(selected.find(property.identifier) == selected.end())
+      {
+        if(!property.is_assumed())
+          property.disable();
+      }
+      else
+        selected.erase(property.identifier);
+
+    if(!selected.empty())
+      throw ebmc_errort() << "Property " << *selected.begin() << " not found";
+  }
+
+  // --timeout applies to each request
+  ebmc_limits().restart_timeout();
+
+  std::optional<proof_cachet> proof_cache;
+  if(request_cmdline.isset("proof-cache"))
+  {
+    proof_cache.emplace(
+      request_cmdline.get_value("proof-cache"), message_handler);
+  }
+
+  auto result = property_checker(
+    request_cmdline,
+    request_transition_system,
+    request_properties,
+    proof_cache.has_value() ? &*proof_cache : nullptr,
+    json_lines.has_value() ? &json_lines->stream() : nullptr,
+    message_handler);
+
+  if(result.status == property_checker_resultt::statust::ERROR)
+    throw ebmc_errort() << "property checker failed";
+
+  const namespacet ns(request_transition_system.symbol_table);
+
+  json_arrayt json_properties;
+
+  for(auto &property : result.properties)
+    if(!property.is_disabled())
+      json_properties.push_back(json_result(property, ns));
+
+  response["properties"] = std::move(json_properties);
+}
+
+/*******************************************************************\
+
+Function: ebmc_servert::random_trace
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ebmc_servert::random_trace(
+  const json_objectt &request,
+  json_objectt &response)
+{
+  auto steps = number(request, "steps").value_or(10);
+
+  const namespacet ns(transition_system.symbol_table);
+  auto solver_factory = ebmc_solver_factory(cmdline);
+
+  random_traces(
+    transition_system,
+    [&response, &ns](trans_tracet trace)
+    { response["trace"] = json(trace, ns); },
+    1, // one trace
+    steps,
+    solver_factory,
+    message_handler);
+}
+
+/*******************************************************************\
+
+Function: ebmc_servert::show_properties
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ebmc_servert::show_properties(json_objectt &response)
+{
+  json_arrayt json_properties;
+
+  for(auto &property : properties.properties)
+  {
+    if(property.is_disabled())
+      continue;
+
+    json_objectt json_property;
+    json_property["identifier"] = json_stringt{id2string(property.identifier)};
+    json_property["description"] = json_stringt{property.description};
+    json_property["status"] =
+      json_stringt{property.is_assumed() ? "ASSUMED" : "UNKNOWN"};
+    json_properties.push_back(std::move(json_property));
+  }
+
+  response["properties"] = std::move(json_properties);
+}
+
+/*******************************************************************\
+
+Function: ebmc_servert::assume
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: adds the given expression as assumption, or turns the given
+          property into one, for all further requests
+
+\*******************************************************************/
+
+void ebmc_servert::assume(const json_objectt &request, json_objectt &response)
+{
+  auto &expression = request["expression"];
+
+  if(expression.is_string())
+  {
+    const namespacet ns(transition_system.symbol_table);
+    const auto &main_symbol = *transition_system.main_symbol;
+    auto language = get_language_from_mode(main_symbol.mode);
+
+    exprt expr;
+    if(language->to_expr(
+         expression.value,
+         id2string(main_symbol.module),
+         expr,
+         ns,
+         message_handler))
+    {
+      throw ebmc_errort() << "failed to parse the assumption";
+    }
+
+    // an implicit always, as for -p
+    if(expr.id() != ID_sva_always)
+      expr = sva_always_exprt{expr};
+
+    ebmc_propertiest::propertyt property;
+    property.number = properties.properties.size();
+    property.identifier =
+      "assumption." + std::to_string(++number_of_assumptions);
+    property.name = property.identifier;
+    property.original_expr = expr;
+    property.normalized_expr = normalize_property(expr);
+    property.mode = main_symbol.mode;
+    property.location.make_nil();
+    language->from_expr(expr, property.description, ns);
+    property.assumed();
+
+    response["property"] = json_stringt{id2string(property.identifier)};
+    properties.properties.push_back(std::move(property));
+    return;
+  }
+
+  auto &identifier = request["property"].value;
+
+  for(auto &property : properties.properties)
+    if(id2string(property.identifier) == identifier)
+    {
+      property.assumed();
+      return;
+    }
+
+  throw ebmc_errort() << "Property " << identifier << " not found";
+}
+
+/*******************************************************************\
+
+Function: ebmc_servert::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+int ebmc_servert::operator()(std::istream &in, std::ostream &out)
+{
+  std::string line;
+
+  while(std::getline(in, line))
+  {
+    if(line.empty())
+      continue;
+
+    json_objectt response;
+    bool quit = false;
+
+    try
+    {
+      jsont request;
+      std::istringstream line_stream(line);
+
+      if(
+        parse_json(line_stream, "request", message_handler, request) ||
+        !request.is_object())
+      {
+        throw ebmc_errort() << "malformed request";
+      }
+
+      const auto &request_object = to_json_object(request);
+
+      if(!request_object["id"].is_null())
+        response["id"] = request_object["id"];
+
+      auto &command = request_object["command"].value;
+
+      if(command == "check")
+        check(request_object, response);
+      else if(command == "random-trace")
+        random_trace(request_object, response);
+      else if(command == "show-properties")
+        show_properties(response);
+      else if(command == "assume")
+        assume(request_object, response);
+      else if(command == "quit")
+        quit = true;
+      else
+        throw ebmc_errort() << "unknown command " << command;
+
+      response["status"] = json_stringt{"ok"};
+    }
+    catch(const ebmc_errort &error)
+    {
+      error_response(response, error.what());
+    }
+    catch(const std::string &error)
+    {
+      error_response(response, error);
+    }
+    catch(const char *error)
+    {
+      error_response(response, error);
+    }
+    catch(const std::bad_alloc &)
+    {
+      error_response(response, "out of memory");
+    }
+
+    output_json_line(out, response);
+
+    if(quit)
+      break;
+  }
+
+  return 0;
+}
+
+/*******************************************************************\
+
+Function: ebmc_server
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+int ebmc_server(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  std::istream &in,
+  std::ostream &out,
+  ui_message_handlert &message_handler)
+{
+  return ebmc_servert{cmdline, transition_system, properties, message_handler}(
+    in, out);
+}
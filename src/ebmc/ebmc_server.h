@@ -0,0 +1,47 @@
+/*******************************************************************\
+
+Module: EBMC Server Mode
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// EBMC Server Mode
+
+#ifndef CPROVER_EBMC_EBMC_SERVER_H
+#define CPROVER_EBMC_EBMC_SERVER_H
+
+#include <iosfwd>
+
+class cmdlinet;
+class ebmc_propertiest;
+class ui_message_handlert;
+class transition_systemt;
+
+/// Answers requests on the design that is kept in memory.
+/// The requests are JSON objects, one per line on the input, and the
+/// responses are JSON objects, one per line on the output, in the order
+/// of the requests. The messages of the engines go to the given
+/// message handler. Implements --server.
+/// Requests have a "command", which is one of
+///   check         -- with optional "engine", "bound" and "properties"
+///   random-trace  -- with optional "steps"
+///   show-properties
+///   assume        -- with "expression", which is added as assumption,
+///                    or with "property", which becomes an assumption
+///   quit
+/// and an optional "id", which is copied into the response.
+/// The traces of a check are given in the response only, and --timeout
+/// applies to each check separately; the "bmc" engine requires a bound,
+/// in the request or on the command line. The results of all checks
+/// go to the file given with --json-lines, which must not be stdout.
+int ebmc_server(
+  const cmdlinet &,
+  transition_systemt &,
+  ebmc_propertiest &,
+  std::istream &,
+  std::ostream &,
+  ui_message_handlert &);
+
+#endif // CPROVER_EBMC_EBMC_SERVER_H
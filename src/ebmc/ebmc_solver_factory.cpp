@@ -140,26 +140,8 @@ ebmc_solver_factoryt ebmc_solver_factory(const cmdlinet &cmdline)
     // the 'default' solver
     return [&cmdline](const namespacet &ns, message_handlert &message_handler)
     {
-      std::unique_ptr<propt> sat_solver;
-
-      if(cmdline.isset("cadical"))
-      {
-#ifdef SATCHECK_CADICAL
-        sat_solver = std::unique_ptr<propt>(
-          new satcheck_cadical_preprocessingt{message_handler});
-#else
-        throw ebmc_errort() << "support for Cadical not configured";
-#endif
-      }
-      else
-      {
-        sat_solver = std::unique_ptr<propt>(
-          new satcheck_minisat_simplifiert{message_handler});
-      }
-
-      messaget message(message_handler);
-      message.status() << "Using " << sat_solver->solver_text()
-                       << messaget::eom;
+      std::unique_ptr<propt> sat_solver =
+        ebmc_sat_solver(cmdline, message_handler);
 
       auto dec = std::unique_ptr<stack_decision_proceduret>(
         new boolbvt{ns, *sat_solver, message_handler});
@@ -168,3 +150,29 @@ ebmc_solver_factoryt ebmc_solver_factory(const cmdlinet &cmdline)
     };
   }
 }
+
+std::unique_ptr<cnf_solvert>
+ebmc_sat_solver(const cmdlinet &cmdline, message_handlert &message_handler)
+{
+  std::unique_ptr<cnf_solvert> sat_solver;
+
+  if(cmdline.isset("cadical"))
+  {
+#ifdef SATCHECK_CADICAL
+    sat_solver = std::unique_ptr<cnf_solvert>(
+      new satcheck_cadical_preprocessingt{message_handler});
+#else
+    throw ebmc_errort() << "support for Cadical not configured";
+#endif
+  }
+  else
+  {
+    sat_solver = std::unique_ptr<cnf_solvert>(
+      new satcheck_minisat_simplifiert{message_handler});
+  }
+
+  messaget message(message_handler);
+  message.status() << "Using " << sat_solver->solver_text() << messaget::eom;
+
+  return sat_solver;
+}
@@ -15,6 +15,7 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include <solvers/decision_procedure.h>
 #include <solvers/prop/prop.h>
+#include <solvers/sat/cnf.h>
 
 #include <fstream>
 #include <memory>
@@ -58,4 +59,9 @@ using ebmc_solver_factoryt =
 
 ebmc_solver_factoryt ebmc_solver_factory(const cmdlinet &);
 
+/// The SAT solver selected on the command line, for the
+/// bit-level engines
+std::unique_ptr<cnf_solvert>
+ebmc_sat_solver(const cmdlinet &, message_handlert &);
+
 #endif // EBMC_SOLVER_FACTORY_H
@@ -14,11 +14,50 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <temporal-logic/ltl_to_buechi.h>
 #include <temporal-logic/temporal_logic.h>
 
+#include "ebmc_error.h"
+
 void instrument_buechi(
+  const cmdlinet &cmdline,
   transition_systemt &transition_system,
   ebmc_propertiest &properties,
   message_handlert &message_handler)
 {
+  buechi_optionst options;
+
+  if(cmdline.isset("ltl2tgba"))
+    options.backend = buechi_backendt::SPOT;
+
+  if(cmdline.isset("buechi-encoding"))
+  {
+    auto encoding = cmdline.get_value("buechi-encoding");
+    if(encoding == "binary")
+      options.encoding = buechi_encodingt::BINARY;
+    else if(encoding == "one-hot")
+      options.encoding = buechi_encodingt::ONE_HOT;
+    else if(encoding == "gray")
+      options.encoding = buechi_encodingt::GRAY;
+    else
+      throw ebmc_errort() << "unknown Buechi encoding `" << encoding << "'";
+  }
+
+  // the invariant constraints of the design
+  std::vector<exprt> invar_conjuncts{transition_system.trans_expr.invar()};
+  while(!invar_conjuncts.empty())
+  {
+    auto conjunct = std::move(invar_conjuncts.back());
+    invar_conjuncts.pop_back();
+    if(conjunct.id() == ID_and)
+    {
+      for(auto &op : conjunct.operands())
+        invar_conjuncts.push_back(op);
+    }
+    else if(!conjunct.is_true())
+      options.constraints.push_back(std::move(conjunct));
+  }
+
+  // shares the automata among the properties
+  ltl_to_buechit ltl_to_buechi{std::move(options)};
+
   for(auto &property : properties.properties)
   {
     if(!property.is_unknown())
@@ -12,12 +12,14 @@ Author: Daniel Kroening, dkr@amazon.com
 #ifndef EBMC_BUECHI_AUTOMATON_INSTRUMENTATION_H
 #define EBMC_BUECHI_AUTOMATON_INSTRUMENTATION_H
 
+#include <util/cmdline.h>
 #include <util/message.h>
 
 #include "ebmc_properties.h"
 #include "transition_system.h"
 
 void instrument_buechi(
+  const cmdlinet &,
   transition_systemt &,
   ebmc_propertiest &,
   message_handlert &);
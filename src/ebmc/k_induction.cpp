@@ -8,6 +8,7 @@ Author: Daniel Kroening, daniel.kroening@inf.ethz.ch
 
 #include "k_induction.h"
 
+#include <util/ebmc_limits.h>
 #include <util/string2int.h>
 
 #include <temporal-logic/temporal_logic.h>
@@ -225,7 +226,10 @@ void k_inductiont::operator()()
     for(auto &property : properties.properties)
     {
       if(property.is_refuted())
+      {
         property.inconclusive();
+        properties.result_found(property);
+      }
     }
   }
 }
@@ -277,11 +281,26 @@ void k_inductiont::induction_step()
   const std::size_t no_timeframes = k + 1;
   const namespacet ns(transition_system.symbol_table);
 
+  // gives up on the property, which the base case has checked up to k
+  auto limit_exceeded = [this](ebmc_propertiest::propertyt &property)
+  {
+    auto reason = ebmc_limits().exceeded();
+    if(!reason.has_value())
+      return false;
+
+    message.warning() << "Giving up on " << property.name << ": " << *reason
+                      << messaget::eom;
+    property.inconclusive(
+      *reason + ", checked up to bound " + std::to_string(k));
+    properties.result_found(property);
+    return true;
+  };
+
   for(auto &p_it : properties.properties)
   {
     if(
       p_it.is_disabled() || p_it.is_failure() || p_it.is_assumed() ||
-      p_it.is_unsupported() || p_it.is_proved())
+      p_it.is_unsupported() || p_it.is_proved() || p_it.is_inconclusive())
     {
       continue;
     }
@@ -295,6 +314,11 @@ void k_inductiont::induction_step()
     if(p_it.is_refuted())
       continue;
 
+    ebmc_property_clockt property_clock;
+
+    if(limit_exceeded(p_it))
+      continue;
+
     auto solver_wrapper = solver_factory(ns, message.get_message_handler());
     auto &solver = solver_wrapper.decision_procedure();
 
@@ -335,6 +359,9 @@ void k_inductiont::induction_step()
       solver.set_to_false(tmp);
     }
 
+    if(limit_exceeded(p_it))
+      continue;
+
     decision_proceduret::resultt dec_result = solver();
 
     switch(dec_result)
@@ -358,5 +385,7 @@ void k_inductiont::induction_step()
     default:
       throw ebmc_errort() << "Unexpected result from decision procedure";
     }
+
+    properties.result_found(p_it);
   }
 }
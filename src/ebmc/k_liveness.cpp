@@ -0,0 +1,371 @@
+/*******************************************************************\
+
+Module: k-Liveness
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// k-Liveness
+
+#include "k_liveness.h"
+
+#include <util/arith_tools.h>
+#include <util/ebmc_limits.h>
+#include <util/invariant.h>
+#include <util/namespace.h>
+#include <util/string2int.h>
+
+#include <temporal-logic/ltl.h>
+#include <temporal-logic/temporal_logic.h>
+#include <trans-word-level/next_symbol.h>
+#include <verilog/sva_expr.h>
+
+#include "ebmc_error.h"
+#include "ebmc_solver_factory.h"
+#include "k_induction.h"
+
+#include <map>
+
+/*******************************************************************\
+
+   Class: k_livenesst
+
+ Purpose:
+
+\*******************************************************************/
+
+class k_livenesst
+{
+public:
+  k_livenesst(
+    std::size_t _max_k,
+    transition_systemt &_transition_system,
+    ebmc_propertiest &_properties,
+    const ebmc_solver_factoryt &_solver_factory,
+    message_handlert &_message_handler)
+    : max_k(_max_k),
+      transition_system(_transition_system),
+      properties(_properties),
+      solver_factory(_solver_factory),
+      message(_message_handler)
+  {
+  }
+
+  void operator()();
+
+  // the accepting condition that must occur finitely often,
+  // or nil if the property is not supported
+  static exprt accepting_condition(const exprt &);
+
+protected:
+  const std::size_t max_k;
+  transition_systemt &transition_system;
+  ebmc_propertiest &properties;
+  const ebmc_solver_factoryt &solver_factory;
+  messaget message;
+
+  using propertyt = ebmc_propertiest::propertyt;
+
+  // the counters, by the identifier of the property
+  std::map<irep_idt, symbol_exprt> counters;
+
+  symbol_exprt new_symbol(
+    const propertyt &,
+    const std::string &suffix,
+    typet,
+    bool is_input);
+
+  void add_counter(const propertyt &);
+};
+
+/*******************************************************************\
+
+Function: k_livenesst::accepting_condition
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+exprt k_livenesst::accepting_condition(const exprt &expr)
+{
+  // F G q, as produced by --buechi: ¬q must occur finitely often
+  if(expr.id() == ID_F && to_F_expr(expr).op().id() == ID_G)
+  {
+    auto &q = to_G_expr(to_F_expr(expr).op()).op();
+    if(!has_temporal_operator(q))
+      return not_exprt{q};
+  }
+
+  // G F p: the monitor below makes this an F G property
+  if(
+    expr.id() == ID_sva_always &&
+    (to_sva_always_expr(expr).op().id() == ID_sva_eventually ||
+     to_sva_always_expr(expr).op().id() == ID_sva_s_eventually))
+  {
+    auto &p = to_unary_expr(to_sva_always_expr(expr).op()).op();
+    if(!has_temporal_operator(p))
+      return p;
+  }
+
+  if(expr.id() == ID_G && to_G_expr(expr).op().id() == ID_F)
+  {
+    auto &p = to_F_expr(to_G_expr(expr).op()).op();
+    if(!has_temporal_operator(p))
+      return p;
+  }
+
+  return nil_exprt{};
+}
+
+/*******************************************************************\
+
+Function: k_livenesst::new_symbol
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+symbol_exprt k_livenesst::new_symbol(
+  const propertyt &property,
+  const std::string &suffix,
+  typet type,
+  bool is_input)
+{
+  auxiliary_symbolt symbol{
+    id2string(property.identifier) + "::k_liveness_" + suffix,
+    std::move(type),
+    transition_system.main_symbol->mode};
+
+  symbol.is_state_var = !is_input;
+  symbol.is_input = is_input;
+  symbol.module = transition_system.main_symbol->module;
+  symbol.base_name = "k_liveness_" + suffix;
+
+  auto symbol_expr = symbol.symbol_expr();
+
+  auto result = transition_system.symbol_table.insert(std::move(symbol));
+  CHECK_RETURN(result.second);
+
+  return symbol_expr;
+}
+
+/*******************************************************************\
+
+Function: k_livenesst::add_counter
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Add the counter of the occurrences of the accepting
+          condition of the given property, saturating at max_k
+
+\*******************************************************************/
+
+void k_livenesst::add_counter(const propertyt &property)
+{
+  auto &expr = property.normalized_expr;
+  auto &trans_expr = transition_system.trans_expr;
+
+  exprt accepting = accepting_condition(expr);
+  CHECK_RETURN(accepting.is_not_nil());
+
+  exprt::operandst init, invar, trans;
+
+  if(expr.id() != ID_F)
+  {
+    // G F p fails iff there is a path where ¬p holds forever,
+    // from some point onwards. The monitor guesses that point
+    // with the input 'start'; the paths where p holds once
+    // the monitor is active are cut off.
+    auto p = accepting;
+    auto start = new_symbol(property, "start", bool_typet{}, true);
+    auto active = new_symbol(property, "active", bool_typet{}, false);
+
+    init.push_back(not_exprt{active});
+    invar.push_back(implies_exprt{active, not_exprt{p}});
+    trans.push_back(
+      equal_exprt{next_symbol_exprt{active}, or_exprt{active, start}});
+
+    accepting = active;
+  }
+
+  auto type =
+    unsignedbv_typet{numeric_cast_v<std::size_t>(address_bits(max_k + 1))};
+  auto counter = new_symbol(property, "counter", type, false);
+  auto zero = from_integer(0, type);
+
+  init.push_back(equal_exprt{counter, zero});
+
+  // counter' = (accepting ∧ counter ≠ max_k) ? counter + 1 : counter
+  trans.push_back(equal_exprt{
+    next_symbol_exprt{counter},
+    if_exprt{
+      and_exprt{accepting, notequal_exprt{counter, from_integer(max_k, type)}},
+      plus_exprt{counter, from_integer(1, type)},
+      counter}});
+
+  // These invariants hold by construction. They are kept
+  // for all k, and make the counter k-inductive much sooner.
+  invar.push_back(binary_relation_exprt{
+    counter, ID_le, from_integer(max_k, type)});
+
+  if(expr.id() != ID_F)
+  {
+    // the monitor stays active once the counter has started
+    invar.push_back(implies_exprt{notequal_exprt{counter, zero}, accepting});
+  }
+
+  trans_expr.init() = conjunction({trans_expr.init(), conjunction(init)});
+  trans_expr.invar() = conjunction({trans_expr.invar(), conjunction(invar)});
+  trans_expr.trans() = conjunction({trans_expr.trans(), conjunction(trans)});
+
+  counters.emplace(property.identifier, counter);
+}
+
+/*******************************************************************\
+
+Function: k_livenesst::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void k_livenesst::operator()()
+{
+  for(auto &property : properties.properties)
+  {
+    if(
+      property.is_disabled() || property.is_assumed() || property.is_proved())
+    {
+      continue;
+    }
+
+    if(accepting_condition(property.normalized_expr).is_nil())
+      property.unsupported("unsupported by k-liveness");
+    else
+      add_counter(property);
+  }
+
+  // the reason for giving up early, if any
+  std::optional<std::string> limit_reason;
+
+  for(std::size_t k = 1; k <= max_k && !counters.empty(); k++)
+  {
+    limit_reason = ebmc_limits().exceeded();
+    if(limit_reason.has_value())
+    {
+      message.warning() << "Giving up: " << *limit_reason << messaget::eom;
+      *limit_reason += " at k=" + std::to_string(k);
+      break;
+    }
+
+    message.status() << "k-Liveness with k=" << k << messaget::eom;
+
+    // the safety properties "counter < k"
+    auto safety_properties = properties;
+
+    // their results are not the results of the properties
+    safety_properties.observer = nullptr;
+
+    for(auto &property : safety_properties.properties)
+    {
+      auto counter_it = counters.find(property.identifier);
+
+      if(counter_it != counters.end())
+      {
+        auto &counter = counter_it->second;
+        property.unknown();
+        property.normalized_expr = sva_always_exprt{binary_relation_exprt{
+          counter, ID_lt, from_integer(k, counter.type())}};
+      }
+      else if(!property.is_assumed())
+        property.disable();
+    }
+
+    auto result = k_induction(
+      k,
+      transition_system,
+      safety_properties,
+      solver_factory,
+      message.get_message_handler());
+
+    // the result has the properties in the same order
+    auto result_it = result.properties.begin();
+
+    for(auto &property : properties.properties)
+    {
+      auto &result_property = *result_it++;
+      auto counter_it = counters.find(property.identifier);
+
+      if(counter_it != counters.end() && result_property.is_proved())
+      {
+        property.proved("k-liveness with k=" + std::to_string(k));
+        properties.result_found(property);
+        counters.erase(counter_it);
+      }
+    }
+  }
+
+  // k-liveness does not give counterexamples
+  for(auto &property : properties.properties)
+    if(counters.find(property.identifier) != counters.end())
+    {
+      property.inconclusive(limit_reason);
+      properties.result_found(property);
+    }
+}
+
+/*******************************************************************\
+
+Function: k_liveness
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+property_checker_resultt k_liveness(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  message_handlert &message_handler)
+{
+  std::size_t max_k = [&cmdline, &message_handler]() -> std::size_t {
+    if(!cmdline.isset("bound"))
+    {
+      messaget message(message_handler);
+      message.warning() << "using k-liveness with k up to 10" << messaget::eom;
+      return 10;
+    }
+    else
+      return unsafe_string2unsigned(cmdline.get_value("bound"));
+  }();
+
+  if(properties.properties.empty())
+    throw ebmc_errort() << "no properties";
+
+  auto solver_factory = ebmc_solver_factory(cmdline);
+
+  k_livenesst(
+    max_k, transition_system, properties, solver_factory, message_handler)();
+
+  return property_checker_resultt{properties};
+}
@@ -0,0 +1,32 @@
+/*******************************************************************\
+
+Module: k-Liveness
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// k-Liveness
+
+#ifndef EBMC_K_LIVENESS_H
+#define EBMC_K_LIVENESS_H
+
+#include <util/cmdline.h>
+#include <util/message.h>
+
+#include "property_checker.h"
+
+/// Proves liveness properties using the counter-based reduction to
+/// safety by Claessen and Sörensson (FMCAD 2012): a property holds
+/// when its accepting condition can occur at most k times on every
+/// path, for some k. The occurrences are counted by a saturating
+/// counter, and "counter < k" is checked with k-induction for
+/// k = 1, 2, ... up to the bound.
+[[nodiscard]] property_checker_resultt k_liveness(
+  const cmdlinet &,
+  transition_systemt &,
+  ebmc_propertiest &,
+  message_handlert &);
+
+#endif // EBMC_K_LIVENESS_H
@@ -11,14 +11,20 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include "liveness_to_safety.h"
 
+#include <util/arith_tools.h>
+#include <util/bitvector_expr.h>
+#include <util/bitvector_types.h>
 #include <util/invariant.h>
 #include <util/namespace.h>
 
 #include <trans-word-level/next_symbol.h>
 #include <verilog/sva_expr.h>
 
+#include "cone_of_influence.h"
 #include "ebmc_error.h"
 
+#include <algorithm>
+
 // Using terminology from
 // https://fmv.jku.at/papers/BiereArthoSchuppan-FMICS02.pdf
 
@@ -27,8 +33,11 @@ class liveness_to_safetyt
 public:
   liveness_to_safetyt(
     transition_systemt &_transition_system,
-    ebmc_propertiest &_properties)
-    : transition_system(_transition_system), properties(_properties)
+    ebmc_propertiest &_properties,
+    std::size_t _signature_bits)
+    : transition_system(_transition_system),
+      properties(_properties),
+      signature_bits(_signature_bits)
   {
   }
 
@@ -37,9 +46,16 @@ public:
 protected:
   transition_systemt &transition_system;
   ebmc_propertiest &properties;
+  const std::size_t signature_bits;
 
+  // the state variables that are shadowed by 'loop' variables
   std::vector<symbol_exprt> state_vars;
 
+  void restrict_to_cone_of_influence();
+
+  exprt signature(bool loop) const;
+  exprt signature_is_loop() const;
+
   using propertyt = ebmc_propertiest::propertyt;
 
   void translate_GFp(propertyt &);
@@ -100,17 +116,25 @@ protected:
     return expr;
   }
 
+  // looped, with the signatures compared instead of the states
+  static symbol_exprt signature_looped_symbol()
+  {
+    const static symbol_exprt expr(
+      "liveness-to-safety::signature_looped", bool_typet());
+    return expr;
+  }
+
   static symbol_exprt live_symbol(irep_idt property_identifier)
   {
     return symbol_exprt(id2string(property_identifier) + "#live", bool_typet());
   }
 
   static exprt
-  safety_replacement(irep_idt property_identifier, const exprt &expr)
+  safety_replacement(irep_idt property_identifier, const symbol_exprt &looped)
   {
     // G (looped → live)
     return sva_always_exprt(
-      implies_exprt(looped_symbol(), live_symbol(property_identifier)));
+      implies_exprt(looped, live_symbol(property_identifier)));
   }
 };
 
@@ -133,6 +157,85 @@ static bool have_supported_property(const ebmc_propertiest &properties)
   return false;
 }
 
+/// Only the state variables in the cone of influence of the
+/// liveness arguments and of the assumptions need to be shadowed.
+/// The cone is closed under the conjuncts of the transition system,
+/// and thus, the remaining variables form an independent part.
+void liveness_to_safetyt::restrict_to_cone_of_influence()
+{
+  exprt::operandst roots;
+
+  for(auto &property : properties.properties)
+    if(!property.is_disabled())
+      roots.push_back(property.normalized_expr);
+
+  const auto cone =
+    cone_of_influencet{transition_system.trans_expr}(conjunction(roots));
+
+  state_vars.erase(
+    std::remove_if(
+      state_vars.begin(),
+      state_vars.end(),
+      [&cone](const symbol_exprt &var)
+      { return cone.find(var.get_identifier()) == cone.end(); }),
+    state_vars.end());
+}
+
+/// whether the state variable is folded into the signature
+static bool has_signature(const symbol_exprt &var)
+{
+  return var.type().id() == ID_bool || var.type().id() == ID_unsignedbv ||
+         var.type().id() == ID_signedbv || var.type().id() == ID_bv;
+}
+
+/// XOR-folds the bits of the bit-vector state variables, or of their
+/// 'loop' copies, into a signature of the given number of bits.
+exprt liveness_to_safetyt::signature(bool loop) const
+{
+  const unsignedbv_typet signature_type{signature_bits};
+  exprt result = from_integer(0, signature_type);
+
+  for(auto &var : state_vars)
+  {
+    if(!has_signature(var))
+      continue;
+
+    std::size_t width = var.type().id() == ID_bool
+                          ? 1
+                          : to_bitvector_type(var.type()).get_width();
+
+    // pad to a multiple of the signature width
+    auto chunks = (width + signature_bits - 1) / signature_bits;
+    exprt bits = typecast_exprt{
+      loop ? exprt{loop_variable(var)} : exprt{var},
+      unsignedbv_typet{chunks * signature_bits}};
+
+    for(std::size_t chunk = 0; chunk < chunks; chunk++)
+    {
+      result = bitxor_exprt{
+        result,
+        extractbits_exprt{bits, chunk * signature_bits, signature_type}};
+    }
+  }
+
+  return result;
+}
+
+/// Implied by state_is_loop(): the signatures are equal, and the
+/// variables without a signature are.
+exprt liveness_to_safetyt::signature_is_loop() const
+{
+  exprt::operandst conjuncts;
+
+  conjuncts.push_back(equal_exprt{signature(false), signature(true)});
+
+  for(auto &var : state_vars)
+    if(!has_signature(var))
+      conjuncts.push_back(equal_exprt(var, loop_variable(var)));
+
+  return conjunction(std::move(conjuncts));
+}
+
 void liveness_to_safetyt::operator()()
 {
   // Do we have a supported property?
@@ -141,6 +244,7 @@ void liveness_to_safetyt::operator()()
 
   // gather the state variables
   state_vars = transition_system.state_variables();
+  restrict_to_cone_of_influence();
 
   const namespacet ns(transition_system.symbol_table);
 
@@ -243,6 +347,29 @@ void liveness_to_safetyt::operator()()
      std::move(save_invar),
      std::move(looped_invar)});
 
+  if(signature_bits != 0)
+  {
+    // create the 'signature_looped' symbol, a wire
+    auxiliary_symbolt signature_looped_symbol{
+      this->signature_looped_symbol().get_identifier(),
+      this->signature_looped_symbol().type(),
+      transition_system.main_symbol->mode};
+
+    signature_looped_symbol.is_state_var = false;
+    signature_looped_symbol.module = transition_system.main_symbol->module;
+
+    auto result = transition_system.symbol_table.insert(
+      std::move(signature_looped_symbol));
+    CHECK_RETURN(result.second);
+
+    // signature_looped := (saved ∧ signature(state)=signature(loop))
+    transition_system.trans_expr.invar() = conjunction(
+      {transition_system.trans_expr.invar(),
+       equal_exprt{
+         this->signature_looped_symbol(),
+         and_exprt(saved_symbol(), signature_is_loop())}});
+  }
+
   transition_system.trans_expr.trans() = conjunction(
     {transition_system.trans_expr.trans(),
      std::move(saved_trans),
@@ -302,13 +429,25 @@ void liveness_to_safetyt::translate_GFp(propertyt &property)
     conjunction({transition_system.trans_expr.trans(), std::move(live_trans)});
 
   // replace the liveness property
-  property.normalized_expr =
-    safety_replacement(property.name, property.normalized_expr);
+  if(signature_bits != 0)
+  {
+    // signature_looped is implied by looped, and thus, this is stronger
+    property.normalized_expr =
+      safety_replacement(property.name, signature_looped_symbol());
+    property.confirmation_expr =
+      safety_replacement(property.name, looped_symbol());
+  }
+  else
+  {
+    property.normalized_expr =
+      safety_replacement(property.name, looped_symbol());
+  }
 }
 
 void liveness_to_safety(
   transition_systemt &transition_system,
-  ebmc_propertiest &properties)
+  ebmc_propertiest &properties,
+  std::size_t signature_bits)
 {
-  liveness_to_safetyt{transition_system, properties}();
+  liveness_to_safetyt{transition_system, properties, signature_bits}();
 }
@@ -15,6 +15,17 @@ Author: Daniel Kroening, dkr@amazon.com
 #include "ebmc_properties.h"
 #include "transition_system.h"
 
-void liveness_to_safety(transition_systemt &, ebmc_propertiest &);
+/// Translates the G F p properties into safety properties, by
+/// shadowing the state variables in the cone of influence of the
+/// properties and the assumptions. Given a nonzero number of
+/// signature bits, a loop is detected when the XOR-folded signatures
+/// of the state and of its shadow are equal. This finds all loops,
+/// and thus, proofs are sound; the refutations are confirmed with the
+/// full state by property_checker, via the confirmation_expr of the
+/// property.
+void liveness_to_safety(
+  transition_systemt &,
+  ebmc_propertiest &,
+  std::size_t signature_bits = 0);
 
 #endif // EBMC_LIVENESS_TO_SAFETY_H
@@ -0,0 +1,99 @@
+/*******************************************************************\
+
+Module: Invariant Mining
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Invariant Mining
+
+#include "mine_invariants.h"
+
+#include <util/bitvector_expr.h>
+#include <util/ebmc_statistics.h>
+#include <util/std_expr.h>
+
+#include <trans-netlist/invariant_mining.h>
+#include <trans-netlist/netlist.h>
+#include <trans-netlist/trans_to_netlist.h>
+
+#include "transition_system.h"
+
+#include <optional>
+
+/// The latch bit as Boolean expression over the state variables,
+/// or {} for variables that are not Booleans or bit-vectors
+static std::optional<exprt>
+latch_bit_expr(const var_mapt &var_map, literalt l)
+{
+  const auto &varid = var_map.reverse(l.var_no());
+  const auto &var = var_map.map.at(varid.id);
+  const symbol_exprt symbol{varid.id, var.type};
+
+  exprt bit;
+
+  if(var.type.id() == ID_bool)
+    bit = symbol;
+  else if(
+    var.type.id() == ID_unsignedbv || var.type.id() == ID_signedbv ||
+    var.type.id() == ID_bv)
+  {
+    bit = extractbit_exprt{symbol, varid.bit_nr};
+  }
+  else
+    return {};
+
+  if(l.sign())
+    return not_exprt{std::move(bit)};
+  else
+    return bit;
+}
+
+void mine_invariants(
+  transition_systemt &transition_system,
+  message_handlert &message_handler)
+{
+  ebmc_phaset phase("invariant mining");
+
+  netlistt netlist;
+
+  convert_trans_to_netlist(
+    transition_system.symbol_table,
+    transition_system.main_symbol->name,
+    transition_system.trans_expr,
+    {}, // no properties
+    netlist,
+    message_handler);
+
+  auto clauses = mine_invariants(netlist, message_handler);
+
+  exprt::operandst invariants;
+
+  for(auto &clause : clauses)
+  {
+    exprt::operandst disjuncts;
+
+    for(auto l : clause)
+    {
+      auto bit = latch_bit_expr(netlist.var_map, l);
+      if(!bit.has_value())
+        break;
+      disjuncts.push_back(std::move(*bit));
+    }
+
+    if(disjuncts.size() == clause.size())
+      invariants.push_back(disjunction(disjuncts));
+  }
+
+  if(invariants.empty())
+    return;
+
+  messaget message(message_handler);
+  message.status() << "Adding " << invariants.size() << " mined invariant"
+                   << (invariants.size() == 1 ? "" : "s") << messaget::eom;
+
+  invariants.push_back(transition_system.trans_expr.invar());
+  transition_system.trans_expr.invar() = conjunction(invariants);
+}
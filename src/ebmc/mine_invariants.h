@@ -0,0 +1,25 @@
+/*******************************************************************\
+
+Module: Invariant Mining
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Invariant Mining
+
+#ifndef CPROVER_EBMC_MINE_INVARIANTS_H
+#define CPROVER_EBMC_MINE_INVARIANTS_H
+
+#include <util/message.h>
+
+class transition_systemt;
+
+/// Mines invariants over the latches of the design, and adds those that
+/// are proved to the invariant constraint of the transition system,
+/// where these strengthen the step case of k-induction, and are used by
+/// BMC and IC3. Implements --mine-invariants.
+void mine_invariants(transition_systemt &, message_handlert &);
+
+#endif // CPROVER_EBMC_MINE_INVARIANTS_H
@@ -8,7 +8,13 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include "netlist.h"
 
+#include <util/cmdline.h>
+#include <util/ebmc_statistics.h>
+
+#include <trans-netlist/aig_rewrite.h>
+#include <trans-netlist/fraig.h>
 #include <trans-netlist/netlist.h>
+#include <trans-netlist/sequential_reduction.h>
 #include <trans-netlist/trans_to_netlist.h>
 
 #include "instrument_past.h"
@@ -20,6 +26,8 @@ netlistt make_netlist(
 {
   instrument_past(transition_system, properties);
 
+  ebmc_phaset phase("netlist");
+
   netlistt netlist;
 
   convert_trans_to_netlist(
@@ -30,5 +38,49 @@ netlistt make_netlist(
     netlist,
     message_handler);
 
+  ebmc_statistics().count("latches", netlist.var_map.latches.size());
+  ebmc_statistics().count("nodes", netlist.number_of_nodes());
+
   return netlist;
 }
+
+void simplify_netlist(
+  netlistt &netlist,
+  const cmdlinet &cmdline,
+  message_handlert &message_handler)
+{
+  // Constant and equivalent latches first, as these
+  // enable further combinational simplifications.
+  if(cmdline.isset("reduce-latches"))
+    sequential_reduction(netlist, message_handler);
+
+  if(cmdline.isset("fraig"))
+    fraig(netlist, message_handler);
+
+  // last, to clean up after the passes above
+  if(cmdline.isset("aig-rewrite"))
+    aig_rewrite(netlist, message_handler);
+}
+
+void netlist_memory_diet(transition_systemt &transition_system)
+{
+  // The transition relation is now in the netlist.
+  transition_system.trans_expr = transt{
+    ID_trans,
+    true_exprt(),
+    true_exprt(),
+    true_exprt(),
+    transition_system.trans_expr.type()};
+
+  // The values of the symbols, which include the synthesized
+  // module bodies, are not needed for the counterexamples.
+  auto &symbol_table = transition_system.symbol_table;
+  std::vector<irep_idt> identifiers;
+
+  for(const auto &[identifier, symbol] : symbol_table.symbols)
+    if(!symbol.is_type && symbol.value.is_not_nil())
+      identifiers.push_back(identifier);
+
+  for(const auto &identifier : identifiers)
+    symbol_table.get_writeable_ref(identifier).value.make_nil();
+}
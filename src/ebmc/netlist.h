@@ -12,9 +12,20 @@ Author: Daniel Kroening, dkr@amazon.com
 #include "ebmc_properties.h"
 #include "transition_system.h"
 
+class cmdlinet;
 class netlistt;
 
 netlistt
 make_netlist(transition_systemt &, ebmc_propertiest &, message_handlert &);
 
+/// Applies the netlist simplifications that are selected
+/// on the command line (--reduce-latches, --fraig, --aig-rewrite).
+void simplify_netlist(netlistt &, const cmdlinet &, message_handlert &);
+
+/// Once the netlist is built, drops everything from the transition
+/// system that is not needed to print counterexamples, i.e., keeps
+/// only the names, types and pretty names of the symbols.
+/// Implements --memory-diet.
+void netlist_memory_diet(transition_systemt &);
+
 #endif // CPROVER_EBMC_NETLIST_H
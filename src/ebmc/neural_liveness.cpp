@@ -15,6 +15,7 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <util/tempfile.h>
 
 #include <temporal-logic/temporal_expr.h>
+#include <trans-netlist/vcd_writer.h>
 #include <verilog/sva_expr.h>
 
 #include "ebmc_error.h"
@@ -197,15 +198,16 @@ std::function<void(trans_tracet)>
 neural_livenesst::dump_vcd_files(temp_dirt &temp_dir)
 {
   const auto outfile_prefix = temp_dir("trace.");
-  return
-    [&, trace_nr = 0ull, outfile_prefix](trans_tracet trace) mutable -> void {
-      namespacet ns(transition_system.symbol_table);
-      auto filename = outfile_prefix + std::to_string(trace_nr + 1);
-      auto outfile = output_filet{filename};
-      message.progress() << "*** Writing to " << outfile.name()
-                         << messaget::eom;
-      show_trans_trace_vcd(trace, message, ns, outfile.stream());
-    };
+  return [&,
+          trace_nr = 0ull,
+          outfile_prefix,
+          vcd_writer = vcd_writert()](trans_tracet trace) mutable -> void {
+    namespacet ns(transition_system.symbol_table);
+    auto filename = outfile_prefix + std::to_string(trace_nr + 1);
+    auto outfile = output_filet{filename};
+    message.progress() << "*** Writing to " << outfile.name() << messaget::eom;
+    vcd_writer(trace, ns, outfile.stream());
+  };
 }
 
 void neural_livenesst::sample(std::function<void(trans_tracet)> trace_consumer)
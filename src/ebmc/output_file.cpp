@@ -8,6 +8,7 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include "output_file.h"
 
+#include <util/suffix.h>
 #include <util/unicode.h>
 
 #include "ebmc_error.h"
@@ -15,7 +16,57 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <fstream>
 #include <iostream>
 
-output_filet::output_filet(std::string __file_name)
+#ifdef _WIN32
+#  define popen _popen
+#  define pclose _pclose
+#else
+#  include <csignal>
+#endif
+
+/// An output stream buffer that writes to a C stdio stream
+class stdio_streambuft : public std::streambuf
+{
+public:
+  explicit stdio_streambuft(std::FILE *_file) : file(_file)
+  {
+  }
+
+protected:
+  std::FILE *file;
+
+  int_type overflow(int_type ch) override
+  {
+    if(traits_type::eq_int_type(ch, traits_type::eof()))
+      return traits_type::not_eof(ch);
+    return std::fputc(ch, file) == EOF ? traits_type::eof() : ch;
+  }
+
+  std::streamsize xsputn(const char *s, std::streamsize n) override
+  {
+    return std::fwrite(s, 1, n, file);
+  }
+
+  int sync() override
+  {
+    return std::fflush(file);
+  }
+};
+
+// single quotes for the shell
+static std::string shell_quote(const std::string &s)
+{
+  std::string result = "'";
+  for(auto ch : s)
+  {
+    if(ch == '\'')
+      result += "'\\''";
+    else
+      result += ch;
+  }
+  return result + "'";
+}
+
+output_filet::output_filet(std::string __file_name, compressiont compression)
   : _name(std::move(__file_name))
 {
   if(_name == "-")
@@ -24,6 +75,28 @@ output_filet::output_filet(std::string __file_name)
     delete_required = false;
     _name = "stdout";
   }
+  else if(
+    compression == compressiont::BY_SUFFIX &&
+    (has_suffix(_name, ".gz") || has_suffix(_name, ".zst")))
+  {
+    std::string command = has_suffix(_name, ".gz") ? "gzip -c > "
+                                                   : "zstd -q -c > ";
+    command += shell_quote(_name);
+
+#ifndef _WIN32
+    // A compressor that fails is reported by close(),
+    // instead of terminating the process.
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+    pipe = popen(command.c_str(), "w");
+    if(pipe == nullptr)
+      throw ebmc_errort() << "failed to run `" << command << "'";
+
+    pipe_buffer = std::make_unique<stdio_streambuft>(pipe);
+    _stream = new std::ostream(pipe_buffer.get());
+    delete_required = true;
+  }
   else
   {
     _stream = new std::ofstream(widen_if_needed(_name));
@@ -33,8 +106,30 @@ output_filet::output_filet(std::string __file_name)
   }
 }
 
+void output_filet::close()
+{
+  if(pipe == nullptr)
+    return;
+
+  _stream->flush();
+  bool failed = _stream->fail();
+
+  // the exit status of the compressor
+  failed |= pclose(pipe) != 0;
+  pipe = nullptr;
+
+  // nothing can be written any more
+  _stream->setstate(std::ios::badbit);
+
+  if(failed)
+    throw ebmc_errort() << "failed to write " << _name;
+}
+
 output_filet::~output_filet()
 {
   if(delete_required)
     delete _stream;
+
+  if(pipe != nullptr)
+    pclose(pipe);
 }
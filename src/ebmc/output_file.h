@@ -9,18 +9,36 @@ Author: Daniel Kroening, dkr@amazon.com
 #ifndef EBMC_OUTPUT_FILE_H
 #define EBMC_OUTPUT_FILE_H
 
+#include <cstdio>
 #include <iosfwd>
+#include <memory>
+#include <streambuf>
 #include <string>
 
 class output_filet final
 {
 public:
+  enum class compressiont
+  {
+    NONE,
+    BY_SUFFIX
+  };
+
   /// Create a stream to the given file name,
   /// our stdout if "-".
+  /// With BY_SUFFIX, file names ending in .gz or .zst are written
+  /// through gzip or zstd, respectively, and the stream is not
+  /// seekable; call close() to learn whether that worked.
   /// Throws ebmc_errort() if the file cannot be opened.
-  explicit output_filet(std::string __file_name);
+  explicit output_filet(
+    std::string __file_name,
+    compressiont = compressiont::NONE);
   ~output_filet();
 
+  /// Waits for the compressor, if any, and throws ebmc_errort()
+  /// if it has failed. The stream is not usable afterwards.
+  void close();
+
   std::ostream &stream()
   {
     return *_stream;
@@ -36,6 +54,10 @@ protected:
   std::string _name;
   bool delete_required;
   std::ostream *_stream;
+
+  // for compressed files
+  std::FILE *pipe = nullptr;
+  std::unique_ptr<std::streambuf> pipe_buffer;
 };
 
 #endif
@@ -0,0 +1,493 @@
+/*******************************************************************\
+
+Module: Proof Cache
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Proof Cache
+
+#include "proof_cache.h"
+
+#include <util/cmdline.h>
+#include <util/ebmc_statistics.h>
+#include <util/string2int.h>
+#include <util/suffix.h>
+
+#include <json/json_parser.h>
+
+#include "cone_of_influence.h"
+#include "ebmc_error.h"
+#include "ebmc_solver_factory.h"
+#include "instrument_past.h"
+#include "k_induction.h"
+#include "mine_invariants.h"
+#include "output_file.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+
+/*******************************************************************\
+
+Function: fnv_hash
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: FNV-1a, which unlike the hashes of ireps is the same
+          in every run
+
+\*******************************************************************/
+
+static void fnv_hash(std::uint64_t &hash, const std::string &s)
+{
+  for(unsigned char c : s)
+  {
+    hash ^= c;
+    hash *= 0x100000001b3;
+  }
+
+  // terminator
+  hash ^= 0xff;
+  hash *= 0x100000001b3;
+}
+
+/*******************************************************************\
+
+Function: hash_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: structural hash, without the comments
+
+\*******************************************************************/
+
+static void hash_irep(std::uint64_t &hash, const irept &irep)
+{
+  fnv_hash(hash, irep.id_string());
+
+  // the named subtrees, ordered by name
+  std::vector<std::pair<std::string, const irept *>> named_subs;
+  for(auto &named_sub : irep.get_named_sub())
+    if(!irept::is_comment(named_sub.first))
+      named_subs.emplace_back(id2string(named_sub.first), &named_sub.second);
+
+  std::sort(
+    named_subs.begin(),
+    named_subs.end(),
+    [](const auto &a, const auto &b) { return a.first < b.first; });
+
+  for(auto &named_sub : named_subs)
+  {
+    fnv_hash(hash, named_sub.first);
+    hash_irep(hash, *named_sub.second);
+  }
+
+  fnv_hash(hash, "(");
+  for(auto &sub : irep.get_sub())
+    hash_irep(hash, sub);
+  fnv_hash(hash, ")");
+}
+
+/*******************************************************************\
+
+Function: cone_root
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the property and the assumptions, whose cone of influence
+          the result of the property depends on
+
+\*******************************************************************/
+
+static exprt cone_root(
+  const ebmc_propertiest::propertyt &property,
+  const ebmc_propertiest &properties)
+{
+  exprt::operandst roots = {property.normalized_expr};
+
+  for(auto &assumption : properties.properties)
+    if(assumption.is_assumed())
+      roots.push_back(assumption.normalized_expr);
+
+  return conjunction(roots);
+}
+
+/*******************************************************************\
+
+Function: property_key
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::string property_key(
+  const ebmc_propertiest::propertyt &property,
+  const ebmc_propertiest &properties,
+  const cone_of_influencet &cone_of_influence)
+{
+  std::uint64_t hash = 0xcbf29ce484222325;
+
+  hash_irep(hash, property.normalized_expr);
+
+  // the assumptions, and the cone of influence of all of these
+  for(auto &assumption : properties.properties)
+    if(assumption.is_assumed())
+    {
+      fnv_hash(hash, "assume");
+      hash_irep(hash, assumption.normalized_expr);
+    }
+
+  fnv_hash(hash, "cone");
+  const auto root = cone_root(property, properties);
+  for(auto &conjunct : cone_of_influence.conjuncts(root))
+    hash_irep(hash, conjunct);
+
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return key.str();
+}
+
+/*******************************************************************\
+
+Function: proof_cachet::proof_cachet
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: read the file, if there is one
+
+\*******************************************************************/
+
+proof_cachet::proof_cachet(
+  std::string _file_name,
+  message_handlert &message_handler)
+  : file_name(std::move(_file_name)), message(message_handler)
+{
+  if(file_name.empty())
+    return;
+
+  // The cache is read and written as plain text.
+  if(has_suffix(file_name, ".gz") || has_suffix(file_name, ".zst"))
+  {
+    throw ebmc_errort() << "the proof cache " << file_name
+                        << " can't be compressed";
+  }
+
+  std::ifstream in(file_name);
+
+  if(!in)
+    return; // no cache yet
+
+  jsont json;
+
+  if(parse_json(in, file_name, message_handler, json) || !json.is_object())
+  {
+    message.warning() << "ignoring malformed proof cache " << file_name
+                      << messaget::eom;
+    return;
+  }
+
+  entries = to_json_object(json);
+}
+
+/*******************************************************************\
+
+Function: proof_cachet::validate
+
+  Inputs:
+
+ Outputs: true iff k-induction proves the property again
+
+ Purpose:
+
+\*******************************************************************/
+
+bool proof_cachet::validate(
+  const cmdlinet &cmdline,
+  const transition_systemt &transition_system,
+  const ebmc_propertiest &properties,
+  const ebmc_propertiest::propertyt &property,
+  std::size_t k)
+{
+  // only the given property, with the assumptions
+  auto single = properties;
+
+  // the engine checks the property when the proof does not validate
+  single.observer = nullptr;
+
+  for(auto &other : single.properties)
+    if(other.identifier != property.identifier && !other.is_assumed())
+      other.disable();
+
+  // the step case can't do $past
+  if(has_past(transition_system, single))
+    return false;
+
+  auto solver_factory = ebmc_solver_factory(cmdline);
+
+  auto result = k_induction(
+    k,
+    transition_system,
+    single,
+    solver_factory,
+    message.get_message_handler());
+
+  for(auto &p : result.properties)
+    if(p.identifier == property.identifier)
+      return p.is_proved();
+
+  return false;
+}
+
+/*******************************************************************\
+
+Function: proof_cachet::lookup
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void proof_cachet::lookup(
+  const cmdlinet &cmdline,
+  const transition_systemt &transition_system,
+  ebmc_propertiest &properties)
+{
+  const cone_of_influencet cone_of_influence{transition_system.trans_expr};
+
+  keys.clear();
+  cached.clear();
+
+  strengthened = cmdline.isset("mine-invariants");
+
+  // the transition system with the mined invariants, for validating
+  // the proofs that used them
+  std::optional<transition_systemt> mined_transition_system;
+
+  auto bound =
+    cmdline.isset("bound")
+      ? string2optional_size_t(cmdline.get_value("bound"))
+      : std::nullopt;
+
+  for(auto &property : properties.properties)
+  {
+    if(!property.is_unknown())
+      continue;
+
+    auto key = property_key(property, properties, cone_of_influence);
+    keys[property.identifier] = key;
+
+    // an earlier check in this process, which may also be a refutation
+    auto result_it = results.find(key);
+    if(result_it != results.end())
+    {
+      const auto &earlier = result_it->second;
+      property.status = earlier.status;
+      property.bound = earlier.bound;
+      property.witness_trace = earlier.witness_trace;
+      property.proof_via = earlier.proof_via;
+
+      // The variables outside the cone of influence may have changed,
+      // and their values in the trace are stale.
+      if(property.witness_trace.has_value())
+      {
+        property.witness_trace->restrict_variables(
+          cone_of_influence(cone_root(property, properties)));
+      }
+      properties.result_found(property);
+
+      message.status() << "Result for " << property.name << " is unchanged"
+                       << messaget::eom;
+      ebmc_statistics().count("results reused");
+
+      cached.emplace(property.identifier, property);
+      property.disable();
+      continue;
+    }
+
+    auto entry_it = entries.find(key);
+    if(entry_it == entries.end() || !entry_it->second.is_object())
+      continue;
+
+    const auto &entry = to_json_object(entry_it->second);
+    const auto status = entry["status"].value;
+
+    if(status == "PROVED")
+    {
+      const auto &proof_via = entry["proof_via"].value;
+
+      // Any proof is checked again with k-induction, with the k of a
+      // k-induction proof, and with k=1 otherwise. The proofs that
+      // are not k-inductive are found again by the engine.
+      std::size_t k = 1;
+      const std::string suffix = "-induction";
+      if(has_suffix(proof_via, suffix))
+      {
+        auto proof_k = string2optional_size_t(
+          proof_via.substr(0, proof_via.size() - suffix.size()));
+        if(proof_k.has_value())
+          k = *proof_k;
+      }
+
+      // with the mined invariants, if these strengthened the proof
+      const bool use_mined_invariants =
+        strengthened || entry["mine_invariants"].is_true();
+
+      if(use_mined_invariants && !mined_transition_system.has_value())
+      {
+        mined_transition_system = transition_system;
+        mine_invariants(
+          *mined_transition_system, message.get_message_handler());
+      }
+
+      if(!validate(
+           cmdline,
+           use_mined_invariants ? *mined_transition_system : transition_system,
+           properties,
+           property,
+           k))
+      {
+        message.status() << "Cached proof of " << property.name
+                         << " does not validate" << messaget::eom;
+        ebmc_statistics().count("proof cache validation failures");
+        continue;
+      }
+
+      if(proof_via.empty())
+        property.proved();
+      else
+        property.proved(proof_via);
+    }
+    else if(status == "PROVED_WITH_BOUND")
+    {
+      auto cached_bound = string2optional_size_t(entry["bound"].value);
+      if(!cached_bound.has_value())
+        continue;
+
+      // A smaller bound is where BMC starts.
+      if(!bound.has_value() || *cached_bound < *bound)
+      {
+        property.seed_bound = *cached_bound;
+        message.status() << "Bound " << *cached_bound << " for "
+                         << property.name << " taken from proof cache"
+                         << messaget::eom;
+        ebmc_statistics().count("proof cache seeds");
+        continue;
+      }
+
+      property.proved_with_bound(*cached_bound);
+    }
+    else
+      continue;
+
+    message.status() << "Result for " << property.name
+                     << " taken from proof cache" << messaget::eom;
+    ebmc_statistics().count("proof cache hits");
+    properties.result_found(property);
+
+    cached.emplace(property.identifier, property);
+
+    // not to be checked by the engine
+    property.disable();
+  }
+}
+
+/*******************************************************************\
+
+Function: proof_cachet::update
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void proof_cachet::update(property_checker_resultt &result)
+{
+  for(auto &property : result.properties)
+  {
+    auto cached_it = cached.find(property.identifier);
+    if(cached_it != cached.end())
+    {
+      property = cached_it->second;
+      continue;
+    }
+
+    auto key_it = keys.find(property.identifier);
+    if(key_it == keys.end())
+      continue;
+
+    const auto &key = key_it->second;
+
+    using statust = ebmc_propertiest::propertyt::statust;
+
+    if(
+      property.status == statust::PROVED ||
+      property.status == statust::PROVED_WITH_BOUND ||
+      property.status == statust::REFUTED ||
+      property.status == statust::REFUTED_WITH_BOUND)
+    {
+      results.insert_or_assign(key, property);
+    }
+
+    json_objectt entry;
+    entry["description"] = json_stringt{property.description};
+
+    if(property.is_proved())
+    {
+      entry["status"] = json_stringt{"PROVED"};
+      entry["proof_via"] = json_stringt{property.proof_via.value_or("")};
+      if(strengthened)
+        entry["mine_invariants"] = jsont::json_boolean(true);
+    }
+    else if(property.is_proved_with_bound())
+    {
+      // keep the larger bound
+      auto old_it = entries.find(key);
+      if(old_it != entries.end() && old_it->second.is_object())
+      {
+        auto &old = to_json_object(old_it->second);
+        if(old["status"].value == "PROVED")
+          continue;
+        auto old_bound = string2optional_size_t(old["bound"].value);
+        if(old_bound.has_value() && *old_bound >= property.bound)
+          continue;
+      }
+
+      entry["status"] = json_stringt{"PROVED_WITH_BOUND"};
+      entry["bound"] = json_numbert{std::to_string(property.bound)};
+    }
+    else
+      continue;
+
+    entries[key] = std::move(entry);
+  }
+
+  if(file_name.empty())
+    return; // kept in memory only
+
+  auto outfile = output_filet{file_name};
+  outfile.stream() << entries << '\n';
+}
@@ -0,0 +1,76 @@
+/*******************************************************************\
+
+Module: Proof Cache
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Proof Cache
+
+#ifndef CPROVER_EBMC_PROOF_CACHE_H
+#define CPROVER_EBMC_PROOF_CACHE_H
+
+#include <util/json.h>
+#include <util/message.h>
+
+#include "property_checker.h"
+
+#include <map>
+
+class cmdlinet;
+
+/// A file of the results of earlier runs, keyed by a hash of the
+/// normalized property, the assumptions, and the conjuncts of the
+/// transition system in their cone of influence. Comments, such as
+/// source locations, are not part of the hash. The cache records
+/// proofs, with the method of the proof and whether mined invariants
+/// strengthened it, and bounded proofs.
+/// The cache also remembers all results of the process, including
+/// refutations, which --watch reuses when the design changes.
+/// Implements --proof-cache.
+class proof_cachet
+{
+public:
+  /// The cache is not read from or written to a file when the
+  /// file name is empty.
+  proof_cachet(std::string file_name, message_handlert &);
+
+  /// Gives the unknown properties with a cached result that applies
+  /// to this run that result, and disables them for the engine.
+  /// Proofs are validated again with k-induction, with the cached k
+  /// of k-induction proofs. Smaller cached bounds are the seed_bound
+  /// of the property.
+  void lookup(const cmdlinet &, const transition_systemt &, ebmc_propertiest &);
+
+  /// Restores the cached results in the result of the engine, and
+  /// records its proofs in the file.
+  void update(property_checker_resultt &);
+
+protected:
+  std::string file_name;
+  messaget message;
+  json_objectt entries;
+
+  // whether the proofs of this run use mined invariants
+  bool strengthened = false;
+
+  // the keys of the properties, by identifier
+  std::map<irep_idt, std::string> keys;
+
+  // the properties that have their result from the cache
+  std::map<irep_idt, ebmc_propertiest::propertyt> cached;
+
+  // the results of the earlier checks in this process, by key
+  std::map<std::string, ebmc_propertiest::propertyt> results;
+
+  bool validate(
+    const cmdlinet &,
+    const transition_systemt &,
+    const ebmc_propertiest &,
+    const ebmc_propertiest::propertyt &,
+    std::size_t k);
+};
+
+#endif // CPROVER_EBMC_PROOF_CACHE_H
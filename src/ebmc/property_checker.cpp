@@ -8,9 +8,11 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include "property_checker.h"
 
+#include <util/ebmc_limits.h>
+#include <util/ebmc_statistics.h>
 #include <util/string2int.h>
 
-#include <solvers/sat/satcheck.h>
+#include <solvers/prop/literal_expr.h>
 #include <trans-netlist/trans_trace_netlist.h>
 #include <trans-netlist/unwind_netlist.h>
 
@@ -23,13 +25,17 @@ Author: Daniel Kroening, dkr@amazon.com
 #include "ic3_engine.h"
 #include "instrument_past.h"
 #include "k_induction.h"
+#include "k_liveness.h"
+#include "mine_invariants.h"
 #include "netlist.h"
 #include "output_file.h"
+#include "proof_cache.h"
+#include "property_stream.h"
 #include "report_results.h"
 #include "tautology_check.h"
 
-#include <chrono>
 #include <iostream>
+#include <optional>
 
 property_checker_resultt word_level_bmc(
   const cmdlinet &cmdline,
@@ -124,83 +130,23 @@ property_checker_resultt word_level_bmc(
   }
 }
 
-property_checker_resultt finish_bit_level_bmc(
-  std::size_t bound,
-  const bmc_mapt &bmc_map,
-  propt &solver,
-  const transition_systemt &transition_system,
-  ebmc_propertiest &properties,
-  message_handlert &message_handler)
+static void
+show_encoding_statistics(const netlist_encodingt &encoding, messaget &message)
 {
-  auto sat_start_time = std::chrono::steady_clock::now();
-
-  messaget message{message_handler};
-  message.status() << "Solving with " << solver.solver_text() << messaget::eom;
-
-  for(auto &property : properties.properties)
-  {
-    if(property.is_disabled())
-      continue;
-
-    if(property.is_failure())
-      continue;
-
-    if(property.is_assumed())
-      continue;
-
-    message.status() << "Checking " << property.name << messaget::eom;
-
-    literalt property_literal = !solver.land(property.timeframe_literals);
-
-    bvt assumptions;
-    assumptions.push_back(property_literal);
-
-    propt::resultt prop_result = solver.prop_solve(assumptions);
-
-    switch(prop_result)
-    {
-    case propt::resultt::P_SATISFIABLE:
-    {
-      property.refuted();
-      message.result() << "SAT: counterexample found" << messaget::eom;
-
-      namespacet ns{transition_system.symbol_table};
-
-      property.witness_trace =
-        compute_trans_trace(property.timeframe_literals, bmc_map, solver, ns);
-    }
-    break;
-
-    case propt::resultt::P_UNSATISFIABLE:
-      message.result() << "UNSAT: No counterexample found within bound"
-                       << messaget::eom;
-      property.proved_with_bound(bound);
-      break;
-
-    case propt::resultt::P_ERROR:
-      message.error() << "Error from decision procedure" << messaget::eom;
-      return property_checker_resultt::error();
-
-    default:
-      message.error() << "Unexpected result from decision procedure"
-                      << messaget::eom;
-      return property_checker_resultt::error();
-    }
-  }
-
-  auto sat_stop_time = std::chrono::steady_clock::now();
-
-  message.statistics()
-    << "Solver time: "
-    << std::chrono::duration<double>(sat_stop_time - sat_start_time).count()
-    << messaget::eom;
-
-  return property_checker_resultt{properties};
+  const auto &statistics = encoding.get_statistics();
+
+  message.statistics() << "CNF gates: " << statistics.and_gates << " AND, "
+                       << statistics.wide_and_gates << " wide AND, "
+                       << statistics.xor_gates << " XOR, "
+                       << statistics.mux_gates << " MUX, "
+                       << statistics.one_sided << " one-sided, "
+                       << statistics.unused << " unused" << messaget::eom;
 }
 
+/// Unwinds the netlist into the given CNF without solving it,
+/// for the DIMACS output.
 property_checker_resultt bit_level_bmc(
   cnft &solver,
-  bool convert_only,
   const cmdlinet &cmdline,
   transition_systemt &transition_system,
   ebmc_propertiest &properties,
@@ -222,15 +168,16 @@ property_checker_resultt bit_level_bmc(
 
   try
   {
-    if(!convert_only)
-      if(properties.properties.empty())
-        throw "no properties";
-
     // make net-list
     message.status() << "Generating Netlist" << messaget::eom;
 
     auto netlist = make_netlist(transition_system, properties, message_handler);
 
+    if(cmdline.isset("memory-diet"))
+      netlist_memory_diet(transition_system);
+
+    simplify_netlist(netlist, cmdline, message_handler);
+
     message.statistics() << "Latches: " << netlist.var_map.latches.size()
                          << ", nodes: " << netlist.number_of_nodes()
                          << messaget::eom;
@@ -240,7 +187,13 @@ property_checker_resultt bit_level_bmc(
 
     const auto bmc_map = bmc_mapt{netlist, bound + 1, solver};
 
-    ::unwind(netlist, bmc_map, message, solver);
+    {
+      ebmc_phaset phase("unwind");
+      const netlist_encodingt encoding{netlist};
+      show_encoding_statistics(encoding, message);
+
+      ::unwind(netlist, bmc_map, message, solver, true, encoding);
+    }
 
     const namespacet ns(transition_system.symbol_table);
 
@@ -278,13 +231,7 @@ property_checker_resultt bit_level_bmc(
       }
     }
 
-    if(convert_only)
-      return property_checker_resultt::success();
-    else
-    {
-      return finish_bit_level_bmc(
-        bound, bmc_map, solver, transition_system, properties, message_handler);
-    }
+    return property_checker_resultt::success();
   }
 
   catch(const char *e)
@@ -307,44 +254,321 @@ property_checker_resultt bit_level_bmc(
   }
 }
 
+/// Bit-level BMC that adds one timeframe at a time, and checks the
+/// properties in the new timeframe under assumptions. Reports the
+/// first failing depth of each property, and thus, the shortest
+/// counterexample.
+/// Given an iCNF writer, the assumption that some property fails is
+/// written for each timeframe instead.
+property_checker_resultt incremental_bit_level_bmc(
+  cnft &solver,
+  dimacs_cnf_writert *icnf_writer,
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  message_handlert &message_handler)
+{
+  messaget message{message_handler};
+
+  std::size_t bound;
+
+  if(cmdline.isset("bound"))
+  {
+    bound = unsafe_string2unsigned(cmdline.get_value("bound"));
+  }
+  else
+  {
+    message.warning() << "using default bound 1" << messaget::eom;
+    bound = 1;
+  }
+
+  if(icnf_writer == nullptr && properties.properties.empty())
+  {
+    message.error() << "no properties" << messaget::eom;
+    return property_checker_resultt::error();
+  }
+
+  // make net-list
+  message.status() << "Generating Netlist" << messaget::eom;
+
+  auto netlist = make_netlist(transition_system, properties, message_handler);
+
+  if(cmdline.isset("memory-diet"))
+    netlist_memory_diet(transition_system);
+
+  simplify_netlist(netlist, cmdline, message_handler);
+
+  message.statistics() << "Latches: " << netlist.var_map.latches.size()
+                       << ", nodes: " << netlist.number_of_nodes()
+                       << messaget::eom;
+
+  const netlist_encodingt encoding{netlist};
+  show_encoding_statistics(encoding, message);
+
+  const namespacet ns(transition_system.symbol_table);
+
+  // the netlist node of each property that is checked or assumed
+  std::vector<std::pair<ebmc_propertiest::propertyt *, literalt>>
+    property_nodes;
+
+  for(auto &property : properties.properties)
+  {
+    if(property.is_disabled())
+      continue;
+
+    if(!netlist_bmc_supports_property(property.normalized_expr))
+    {
+      property.failure("property not supported by netlist BMC engine");
+      continue;
+    }
+
+    // look up the property in the netlist
+    auto netlist_property = netlist.properties.find(property.identifier);
+    CHECK_RETURN(netlist_property != netlist.properties.end());
+    CHECK_RETURN(netlist_property->second.has_value());
+
+    auto &p = to_unary_expr(netlist_property->second.value()).op();
+    PRECONDITION(p.id() == ID_literal);
+
+    property.timeframe_literals.clear();
+    property_nodes.emplace_back(&property, to_literal_expr(p).get_literal());
+  }
+
+  if(icnf_writer == nullptr)
+  {
+    message.status() << "Solving with " << solver.solver_text()
+                     << messaget::eom;
+  }
+
+  ebmc_phaset solve_phase(icnf_writer == nullptr ? "solve" : "unwind");
+
+  // the timeframes are added to an initially empty map
+  bmc_mapt bmc_map{netlist, 0, solver};
+
+  // the properties are solved in turns, one per timeframe
+  ebmc_property_timest property_times;
+
+  for(std::size_t t = 0; t <= bound; t++)
+  {
+    bool unknown = icnf_writer != nullptr;
+    for(auto &[property, node] : property_nodes)
+      if(property->is_unknown())
+        unknown = true;
+
+    if(!unknown)
+      break;
+
+    if(auto reason = ebmc_limits().exceeded())
+    {
+      message.warning() << "Giving up at depth " << t << ": " << *reason
+                        << messaget::eom;
+      if(t == 0)
+        properties.limit_exceeded(*reason);
+      else
+        properties.limit_exceeded(*reason, t - 1);
+      break;
+    }
+
+    ebmc_phaset phase("depth " + std::to_string(t));
+
+    bmc_map.add_timeframe(netlist, solver);
+    ::unwind(netlist, bmc_map, message, solver, true, t, encoding);
+
+    // the next timeframe uses the next-state literals
+    for(auto &var_it : netlist.var_map.map)
+      if(var_it.second.is_latch())
+        for(auto &bit : var_it.second.bits)
+        {
+          literalt l = bmc_map.translate(t, bit.next);
+          if(!l.is_constant())
+            solver.set_frozen(l);
+        }
+
+    for(auto &[property, node] : property_nodes)
+    {
+      literalt l = bmc_map.translate(t, node);
+      property->timeframe_literals.push_back(l);
+
+      if(property->is_assumed())
+        solver.l_set_to_true(l);
+      else if(!l.is_constant())
+        solver.set_frozen(l);
+    }
+
+    if(icnf_writer != nullptr)
+    {
+      // some property fails in this timeframe
+      bvt violations;
+      for(auto &[property, node] : property_nodes)
+        if(property->is_unknown())
+          violations.push_back(!property->timeframe_literals.back());
+
+      literalt violation = solver.lor(violations);
+
+      if(violation.is_constant())
+      {
+        literalt l = solver.new_variable();
+        solver.set_equal(l, violation);
+        violation = l;
+      }
+
+      icnf_writer->write_assumptions({violation});
+      continue;
+    }
+
+    for(auto &[property, node] : property_nodes)
+    {
+      if(!property->is_unknown())
+        continue;
+
+      literalt l = property->timeframe_literals.back();
+
+      if(l.is_true())
+        continue;
+
+      if(property_times.exceeded(property->identifier))
+      {
+        message.warning() << "Giving up on " << property->name
+                          << " at depth " << t << ": property timeout"
+                          << messaget::eom;
+        if(t == 0)
+          property->limit_exceeded("property timeout");
+        else
+          property->limit_exceeded("property timeout", t - 1);
+        properties.result_found(*property);
+        continue;
+      }
+
+      bvt assumptions;
+      if(!l.is_false())
+        assumptions.push_back(!l);
+
+      ebmc_statistics().count("SAT calls");
+      auto start = ebmc_property_timest::clockt::now();
+      auto prop_result = solver.prop_solve(assumptions);
+      property_times.charge(
+        property->identifier, ebmc_property_timest::clockt::now() - start);
+
+      switch(prop_result)
+      {
+      case propt::resultt::P_SATISFIABLE:
+      {
+        message.result() << "SAT: counterexample for " << property->name
+                         << " found at depth " << t << messaget::eom;
+        {
+          ebmc_phaset trace_phase("trace");
+          property->witness_trace = compute_trans_trace(
+            property->timeframe_literals,
+            bmc_map,
+            solver,
+            ns,
+            property->trace_variables);
+        }
+
+        property->refuted();
+        properties.result_found(*property);
+      }
+      break;
+
+      case propt::resultt::P_UNSATISFIABLE:
+        // holds in this timeframe on all paths
+        solver.l_set_to_true(l);
+        break;
+
+      case propt::resultt::P_ERROR:
+        message.error() << "Error from decision procedure" << messaget::eom;
+        return property_checker_resultt::error();
+
+      default:
+        message.error() << "Unexpected result from decision procedure"
+                        << messaget::eom;
+        return property_checker_resultt::error();
+      }
+    }
+  }
+
+  ebmc_statistics().count("variables", solver.no_variables());
+
+  if(icnf_writer != nullptr)
+    return property_checker_resultt::success();
+
+  for(auto &[property, node] : property_nodes)
+    if(property->is_unknown())
+    {
+      property->proved_with_bound(bound);
+      properties.result_found(*property);
+    }
+
+  return property_checker_resultt{properties};
+}
+
 property_checker_resultt bit_level_bmc(
   const cmdlinet &cmdline,
   transition_systemt &transition_system,
   ebmc_propertiest &properties,
   message_handlert &message_handler)
 {
-  if(cmdline.isset("dimacs"))
+  if(cmdline.isset("dimacs") || cmdline.isset("icnf"))
   {
+    const auto format = cmdline.isset("icnf")
+                          ? dimacs_cnf_writert::formatt::ICNF
+                          : dimacs_cnf_writert::formatt::DIMACS;
+
+    std::optional<output_filet> outfile;
+
     if(cmdline.isset("outfile"))
     {
-      auto outfile = output_filet{cmdline.get_value("outfile")};
+      outfile.emplace(
+        cmdline.get_value("outfile"), output_filet::compressiont::BY_SUFFIX);
 
       messaget message{message_handler};
-      message.status() << "Writing DIMACS CNF to `" << outfile.name() << "'"
-                       << messaget::eom;
+      message.status() << "Writing "
+                       << (format == dimacs_cnf_writert::formatt::ICNF
+                             ? "iCNF"
+                             : "DIMACS CNF")
+                       << " to `" << outfile->name() << "'" << messaget::eom;
+    }
 
-      dimacs_cnf_writert dimacs_cnf_writer{outfile.stream(), message_handler};
+    auto &out = outfile.has_value() ? outfile->stream() : std::cout;
+
+    // When the formula goes to stdout, the messages go to stderr.
+    stream_message_handlert stderr_message_handler{std::cerr};
+    stderr_message_handler.set_verbosity(message_handler.get_verbosity());
+
+    message_handlert &cnf_message_handler =
+      &out == &std::cout ? stderr_message_handler : message_handler;
+
+    std::optional<property_checker_resultt> result;
 
-      return bit_level_bmc(
-        dimacs_cnf_writer,
-        true,
-        cmdline,
-        transition_system,
-        properties,
-        message_handler);
-    }
-    else
     {
-      dimacs_cnf_writert dimacs_cnf_writer{std::cout, message_handler};
+      dimacs_cnf_writert cnf_writer{out, format, cnf_message_handler};
 
-      return bit_level_bmc(
-        dimacs_cnf_writer,
-        true,
-        cmdline,
-        transition_system,
-        properties,
-        message_handler);
+      if(format == dimacs_cnf_writert::formatt::ICNF)
+      {
+        result = incremental_bit_level_bmc(
+          cnf_writer,
+          &cnf_writer,
+          cmdline,
+          transition_system,
+          properties,
+          cnf_message_handler);
+      }
+      else
+      {
+        result = bit_level_bmc(
+          cnf_writer,
+          cmdline,
+          transition_system,
+          properties,
+          cnf_message_handler);
+      }
     }
+
+    // the writer has flushed the formula
+    if(outfile.has_value())
+      outfile->close();
+
+    return std::move(*result);
   }
   else
   {
@@ -352,16 +576,25 @@ property_checker_resultt bit_level_bmc(
       throw ebmc_errort()
         << "Cannot write to outfile without file format option";
 
-    satcheckt satcheck{message_handler};
-
-    messaget message{message_handler};
-    message.status() << "Using " << satcheck.solver_text() << messaget::eom;
+    auto solver = ebmc_sat_solver(cmdline, message_handler);
 
-    return bit_level_bmc(
-      satcheck, false, cmdline, transition_system, properties, message_handler);
+    return incremental_bit_level_bmc(
+      *solver, nullptr, cmdline, transition_system, properties,
+      message_handler);
   }
 }
 
+/// Gives up on the unknown properties when a limit on the whole run
+/// is exceeded, and returns whether that is so.
+static bool run_limit_exceeded(ebmc_propertiest &properties)
+{
+  if(!ebmc_limits().run_exceeded())
+    return false;
+
+  properties.limit_exceeded(*ebmc_limits().exceeded());
+  return true;
+}
+
 property_checker_resultt engine_heuristic(
   const cmdlinet &cmdline,
   transition_systemt &transition_system,
@@ -384,6 +617,19 @@ property_checker_resultt engine_heuristic(
   message.status() << "No engine given, attempting heuristic engine selection"
                    << messaget::eom;
 
+  // The next engine takes over from the probes, and thus only their
+  // proofs and refutations are results.
+  auto observer = properties.observer;
+
+  if(observer)
+  {
+    properties.observer = [observer](const ebmc_propertiest::propertyt &p) {
+      using statust = ebmc_propertiest::propertyt::statust;
+      if(p.status == statust::PROVED || p.status == statust::REFUTED)
+        observer(p);
+    };
+  }
+
   // First check if we can tell that the property is a tautology
   message.status() << "Tautology check" << messaget::eom;
 
@@ -395,6 +641,10 @@ property_checker_resultt engine_heuristic(
   if(!properties.has_unfinished_property())
     return tautology_check_result; // done
 
+  // no time or memory left for the next engine
+  if(run_limit_exceeded(properties))
+    return property_checker_resultt{properties};
+
   properties.reset_failure();
   properties.reset_inconclusive();
   properties.reset_unsupported();
@@ -410,6 +660,10 @@ property_checker_resultt engine_heuristic(
   if(!properties.has_unfinished_property())
     return completeness_threshold_result; // done
 
+  // no time or memory left for the next engine
+  if(run_limit_exceeded(properties))
+    return property_checker_resultt{properties};
+
   properties.reset_failure();
   properties.reset_inconclusive();
   properties.reset_unsupported();
@@ -425,6 +679,10 @@ property_checker_resultt engine_heuristic(
   if(!properties.has_unfinished_property())
     return k_induction_result; // done
 
+  // no time or memory left for the next engine
+  if(run_limit_exceeded(properties))
+    return property_checker_resultt{properties};
+
   properties.reset_failure();
   properties.reset_inconclusive();
   properties.reset_unsupported();
@@ -432,6 +690,8 @@ property_checker_resultt engine_heuristic(
   // Now try BMC with bound 5, word-level
   message.status() << "Attempting BMC with bound 5" << messaget::eom;
 
+  properties.observer = observer;
+
   auto bmc_result = bmc(
     5,     // bound
     false, // convert_only
@@ -452,72 +712,215 @@ property_checker_resultt engine_heuristic(
   return property_checker_resultt{properties}; // done
 }
 
-property_checker_resultt property_checker(
+/// runs the engine given on the command line
+static property_checker_resultt engine(
   const cmdlinet &cmdline,
   transition_systemt &transition_system,
   ebmc_propertiest &properties,
   message_handlert &message_handler)
 {
-  bool use_heuristic_engine = !cmdline.isset("bdd") && !cmdline.isset("aig") &&
-                              !cmdline.isset("k-induction") &&
-                              !cmdline.isset("ic3") && !cmdline.isset("bound");
-
-  if(cmdline.isset("k-induction") || use_heuristic_engine)
+  if(cmdline.isset("bdd") || cmdline.isset("show-bdds"))
   {
-    // The step case of k-induction can't do $past
-    instrument_past(transition_system, properties);
+    return bdd_engine(cmdline, transition_system, properties, message_handler);
   }
-
-  auto result = [&]() -> property_checker_resultt
+  else if(
+    cmdline.isset("aig") || cmdline.isset("dimacs") || cmdline.isset("icnf"))
+  {
+    // bit-level BMC
+    return bit_level_bmc(
+      cmdline, transition_system, properties, message_handler);
+  }
+  else if(cmdline.isset("k-induction"))
+  {
+    return k_induction(cmdline, transition_system, properties, message_handler);
+  }
+  else if(cmdline.isset("k-liveness"))
+  {
+    return k_liveness(cmdline, transition_system, properties, message_handler);
+  }
+  else if(cmdline.isset("ic3"))
   {
-    if(cmdline.isset("bdd") || cmdline.isset("show-bdds"))
-    {
-      return bdd_engine(
-        cmdline, transition_system, properties, message_handler);
-    }
-    else if(cmdline.isset("aig") || cmdline.isset("dimacs"))
-    {
-      // bit-level BMC
-      return bit_level_bmc(
-        cmdline, transition_system, properties, message_handler);
-    }
-    else if(cmdline.isset("k-induction"))
-    {
-      return k_induction(
-        cmdline, transition_system, properties, message_handler);
-    }
-    else if(cmdline.isset("ic3"))
-    {
 #ifdef _WIN32
-      throw ebmc_errort() << "No support for IC3 on Windows";
+    throw ebmc_errort() << "No support for IC3 on Windows";
 #else
-      return ic3_engine(
-        cmdline, transition_system, properties, message_handler);
+    return ic3_engine(cmdline, transition_system, properties, message_handler);
 #endif
-    }
-    else if(cmdline.isset("bound"))
+  }
+  else if(cmdline.isset("bound"))
+  {
+    // word-level BMC
+    return word_level_bmc(
+      cmdline, transition_system, properties, message_handler);
+  }
+  else
+  {
+    // heuristic engine selection
+    return engine_heuristic(
+      cmdline, transition_system, properties, message_handler);
+  }
+}
+
+/// The liveness-to-safety translation with --loop-signature checks a
+/// stronger property. Its refutations are confirmed by checking the
+/// confirmation_expr of the property.
+static void confirm_refutations(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  property_checker_resultt &result,
+  message_handlert &message_handler)
+{
+  ebmc_propertiest confirmation;
+  confirmation.properties = result.properties;
+  std::size_t count = 0;
+
+  for(auto &property : confirmation.properties)
+  {
+    if(property.is_refuted() && property.confirmation_expr.has_value())
     {
-      // word-level BMC
-      return word_level_bmc(
-        cmdline, transition_system, properties, message_handler);
+      property.normalized_expr = std::move(*property.confirmation_expr);
+      property.confirmation_expr.reset();
+      property.witness_trace.reset();
+      property.unknown();
+      count++;
     }
-    else
+    else if(!property.is_assumed())
+      property.disable();
+  }
+
+  if(count == 0)
+    return;
+
+  messaget message{message_handler};
+  message.status() << "Confirming " << count << " refutation"
+                   << (count == 1 ? "" : "s") << " with the full state"
+                   << messaget::eom;
+
+  auto confirmation_result =
+    engine(cmdline, transition_system, confirmation, message_handler);
+
+  auto confirmation_it = confirmation_result.properties.begin();
+
+  for(auto &property : result.properties)
+  {
+    auto &confirmed = *confirmation_it++;
+
+    if(!property.is_refuted() || !property.confirmation_expr.has_value())
+      continue;
+
+    if(
+      confirmation_result.status ==
+      property_checker_resultt::statust::VERIFICATION_RESULT)
     {
-      // heuristic engine selection
-      return engine_heuristic(
-        cmdline, transition_system, properties, message_handler);
+      property = confirmed;
     }
-  }();
+    else
+      property.inconclusive("refutation not confirmed");
+  }
+}
+
+property_checker_resultt property_checker(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  proof_cachet *proof_cache,
+  std::ostream *json_lines,
+  message_handlert &message_handler)
+{
+  bool use_heuristic_engine =
+    !cmdline.isset("bdd") && !cmdline.isset("aig") &&
+    !cmdline.isset("k-induction") && !cmdline.isset("k-liveness") &&
+    !cmdline.isset("ic3") && !cmdline.isset("bound");
+
+  if(
+    cmdline.isset("k-induction") || cmdline.isset("k-liveness") ||
+    use_heuristic_engine)
+  {
+    // The step case of k-induction can't do $past
+    instrument_past(transition_system, properties);
+  }
+
+  // The results are written as soon as the engines find them.
+  std::optional<property_streamt> property_stream;
+
+  if(json_lines != nullptr)
+  {
+    property_stream.emplace(
+      *json_lines, namespacet{transition_system.symbol_table});
+
+    properties.observer =
+      [&property_stream](const ebmc_propertiest::propertyt &property)
+    { property_stream->write(property); };
+  }
+
+  // The cache is keyed by the transition system before the
+  // mined invariants are added.
+  if(proof_cache != nullptr)
+    proof_cache->lookup(cmdline, transition_system, properties);
+
+  // Proved invariants strengthen the step case of k-induction,
+  // and are constraints for the other engines.
+  if(cmdline.isset("mine-invariants"))
+    mine_invariants(transition_system, message_handler);
+
+  auto result =
+    proof_cache != nullptr && !properties.has_unfinished_property()
+      ? property_checker_resultt{properties} // all from the cache
+      : engine(cmdline, transition_system, properties, message_handler);
 
   if(result.status == property_checker_resultt::statust::VERIFICATION_RESULT)
+    confirm_refutations(cmdline, transition_system, result, message_handler);
+
+  if(
+    proof_cache != nullptr &&
+    result.status == property_checker_resultt::statust::VERIFICATION_RESULT)
   {
+    proof_cache->update(result);
+  }
+
+  if(
+    property_stream.has_value() &&
+    result.status == property_checker_resultt::statust::VERIFICATION_RESULT)
+  {
+    property_stream->final_results(result.properties);
+  }
+
+  if(result.status == property_checker_resultt::statust::VERIFICATION_RESULT)
+  {
+    ebmc_phaset phase("report");
     const namespacet ns{transition_system.symbol_table};
     report_results(cmdline, use_heuristic_engine, result, ns, message_handler);
   }
 
+  properties.observer = nullptr;
+
   return result;
 }
 
+property_checker_resultt property_checker(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  message_handlert &message_handler)
+{
+  std::optional<proof_cachet> proof_cache;
+
+  if(cmdline.isset("proof-cache"))
+    proof_cache.emplace(cmdline.get_value("proof-cache"), message_handler);
+
+  std::optional<output_filet> json_lines;
+
+  if(cmdline.isset("json-lines"))
+    json_lines.emplace(cmdline.get_value("json-lines"));
+
+  return property_checker(
+    cmdline,
+    transition_system,
+    properties,
+    proof_cache.has_value() ? &*proof_cache : nullptr,
+    json_lines.has_value() ? &json_lines->stream() : nullptr,
+    message_handler);
+}
+
 int property_checker_resultt::exit_code() const
 {
   switch(status)
@@ -12,6 +12,8 @@ Author: Daniel Kroening, dkr@amazon.com
 #include "ebmc_properties.h"
 #include "transition_system.h"
 
+#include <iosfwd>
+
 class property_checker_resultt
 {
 public:
@@ -85,4 +87,16 @@ property_checker_resultt property_checker(
   ebmc_propertiest &,
   message_handlert &);
 
+class proof_cachet;
+
+/// As above, with the proof cache and the stream for --json-lines
+/// kept by the caller, who runs many checks; both are optional.
+property_checker_resultt property_checker(
+  const cmdlinet &,
+  transition_systemt &,
+  ebmc_propertiest &,
+  proof_cachet *,
+  std::ostream *json_lines,
+  message_handlert &);
+
 #endif
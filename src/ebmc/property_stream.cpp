@@ -0,0 +1,98 @@
+/*******************************************************************\
+
+Module: Streaming of Property Results
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Streaming of Property Results
+
+#include "property_stream.h"
+
+#include "report_results.h"
+
+/*******************************************************************\
+
+Function: property_streamt::property_streamt
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+property_streamt::property_streamt(std::ostream &_out, const namespacet &_ns)
+  : out(_out), ns(_ns), start(std::chrono::steady_clock::now())
+{
+}
+
+/*******************************************************************\
+
+Function: property_streamt::final_results
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void property_streamt::final_results(
+  const ebmc_propertiest::propertiest &result)
+{
+  for(auto &property : result)
+    write(property);
+}
+
+/*******************************************************************\
+
+Function: property_streamt::write
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void property_streamt::write(const ebmc_propertiest::propertyt &property)
+{
+  if(property.is_disabled() || property.is_assumed() || property.is_unknown())
+    return; // no result
+
+  // a refutation that is yet to be confirmed is not a result
+  if(property.is_refuted() && property.confirmation_expr.has_value())
+    return;
+
+  auto status = property.status_as_string();
+  auto written_it = written.find(property.identifier);
+
+  if(written_it != written.end() && written_it->second == status)
+    return; // no news
+
+  written[property.identifier] = std::move(status);
+
+  auto record = json_result(property, ns);
+
+  record["name"] = json_stringt{id2string(property.name)};
+
+  using statust = ebmc_propertiest::propertyt::statust;
+
+  if(
+    property.status == statust::PROVED_WITH_BOUND ||
+    property.status == statust::REFUTED_WITH_BOUND)
+    record["bound"] = json_numbert{std::to_string(property.bound)};
+
+  auto seconds = std::chrono::duration<double>(
+                   std::chrono::steady_clock::now() - start)
+                   .count();
+  record["time"] = json_numbert{std::to_string(seconds)};
+
+  output_json_line(out, record);
+}
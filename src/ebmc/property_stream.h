@@ -0,0 +1,51 @@
+/*******************************************************************\
+
+Module: Streaming of Property Results
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Streaming of Property Results
+
+#ifndef CPROVER_EBMC_PROPERTY_STREAM_H
+#define CPROVER_EBMC_PROPERTY_STREAM_H
+
+#include <util/namespace.h>
+
+#include "ebmc_properties.h"
+
+#include <chrono>
+#include <iosfwd>
+#include <unordered_map>
+
+/// Writes a JSON object to the given stream for each new result of
+/// a property, one per line, and flushes the stream. The results found
+/// so far are thus available while the engines are running, and remain
+/// when the process is killed. Later lines for a property replace the
+/// earlier ones. The object lasts for one run of the engines, while
+/// the stream may be kept by the caller for many runs.
+/// Implements --json-lines.
+class property_streamt
+{
+public:
+  property_streamt(std::ostream &, const namespacet &);
+
+  /// writes the result of the property, unless it is the result
+  /// last written for the property
+  void write(const ebmc_propertiest::propertyt &);
+
+  /// writes the results that differ from the last ones written
+  void final_results(const ebmc_propertiest::propertiest &);
+
+protected:
+  std::ostream &out;
+  namespacet ns;
+  std::chrono::steady_clock::time_point start;
+
+  // the status last written for each property
+  std::unordered_map<irep_idt, std::string> written;
+};
+
+#endif // CPROVER_EBMC_PROPERTY_STREAM_H
@@ -16,6 +16,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/string2int.h>
 #include <util/unicode.h>
 
+#include <trans-netlist/fst_writer.h>
+#include <trans-netlist/vcd_writer.h>
 #include <trans-word-level/instantiate_word_level.h>
 #include <trans-word-level/trans_trace_word_level.h>
 #include <trans-word-level/unwind.h>
@@ -164,9 +166,17 @@ int random_traces(const cmdlinet &cmdline, message_handlert &message_handler)
   if(cmdline.isset("vcd") && cmdline.get_value("vcd") == "-")
     throw ebmc_errort() << "no stdout output for multiple VCDs";
 
+  if(cmdline.isset("fst") && cmdline.get_value("fst") == "-")
+    throw ebmc_errort() << "no stdout output for multiple FSTs";
+
+  if(cmdline.isset("vcd") && cmdline.isset("fst"))
+    throw ebmc_errort() << "cannot do VCD and FST simultaneously";
+
   const auto outfile_prefix = [&cmdline]() -> std::optional<std::string> {
     if(cmdline.isset("vcd"))
       return cmdline.get_value("vcd") + ".";
+    else if(cmdline.isset("fst"))
+      return cmdline.get_value("fst") + ".";
     else
       return {};
   }();
@@ -177,8 +187,16 @@ int random_traces(const cmdlinet &cmdline, message_handlert &message_handler)
   if(cmdline.isset("waveform") && cmdline.isset("vcd"))
     throw ebmc_errort() << "cannot do VCD and ASCII waveform simultaneously";
 
+  if(cmdline.isset("waveform") && cmdline.isset("fst"))
+    throw ebmc_errort() << "cannot do FST and ASCII waveform simultaneously";
+
+  const namespacet ns(transition_system.symbol_table);
+
+  // the definitions are shared by all traces
+  vcd_writert vcd_writer;
+  fst_writert fst_writer;
+
   auto consumer = [&, trace_nr = 0ull](trans_tracet trace) mutable -> void {
-    namespacet ns(transition_system.symbol_table);
     if(cmdline.isset("vcd"))
     {
       PRECONDITION(outfile_prefix.has_value());
@@ -187,8 +205,17 @@ int random_traces(const cmdlinet &cmdline, message_handlert &message_handler)
 
       consolet::out() << "*** Writing " << outfile.name() << '\n';
 
-      messaget message(message_handler);
-      show_trans_trace_vcd(trace, message, ns, outfile.stream());
+      vcd_writer(trace, ns, outfile.stream());
+    }
+    else if(cmdline.isset("fst"))
+    {
+      PRECONDITION(outfile_prefix.has_value());
+      auto filename = outfile_prefix.value() + std::to_string(trace_nr + 1);
+      auto outfile = output_filet{filename};
+
+      consolet::out() << "*** Writing " << outfile.name() << '\n';
+
+      fst_writer(trace, ns, outfile.stream());
     }
     else if(cmdline.isset("waveform"))
     {
@@ -300,6 +327,17 @@ int random_trace(const cmdlinet &cmdline, message_handlert &message_handler)
       messaget message(message_handler);
       show_trans_trace_vcd(trace, message, ns, outfile.stream());
     }
+    else if(cmdline.isset("fst"))
+    {
+      auto filename = cmdline.get_value("fst");
+      auto outfile = output_filet{filename};
+
+      if(filename != "-")
+        consolet::out() << "*** Writing " << filename << '\n';
+
+      messaget message(message_handler);
+      show_trans_trace_fst(trace, message, ns, outfile.stream());
+    }
     else // default
     {
       messaget message(message_handler);
@@ -337,12 +375,15 @@ void random_traces(
 {
   std::size_t random_seed = 0;
 
+  const namespacet ns(transition_system.symbol_table);
+
+  // the VCD definitions are shared by all traces
+  vcd_writert vcd_writer;
+
   auto consumer = [&, trace_nr = 0ull](trans_tracet trace) mutable -> void {
-    namespacet ns(transition_system.symbol_table);
     auto filename = outfile_prefix + std::to_string(trace_nr + 1);
     auto outfile = output_filet{filename};
-    messaget message(message_handler);
-    show_trans_trace_vcd(trace, message, ns, outfile.stream());
+    vcd_writer(trace, ns, outfile.stream());
 
     trace_nr++;
   };
@@ -14,6 +14,9 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <util/json.h>
 #include <util/xml.h>
 
+#include <trans-netlist/fst_writer.h>
+#include <trans-netlist/vcd_writer.h>
+
 #include "ebmc_error.h"
 #include "output_file.h"
 #include "waveform.h"
@@ -22,6 +25,156 @@ Author: Daniel Kroening, dkr@amazon.com
 
 /*******************************************************************\
 
+Function: json_result
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+json_objectt json_result(
+  const ebmc_propertiest::propertyt &property,
+  const namespacet &ns)
+{
+  json_objectt json_property;
+  json_property["identifier"] = json_stringt(id2string(property.identifier));
+  json_property["status"] = json_stringt(property.status_as_string());
+
+  if(property.has_witness_trace())
+    json_property["trace"] = json(property.witness_trace.value(), ns);
+
+  if(property.is_proved() && property.proof_via.has_value())
+    json_property["proof_via"] = json_stringt{property.proof_via.value()};
+
+  return json_property;
+}
+
+/*******************************************************************\
+
+Function: output_json_string
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void output_json_string(std::ostream &out, const std::string &s)
+{
+  out << '"';
+
+  for(char c : s)
+  {
+    switch(c)
+    {
+    case '"':
+      out << "\\\"";
+      break;
+    case '\\':
+      out << "\\\\";
+      break;
+    case '\n':
+      out << "\\n";
+      break;
+    case '\r':
+      out << "\\r";
+      break;
+    case '\t':
+      out << "\\t";
+      break;
+    default:
+      if(static_cast<unsigned char>(c) < 0x20)
+      {
+        const char *hex = "0123456789abcdef";
+        out << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+      }
+      else
+        out << c;
+    }
+  }
+
+  out << '"';
+}
+
+/*******************************************************************\
+
+Function: output_json_line_rec
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void output_json_line_rec(std::ostream &out, const jsont &json)
+{
+  if(json.is_object())
+  {
+    out << '{';
+    bool first = true;
+    for(auto &entry : to_json_object(json))
+    {
+      if(!first)
+        out << ',';
+      first = false;
+      output_json_string(out, entry.first);
+      out << ':';
+      output_json_line_rec(out, entry.second);
+    }
+    out << '}';
+  }
+  else if(json.is_array())
+  {
+    out << '[';
+    bool first = true;
+    for(auto &element : to_json_array(json))
+    {
+      if(!first)
+        out << ',';
+      first = false;
+      output_json_line_rec(out, element);
+    }
+    out << ']';
+  }
+  else if(json.is_string())
+    output_json_string(out, json.value);
+  else if(json.is_number())
+    out << json.value;
+  else if(json.is_true())
+    out << "true";
+  else if(json.is_false())
+    out << "false";
+  else
+    out << "null";
+}
+
+/*******************************************************************\
+
+Function: output_json_line
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void output_json_line(std::ostream &out, const jsont &json)
+{
+  output_json_line_rec(out, json);
+  out << '\n' << std::flush;
+}
+
+/*******************************************************************\
+
 Function: ebmc_baset::report_results
 
   Inputs:
@@ -52,18 +205,7 @@ void report_results(
       if(property.is_disabled())
         continue;
 
-      json_objectt json_property;
-      json_property["identifier"] =
-        json_stringt(id2string(property.identifier));
-      json_property["status"] = json_stringt(property.status_as_string());
-
-      if(property.has_witness_trace())
-        json_property["trace"] = json(property.witness_trace.value(), ns);
-
-      if(property.is_proved() && property.proof_via.has_value())
-        json_property["proof_via"] = json_stringt{property.proof_via.value()};
-
-      json_properties.push_back(std::move(json_property));
+      json_properties.push_back(json_result(property, ns));
     }
 
     outfile.stream() << json_results;
@@ -182,6 +324,8 @@ void report_results(
       return {};
     }();
 
+    vcd_writert vcd_writer;
+
     for(const auto &property : result.properties)
     {
       if(property.has_witness_trace())
@@ -198,9 +342,27 @@ void report_results(
         auto outfile = output_filet{filename};
         std::cout << "Writing witness trace VCD file to " << filename
                   << "\n";
-        messaget message(message_handler);
-        show_trans_trace_vcd(
-          property.witness_trace.value(), message, ns, outfile.stream());
+        vcd_writer(property.witness_trace.value(), ns, outfile.stream());
+      }
+    }
+  }
+
+  if(cmdline.isset("fst"))
+  {
+    const auto outfile_prefix = cmdline.get_value("fst") + ".";
+
+    fst_writert fst_writer;
+
+    for(const auto &property : result.properties)
+    {
+      if(property.has_witness_trace())
+      {
+        std::string filename =
+          outfile_prefix + id2string(property.name) + "_witness.fst";
+        auto outfile = output_filet{filename};
+        std::cout << "Writing witness trace FST file to " << filename
+                  << "\n";
+        fst_writer(property.witness_trace.value(), ns, outfile.stream());
       }
     }
   }
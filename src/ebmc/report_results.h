@@ -12,11 +12,23 @@ Author: Daniel Kroening, dkr@amazon.com
 #ifndef EBMC_REPORT_RESULTS
 #define EBMC_REPORT_RESULTS
 
+#include <util/json.h>
+
 #include "property_checker.h"
 
+#include <iosfwd>
+
 class message_handlert;
 class namespacet;
 
+/// The identifier and status of the property, with the
+/// method of the proof and the trace, where there are these
+json_objectt
+json_result(const ebmc_propertiest::propertyt &, const namespacet &);
+
+/// Writes the JSON value on one line, followed by a newline
+void output_json_line(std::ostream &, const jsont &);
+
 void report_results(
   const cmdlinet &,
   bool show_proof_via,
@@ -77,6 +77,7 @@ property_checker_resultt tautology_check(
     if(is_tautology(property.normalized_expr, solver_factory, message_handler))
     {
       property.proved("tautology");
+      properties.result_found(property);
     }
   }
 
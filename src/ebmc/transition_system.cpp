@@ -10,6 +10,7 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include <util/cmdline.h>
 #include <util/config.h>
+#include <util/ebmc_statistics.h>
 #include <util/get_module.h>
 #include <util/message.h>
 #include <util/namespace.h>
@@ -22,6 +23,8 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <langapi/mode.h>
 #include <trans-word-level/show_module_hierarchy.h>
 #include <trans-word-level/show_modules.h>
+#include <verilog/mapped_file.h>
+#include <verilog/verilog_typecheck.h>
 #include <verilog/verilog_types.h>
 
 #include "ebmc_error.h"
@@ -30,6 +33,7 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 static void output(
   const exprt &expr,
@@ -74,6 +78,34 @@ void transition_systemt::output(std::ostream &out) const
   ::output(trans_expr.trans(), out, *language, ns);
 }
 
+/// the options of the languages given on the command line
+static optionst language_options(const cmdlinet &cmdline)
+{
+  optionst options;
+
+  // do -I
+  if(cmdline.isset('I'))
+    options.set_option("I", cmdline.get_values('I'));
+
+  options.set_option("force-systemverilog", cmdline.isset("systemverilog"));
+  options.set_option("vl2smv-extensions", cmdline.isset("vl2smv-extensions"));
+  options.set_option("warn-implicit-nets", cmdline.isset("warn-implicit-nets"));
+
+  // do -D
+  if(cmdline.isset('D'))
+    options.set_option("defines", cmdline.get_values('D'));
+
+  // do --ignore-initial
+  if(cmdline.isset("ignore-initial"))
+    options.set_option("ignore-initial", true);
+
+  // do --initial-zero
+  if(cmdline.isset("initial-zero"))
+    options.set_option("initial-zero", true);
+
+  return options;
+}
+
 int preprocess(const cmdlinet &cmdline, message_handlert &message_handler)
 {
   messaget message(message_handler);
@@ -106,19 +138,7 @@ int preprocess(const cmdlinet &cmdline, message_handlert &message_handler)
     return 1;
   }
 
-  optionst options;
-
-  // do -I
-  if(cmdline.isset('I'))
-    options.set_option("I", cmdline.get_values('I'));
-
-  options.set_option("force-systemverilog", cmdline.isset("systemverilog"));
-
-  // do -D
-  if(cmdline.isset('D'))
-    options.set_option("defines", cmdline.get_values('D'));
-
-  language->set_language_options(options, message_handler);
+  language->set_language_options(language_options(cmdline), message_handler);
 
   if(language->preprocess(infile, filename, std::cout, message_handler))
   {
@@ -129,70 +149,110 @@ int preprocess(const cmdlinet &cmdline, message_handlert &message_handler)
   return 0;
 }
 
-static bool parse(
+std::set<std::string>
+included_files(const cmdlinet &cmdline, const std::string &filename)
+{
+  std::set<std::string> result;
+
+  std::ifstream infile(widen_if_needed(filename));
+  auto language = get_language_from_filename(filename);
+
+  if(!infile || language == nullptr)
+    return result;
+
+  // errors are reported when the file is parsed
+  null_message_handlert message_handler;
+
+  language->set_language_options(language_options(cmdline), message_handler);
+
+  std::ostringstream preprocessed;
+
+  if(language->preprocess(infile, filename, preprocessed, message_handler))
+    return result;
+
+  // The preprocessor gives the files in `line directives.
+  std::istringstream lines(preprocessed.str());
+  std::string line;
+
+  while(std::getline(lines, line))
+  {
+    if(line.compare(0, 6, "`line ") != 0)
+      continue;
+
+    auto begin = line.find('"');
+    auto end = line.rfind('"');
+    if(begin == std::string::npos || end <= begin)
+      continue;
+
+    auto file = line.substr(begin + 1, end - begin - 1);
+    if(file != filename)
+      result.insert(std::move(file));
+  }
+
+  return result;
+}
+
+std::unique_ptr<languaget> parse_file(
   const cmdlinet &cmdline,
   const std::string &filename,
-  language_filest &language_files,
   message_handlert &message_handler)
 {
   messaget message(message_handler);
 
-  std::ifstream infile(widen_if_needed(filename));
+  // The file is mapped into memory, and the parser may read
+  // from it without copying.
+  mapped_filet mapped_file(filename);
+  mapped_istreamt infile(mapped_file);
 
   if(!infile)
   {
     message.error() << "failed to open input file `" << filename << "'"
                     << messaget::eom;
-    return true;
+    return nullptr;
   }
 
-  auto &lf = language_files.add_file(filename);
-  lf.filename = filename;
-  lf.language = get_language_from_filename(filename);
+  auto language_ptr = get_language_from_filename(filename);
 
-  if(lf.language == nullptr)
+  if(language_ptr == nullptr)
   {
     source_locationt location;
     location.set_file(filename);
     message.error().source_location = location;
     message.error() << "failed to figure out type of file" << messaget::eom;
-    return true;
+    return nullptr;
   }
 
-  languaget &language = *lf.language;
-
-  optionst options;
-
-  // do -I
-  if(cmdline.isset('I'))
-    options.set_option("I", cmdline.get_values('I'));
-
-  options.set_option("force-systemverilog", cmdline.isset("systemverilog"));
-  options.set_option("vl2smv-extensions", cmdline.isset("vl2smv-extensions"));
-  options.set_option("warn-implicit-nets", cmdline.isset("warn-implicit-nets"));
-
-  // do -D
-  if(cmdline.isset('D'))
-    options.set_option("defines", cmdline.get_values('D'));
-
-  // do --ignore-initial
-  if(cmdline.isset("ignore-initial"))
-    options.set_option("ignore-initial", true);
-
-  // do --initial-zero
-  if(cmdline.isset("initial-zero"))
-    options.set_option("initial-zero", true);
+  languaget &language = *language_ptr;
 
-  language.set_language_options(options, message_handler);
+  language.set_language_options(language_options(cmdline), message_handler);
 
   message.status() << "Parsing " << filename << messaget::eom;
 
+  ebmc_phaset phase("parse");
+
   if(language.parse(infile, filename, message_handler))
   {
     message.error() << "PARSING ERROR\n";
-    return true;
+    return nullptr;
   }
 
+  return language_ptr;
+}
+
+static bool parse(
+  const cmdlinet &cmdline,
+  const std::string &filename,
+  language_filest &language_files,
+  message_handlert &message_handler)
+{
+  auto language = parse_file(cmdline, filename, message_handler);
+
+  if(language == nullptr)
+    return true;
+
+  auto &lf = language_files.add_file(filename);
+  lf.filename = filename;
+  lf.language = std::move(language);
   lf.get_modules();
 
   return false;
@@ -278,10 +338,15 @@ int get_transition_system(
 
   message.status() << "Converting" << messaget::eom;
 
-  if(language_files.typecheck(transition_system.symbol_table, message_handler))
   {
-    message.error() << "CONVERSION ERROR" << messaget::eom;
-    return 2;
+    ebmc_phaset phase("convert");
+
+    if(language_files.typecheck(
+         transition_system.symbol_table, message_handler))
+    {
+      message.error() << "CONVERSION ERROR" << messaget::eom;
+      return 2;
+    }
   }
 
   if(cmdline.isset("show-modules"))
@@ -311,9 +376,7 @@ int get_transition_system(
     return 0;
   }
 
-  // get module name
-
-  if(get_main(cmdline, message_handler, transition_system))
+  if(finish_transition_system(cmdline, message_handler, transition_system))
     return 1;
 
   if(cmdline.isset("show-module-hierarchy"))
@@ -327,6 +390,23 @@ int get_transition_system(
     return 0;
   }
 
+  return -1; // done with the transition system
+}
+
+bool finish_transition_system(
+  const cmdlinet &cmdline,
+  message_handlert &message_handler,
+  transition_systemt &transition_system)
+{
+  // The module symbols keep a copy of their parse tree for
+  // instantiation, which is no longer needed.
+  verilog_release_module_sources(transition_system.symbol_table);
+
+  // get module name
+
+  if(get_main(cmdline, message_handler, transition_system))
+    return true;
+
   // --reset given?
   if(cmdline.isset("reset"))
   {
@@ -347,7 +427,7 @@ int get_transition_system(
     transition_system.trans_expr = new_trans_expr;
   }
 
-  return -1; // done with the transition system
+  return false;
 }
 
 transition_systemt get_transition_system(
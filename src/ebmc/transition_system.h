@@ -13,7 +13,11 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <util/std_expr.h>
 #include <util/symbol_table.h>
 
+#include <memory>
+#include <set>
+
 class cmdlinet;
+class languaget;
 class message_handlert;
 
 class transition_systemt
@@ -36,6 +40,23 @@ public:
 
 transition_systemt get_transition_system(const cmdlinet &, message_handlert &);
 
+/// Parses the given file, with the language given by its name and
+/// the options given on the command line. Returns nullptr on error.
+std::unique_ptr<languaget>
+parse_file(const cmdlinet &, const std::string &file_name, message_handlert &);
+
+/// The files that the preprocessor includes into the given file.
+std::set<std::string>
+included_files(const cmdlinet &, const std::string &file_name);
+
+/// Sets up the transition system of the top module, given the type
+/// checked symbol table, for --module, --top and --reset.
+/// Returns true on error.
+bool finish_transition_system(
+  const cmdlinet &,
+  message_handlert &,
+  transition_systemt &);
+
 int preprocess(const cmdlinet &, message_handlert &);
 int show_parse(const cmdlinet &, message_handlert &);
 int show_modules(const cmdlinet &, message_handlert &);
@@ -0,0 +1,643 @@
+/*******************************************************************\
+
+Module: EBMC Watch Mode
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// EBMC Watch Mode
+
+#include "watch.h"
+
+#include <util/cmdline.h>
+#include <util/ebmc_statistics.h>
+#include <util/string2int.h>
+#include <util/symbol_table.h>
+#include <util/ui_message.h>
+
+#include <langapi/language.h>
+
+#include "ebmc_error.h"
+#include "ebmc_properties.h"
+#include "instrument_buechi.h"
+#include "liveness_to_safety.h"
+#include "output_file.h"
+#include "proof_cache.h"
+#include "property_checker.h"
+#include "transition_system.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <set>
+#include <thread>
+
+#ifdef __linux__
+#  include <sys/inotify.h>
+
+#  include <poll.h>
+#  include <unistd.h>
+#endif
+
+using file_stampst =
+  std::map<std::string, std::pair<std::filesystem::file_time_type, std::uintmax_t>>;
+
+/*******************************************************************\
+
+Function: file_stamps
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: modification time and size of the given files
+
+\*******************************************************************/
+
+template <typename filest>
+static file_stampst file_stamps(const filest &files)
+{
+  file_stampst stamps;
+
+  for(auto &file : files)
+  {
+    // files that are missing have the default stamp
+    std::error_code time_error, size_error;
+    auto time = std::filesystem::last_write_time(file, time_error);
+    auto size = std::filesystem::file_size(file, size_error);
+    if(time_error || size_error)
+      stamps[file] = file_stampst::mapped_type{};
+    else
+      stamps[file] = std::pair{time, size};
+  }
+
+  return stamps;
+}
+
+/*******************************************************************\
+
+   Class: file_watchert
+
+ Purpose: Waits for changes to the directories of the given files.
+          On Linux, this uses inotify; elsewhere, or when inotify
+          is not available, the files are polled. The directories
+          are watched, as editors often replace the file.
+
+\*******************************************************************/
+
+class file_watchert
+{
+public:
+  explicit file_watchert(const std::set<std::string> &files)
+  {
+#ifdef __linux__
+    fd = inotify_init1(IN_CLOEXEC);
+    if(fd == -1)
+      return;
+
+    std::set<std::string> directories;
+    for(auto &file : files)
+    {
+      auto directory = std::filesystem::path(file).parent_path().string();
+      directories.insert(directory.empty() ? "." : directory);
+    }
+
+    const auto mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE |
+                      IN_MODIFY | IN_ATTRIB;
+
+    for(auto &directory : directories)
+      if(inotify_add_watch(fd, directory.c_str(), mask) == -1)
+      {
+        close(fd);
+        fd = -1;
+        return;
+      }
+#else
+    (void)files;
+#endif
+  }
+
+  file_watchert(const file_watchert &) = delete;
+  file_watchert &operator=(const file_watchert &) = delete;
+
+  ~file_watchert()
+  {
+#ifdef __linux__
+    if(fd != -1)
+      close(fd);
+#endif
+  }
+
+  /// Returns once there may be a change.
+  /// Without inotify, this is a sleep for the poll interval.
+  void wait()
+  {
+#ifdef __linux__
+    if(fd != -1)
+    {
+      pollfd poll_fd{fd, POLLIN, 0};
+      if(poll(&poll_fd, 1, -1) > 0)
+      {
+        // the events themselves are not needed
+        char buffer[4096];
+        [[maybe_unused]] auto bytes = read(fd, buffer, sizeof(buffer));
+      }
+      return;
+    }
+#endif
+
+    std::this_thread::sleep_for(poll_interval);
+  }
+
+  static constexpr std::chrono::milliseconds poll_interval{250};
+
+protected:
+#ifdef __linux__
+  int fd = -1;
+#endif
+};
+
+/*******************************************************************\
+
+   Class: elaboratort
+
+ Purpose: Keeps the parse trees of the files and the type checked
+          modules from one check to the next. Only the files that
+          have changed, or whose included files have changed, are
+          parsed again, and only their modules and the modules that
+          depend on these are type checked again.
+
+\*******************************************************************/
+
+class elaboratort
+{
+public:
+  elaboratort(const cmdlinet &_cmdline, message_handlert &_message_handler)
+    : cmdline(_cmdline), message_handler(_message_handler)
+  {
+  }
+
+  transition_systemt operator()();
+
+  /// the files given on the command line, and the files they include
+  std::set<std::string> watched_files() const;
+
+  /// the stamps of the watched files when they were parsed
+  file_stampst stamps() const;
+
+protected:
+  const cmdlinet &cmdline;
+  message_handlert &message_handler;
+
+  struct filet
+  {
+    // the file and the files it includes, with their stamps when
+    // the file was parsed
+    std::set<std::string> dependencies;
+    file_stampst stamps;
+    std::unique_ptr<languaget> language;
+    std::set<std::string> modules;
+  };
+
+  std::map<std::string, filet> files;
+
+  // the file of each module
+  std::map<std::string, filet *> modules;
+
+  // the modules in the symbol table, with the parse trees of the
+  // modules for instantiation
+  std::set<std::string> type_checked;
+  symbol_tablet symbol_table;
+
+  void typecheck_module(const std::string &, std::set<std::string> &);
+  void remove_module(const std::string &);
+};
+
+/*******************************************************************\
+
+Function: elaboratort::watched_files
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::set<std::string> elaboratort::watched_files() const
+{
+  std::set<std::string> result(cmdline.args.begin(), cmdline.args.end());
+
+  for(auto &[file_name, file] : files)
+    result.insert(file.dependencies.begin(), file.dependencies.end());
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: elaboratort::stamps
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+file_stampst elaboratort::stamps() const
+{
+  // files that failed to parse have no stamps yet
+  auto result = file_stamps(cmdline.args);
+
+  for(auto &[file_name, file] : files)
+    for(auto &[included, stamp] : file.stamps)
+      result[included] = stamp;
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: elaboratort::remove_module
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: removes the symbols of the module, and those of its
+          parameterized instances, from the symbol table
+
+\*******************************************************************/
+
+void elaboratort::remove_module(const std::string &module)
+{
+  auto of_module = [&module](const irep_idt &identifier)
+  {
+    const auto &id = id2string(identifier);
+    return id == module ||
+           (id.size() > module.size() &&
+            id.compare(0, module.size(), module) == 0 &&
+            (id[module.size()] == '.' || id[module.size()] == '('));
+  };
+
+  std::vector<irep_idt> identifiers;
+
+  for(const auto &[identifier, symbol] : symbol_table.symbols)
+    if(of_module(identifier) || of_module(symbol.module))
+      identifiers.push_back(identifier);
+
+  for(const auto &identifier : identifiers)
+    symbol_table.remove(identifier);
+}
+
+/*******************************************************************\
+
+Function: elaboratort::typecheck_module
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: type checks the module after the modules it depends on,
+          unless it is type checked already
+
+\*******************************************************************/
+
+void elaboratort::typecheck_module(
+  const std::string &module,
+  std::set<std::string> &in_progress)
+{
+  if(type_checked.find(module) != type_checked.end())
+    return;
+
+  if(!in_progress.insert(module).second)
+    throw ebmc_errort() << "circular dependency in " << module;
+
+  auto &language = *modules.at(module)->language;
+
+  std::set<std::string> dependencies;
+  language.dependencies(module, dependencies);
+
+  for(auto &dependency : dependencies)
+    if(modules.find(dependency) != modules.end())
+      typecheck_module(dependency, in_progress);
+
+  ebmc_statistics().count("modules elaborated");
+
+  try
+  {
+    ebmc_phaset phase("convert");
+
+    if(language.typecheck(symbol_table, module, message_handler))
+    {
+      messaget message(message_handler);
+      message.error() << "CONVERSION ERROR" << messaget::eom;
+      throw ebmc_errort().with_exit_code(2);
+    }
+  }
+  catch(...)
+  {
+    // the module is type checked again with the next check
+    remove_module(module);
+    throw;
+  }
+
+  type_checked.insert(module);
+  in_progress.erase(module);
+}
+
+/*******************************************************************\
+
+Function: elaboratort::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+transition_systemt elaboratort::operator()()
+{
+  // the modules whose files have changed
+  std::set<std::string> changed;
+
+  for(auto &file_name : cmdline.args)
+  {
+    auto &file = files[file_name];
+
+    if(
+      file.language != nullptr &&
+      file_stamps(file.dependencies) == file.stamps)
+    {
+      continue;
+    }
+
+    changed.insert(file.modules.begin(), file.modules.end());
+    file.language.reset();
+    file.modules.clear();
+
+    // the stamps are taken before parsing, to catch any later change
+    file.dependencies = included_files(cmdline, file_name);
+    file.dependencies.insert(file_name);
+    file.stamps = file_stamps(file.dependencies);
+
+    file.language = parse_file(cmdline, file_name, message_handler);
+
+    if(file.language == nullptr)
+      throw ebmc_errort().with_exit_code(1);
+
+    file.language->modules_provided(file.modules);
+    changed.insert(file.modules.begin(), file.modules.end());
+  }
+
+  modules.clear();
+
+  for(auto &[file_name, file] : files)
+    for(auto &module : file.modules)
+      if(!modules.emplace(module, &file).second)
+        throw ebmc_errort() << "duplicate definition of module " << module;
+
+  // the modules that depend on a changed module, transitively
+  bool progress = true;
+
+  while(progress)
+  {
+    progress = false;
+
+    for(auto &module : type_checked)
+    {
+      if(changed.find(module) != changed.end())
+        continue;
+
+      auto module_it = modules.find(module);
+      if(module_it == modules.end())
+        continue;
+
+      std::set<std::string> dependencies;
+      module_it->second->language->dependencies(module, dependencies);
+
+      for(auto &dependency : dependencies)
+        if(changed.find(dependency) != changed.end())
+        {
+          changed.insert(module);
+          progress = true;
+          break;
+        }
+    }
+  }
+
+  for(auto &module : changed)
+    if(type_checked.erase(module) != 0)
+      remove_module(module);
+
+  messaget message(message_handler);
+  message.status() << "Elaborating " << modules.size() - type_checked.size()
+                   << " of " << modules.size() << " modules"
+                   << messaget::eom;
+
+  std::set<std::string> in_progress;
+
+  for(auto &[module, file] : modules)
+    typecheck_module(module, in_progress);
+
+  // The transition system gets a copy, as the parse trees of the
+  // modules are released.
+  transition_systemt transition_system;
+  transition_system.symbol_table = symbol_table;
+
+  if(finish_transition_system(cmdline, message_handler, transition_system))
+    throw ebmc_errort().with_exit_code(1);
+
+  return transition_system;
+}
+
+/*******************************************************************\
+
+Function: wait_for_change
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void wait_for_change(
+  const std::set<std::string> &files,
+  file_watchert &watcher,
+  file_stampst &stamps,
+  messaget &message)
+{
+  const auto interval = file_watchert::poll_interval;
+
+  while(true)
+  {
+    // events for other files in the directories are filtered
+    // by comparing the stamps
+    watcher.wait();
+    auto new_stamps = file_stamps(files);
+    if(new_stamps == stamps)
+      continue;
+
+    // wait until the editor is done writing
+    while(true)
+    {
+      std::this_thread::sleep_for(interval);
+      auto settled_stamps = file_stamps(files);
+      if(settled_stamps == new_stamps)
+        break;
+      new_stamps = std::move(settled_stamps);
+    }
+
+    for(auto &[file, stamp] : new_stamps)
+      if(stamps[file] != stamp)
+        message.status() << "File " << file << " has changed" << messaget::eom;
+
+    stamps = std::move(new_stamps);
+    return;
+  }
+}
+
+/*******************************************************************\
+
+Function: check
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: build the design from the files, and check the properties
+
+\*******************************************************************/
+
+static void check(
+  const cmdlinet &cmdline,
+  elaboratort &elaborator,
+  proof_cachet &proof_cache,
+  std::ostream *json_lines,
+  ui_message_handlert &message_handler)
+{
+  try
+  {
+    auto transition_system = elaborator();
+
+    auto properties = ebmc_propertiest::from_command_line(
+      cmdline, transition_system, message_handler);
+
+    if(cmdline.isset("buechi"))
+      instrument_buechi(cmdline, transition_system, properties, message_handler);
+
+    if(cmdline.isset("liveness-to-safety"))
+    {
+      auto signature_bits = unsafe_string2unsigned(
+        cmdline.value_opt("loop-signature").value_or("0"));
+      liveness_to_safety(transition_system, properties, signature_bits);
+    }
+
+    property_checker(
+      cmdline,
+      transition_system,
+      properties,
+      &proof_cache,
+      json_lines,
+      message_handler);
+  }
+  // keep watching, the next change may fix the problem
+  catch(const ebmc_errort &ebmc_error)
+  {
+    if(!ebmc_error.what().empty())
+    {
+      messaget message(message_handler);
+      if(ebmc_error.location().is_not_nil())
+        message.error().source_location = ebmc_error.location();
+
+      message.error() << "error: " << messaget::red << ebmc_error.what()
+                      << messaget::reset << messaget::eom;
+    }
+  }
+  catch(const std::string &error)
+  {
+    messaget message(message_handler);
+    message.error() << "error: " << messaget::red << error << messaget::reset
+                    << messaget::eom;
+  }
+  catch(const char *error)
+  {
+    messaget message(message_handler);
+    message.error() << "error: " << messaget::red << error << messaget::reset
+                    << messaget::eom;
+  }
+  catch(const std::bad_alloc &)
+  {
+    messaget message(message_handler);
+    message.error() << "error: " << messaget::red << "out of memory"
+                    << messaget::reset << messaget::eom;
+  }
+}
+
+/*******************************************************************\
+
+Function: watch
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+int watch(const cmdlinet &cmdline, ui_message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+  // The results are kept in memory, and in the file given
+  // with --proof-cache, if any.
+  proof_cachet proof_cache{cmdline.get_value("proof-cache"), message_handler};
+
+  // The results of all checks go to one stream.
+  std::optional<output_filet> json_lines;
+  if(cmdline.isset("json-lines"))
+    json_lines.emplace(cmdline.get_value("json-lines"));
+
+  elaboratort elaborator{cmdline, message_handler};
+
+  std::set<std::string> files;
+  std::unique_ptr<file_watchert> watcher;
+
+  while(true)
+  {
+    check(
+      cmdline,
+      elaborator,
+      proof_cache,
+      json_lines.has_value() ? &json_lines->stream() : nullptr,
+      message_handler);
+
+    // the included files may have changed
+    if(!watcher || elaborator.watched_files() != files)
+    {
+      files = elaborator.watched_files();
+      watcher = std::make_unique<file_watchert>(files);
+    }
+
+    auto stamps = elaborator.stamps();
+
+    message.status() << "Watching " << files.size() << " file(s) for changes"
+                     << messaget::eom;
+
+    wait_for_change(files, *watcher, stamps, message);
+  }
+}
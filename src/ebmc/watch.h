@@ -0,0 +1,27 @@
+/*******************************************************************\
+
+Module: EBMC Watch Mode
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// EBMC Watch Mode
+
+#ifndef CPROVER_EBMC_WATCH_H
+#define CPROVER_EBMC_WATCH_H
+
+class cmdlinet;
+class ui_message_handlert;
+
+/// Checks the properties, and then checks them again whenever one of
+/// the input files, or one of the files they include, changes, until
+/// interrupted. Only the files that have changed are parsed again, and
+/// only their modules and the modules that depend on these are type
+/// checked again. Only the properties whose cone of influence has
+/// changed are given to the engine; the others keep their earlier
+/// result. Implements --watch.
+int watch(const cmdlinet &, ui_message_handlert &);
+
+#endif // CPROVER_EBMC_WATCH_H
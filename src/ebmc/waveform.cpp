@@ -16,30 +16,19 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <algorithm>
 #include <map>
-#include <unordered_set>
 
 std::vector<irep_idt>
 lhs_symbols(const trans_tracet &trace, const namespacet &ns)
 {
-  std::unordered_set<irep_idt, irep_id_hash> identifier_set;
-
-  for(auto &state : trace.states)
-    for(auto &assignment : state.assignments)
-    {
-      auto &lhs = assignment.lhs;
-      if(lhs.id() == ID_symbol)
-      {
-        auto identifier = to_symbol_expr(lhs).get_identifier();
-        auto &symbol = ns.lookup(identifier);
-        if(!symbol.is_auxiliary)
-          identifier_set.insert(identifier);
-      }
-    }
-
   std::vector<irep_idt> result;
 
-  for(auto identifier : identifier_set)
-    result.push_back(identifier);
+  for(auto &variable : trace.variables)
+  {
+    auto identifier = variable.lhs.get_identifier();
+    auto &symbol = ns.lookup(identifier);
+    if(!symbol.is_auxiliary)
+      result.push_back(identifier);
+  }
 
   return result;
 }
@@ -82,23 +71,20 @@ void show_waveform(const trans_tracet &trace, const namespacet &ns)
   std::map<std::pair<irep_idt, std::size_t>, std::string> value_map;
   std::map<std::size_t, std::size_t> column_width;
 
-  for(std::size_t timeframe = 0; timeframe < trace.states.size(); timeframe++)
+  for(std::size_t timeframe = 0; timeframe < trace.no_timeframes();
+      timeframe++)
   {
-    auto &state = trace.states[timeframe];
-    for(auto &assignment : state.assignments)
+    for(std::size_t v = 0; v < trace.variables.size(); v++)
     {
-      auto &lhs = assignment.lhs;
-      if(lhs.id() == ID_symbol)
+      auto identifier = trace.variables[v].lhs.get_identifier();
+      auto value = trace.get_value(v, timeframe);
+      if(value.is_not_nil())
       {
-        auto identifier = to_symbol_expr(lhs).get_identifier();
-        if(assignment.rhs.is_not_nil())
-        {
-          auto as_string = from_expr(ns, identifier, assignment.rhs);
-          value_map[std::make_pair(identifier, timeframe)] = as_string;
-          auto &width = column_width[timeframe];
-          width = std::max(width, as_string.size());
-          width = std::max(width, std::size_t(2));
-        }
+        auto as_string = from_expr(ns, identifier, value);
+        value_map[std::make_pair(identifier, timeframe)] = as_string;
+        auto &width = column_width[timeframe];
+        width = std::max(width, as_string.size());
+        width = std::max(width, std::size_t(2));
       }
     }
   }
@@ -110,7 +96,7 @@ void show_waveform(const trans_tracet &trace, const namespacet &ns)
     consolet::out().width(y_label_width);
     consolet::out() << "";
 
-    for(std::size_t x = 0; x < trace.states.size(); x++)
+    for(std::size_t x = 0; x < trace.no_timeframes(); x++)
     {
       consolet::out() << ' ';
       if(consolet::is_terminal() && consolet::use_SGR())
@@ -135,7 +121,7 @@ void show_waveform(const trans_tracet &trace, const namespacet &ns)
     consolet::out() << symbol.display_name();
     consolet::out() << consolet::reset;
 
-    for(std::size_t x = 0; x < trace.states.size(); x++)
+    for(std::size_t x = 0; x < trace.no_timeframes(); x++)
     {
       consolet::out() << ' ';
       if(consolet::is_terminal() && consolet::use_SGR())
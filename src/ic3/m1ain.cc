@@ -9,6 +9,7 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 // clang-format off
 // The order of these matter.
 #include <util/cmdline.h>
+#include <util/ebmc_limits.h>
 #include <util/ui_message.h>
 
 #include <ebmc/liveness_to_safety.h>
@@ -95,6 +96,11 @@ property_checker_resultt ic3_enginet::operator()()
     netlist = make_netlist(transition_system, properties,
       message.get_message_handler());
 
+    if(cmdline.isset("memory-diet"))
+      netlist_memory_diet(transition_system);
+
+    simplify_netlist(netlist, cmdline, message.get_message_handler());
+
     message.statistics() << "Latches: " << netlist.var_map.latches.size()
                          << ", nodes: " << netlist.number_of_nodes()
                          << messaget::eom;
@@ -150,7 +156,9 @@ property_checker_resultt ic3_enginet::operator()()
     }
     
     //  printf("Constr_gates.size() = %d\n",Ci.Constr_gates.size()); 
+    ebmc_property_clockt property_clock;
     int result = Ci.run_ic3();
+    auto limit_reason = ebmc_limits().exceeded();
 
     // find the first unknown property
     for(auto &property : properties.properties)
@@ -161,8 +169,18 @@ property_checker_resultt ic3_enginet::operator()()
         {
         case 1: property.refuted(); break;
         case 2: property.proved(); break;
+        case 3:
+          // undecided, as a limit was hit
+          if (limit_reason.has_value()) {
+            property.inconclusive(*limit_reason + " at frame " +
+                                  std::to_string(Ci.tf_lind));
+            break;
+          }
+          property.failure();
+          break;
         default: property.failure(); break;
         }
+        properties.result_found(property);
         break;
       }
     }
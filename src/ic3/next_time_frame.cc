@@ -11,6 +11,7 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 #include <set>
 #include <map>
 #include <algorithm>
+#include <util/ebmc_limits.h>
 #include "minisat/core/Solver.h"
 #include "minisat/simp/SimpSolver.h"
 #include "dnf_io.hh"
@@ -123,6 +124,8 @@ int CompInfo::next_time_frame()
   ==========================================*/
 bool CompInfo::time_to_terminate() {
   excl_st_count++;
+  // --timeout, --per-property-timeout, --memout
+  if (ebmc_limits().poll().has_value()) return(true);
   if (time_limit > 0) {
     double usrtime,systime;
     get_runtime (usrtime, systime);
@@ -13,8 +13,11 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include <ebmc/ebmc_error.h>
 
+#include <algorithm>
 #include <ostream>
+#include <set>
 #include <sstream>
+#include <tuple>
 
 class hoa_tokenizert
 {
@@ -580,3 +583,179 @@ void hoat::buechi_acceptance_cleanup()
     }
   }
 }
+
+std::vector<hoat::intt> hoat::start_states() const
+{
+  std::vector<intt> result;
+
+  for(auto &item : header)
+    if(item.first == "Start:")
+      for(auto &value : item.second)
+        if(value != "&")
+          result.push_back(safe_string2unsigned(value));
+
+  return result;
+}
+
+void hoat::renumber_states(const std::map<intt, intt> &state_map)
+{
+  auto new_number = [&state_map](intt number)
+  {
+    auto it = state_map.find(number);
+    PRECONDITION(it != state_map.end());
+    return it->second;
+  };
+
+  bodyt new_body;
+  std::set<intt> done;
+
+  for(auto &state : body)
+  {
+    if(state_map.find(state.first.number) == state_map.end())
+      continue; // dropped
+
+    auto number = new_number(state.first.number);
+    if(!done.insert(number).second)
+      continue; // merged into an earlier state
+
+    new_body.push_back(state);
+    new_body.back().first.number = number;
+
+    // renumber the destinations, and drop edges that are now duplicates
+    auto &edges = new_body.back().second;
+    for(auto edge_it = edges.begin(); edge_it != edges.end();)
+    {
+      for(auto &dest : edge_it->dest_states)
+        dest = new_number(dest);
+
+      bool duplicate = false;
+      for(auto other_it = edges.begin(); other_it != edge_it; other_it++)
+        if(
+          other_it->label == edge_it->label &&
+          other_it->dest_states == edge_it->dest_states &&
+          other_it->acc_sig == edge_it->acc_sig)
+        {
+          duplicate = true;
+        }
+
+      if(duplicate)
+        edge_it = edges.erase(edge_it);
+      else
+        edge_it++;
+    }
+  }
+
+  std::sort(
+    new_body.begin(),
+    new_body.end(),
+    [](const bodyt::value_type &a, const bodyt::value_type &b)
+    { return a.first.number < b.first.number; });
+
+  body = std::move(new_body);
+
+  for(auto &item : header)
+  {
+    if(item.first == "Start:")
+    {
+      for(auto &value : item.second)
+        if(value != "&")
+          value = std::to_string(new_number(safe_string2unsigned(value)));
+    }
+    else if(item.first == "States:")
+    {
+      item.second = {std::to_string(body.size())};
+    }
+  }
+}
+
+void hoat::remove_unreachable_states()
+{
+  std::map<intt, const edgest *> edges_map;
+  for(auto &state : body)
+    edges_map[state.first.number] = &state.second;
+
+  std::set<intt> reachable;
+  std::vector<intt> queue = start_states();
+
+  while(!queue.empty())
+  {
+    auto number = queue.back();
+    queue.pop_back();
+
+    if(!reachable.insert(number).second)
+      continue;
+
+    auto edges_it = edges_map.find(number);
+    if(edges_it == edges_map.end())
+      continue;
+
+    for(auto &edge : *edges_it->second)
+      for(auto &dest : edge.dest_states)
+        queue.push_back(dest);
+  }
+
+  // number the reachable states in the order of the body
+  std::map<intt, intt> state_map;
+  for(auto &state : body)
+    if(reachable.find(state.first.number) != reachable.end())
+      state_map.emplace(state.first.number, state_map.size());
+
+  renumber_states(state_map);
+}
+
+void hoat::merge_equivalent_states()
+{
+  // Partition refinement: two states stay in the same class while
+  // they are in the same class, have the same acceptance sets and
+  // in-state labels, and have the same edges to the same classes.
+  std::map<intt, intt> state_class;
+  for(auto &state : body)
+    state_class[state.first.number] = 0;
+
+  std::size_t number_of_classes = 1;
+
+  while(true)
+  {
+    using edge_signaturet = std::tuple<labelt, std::vector<intt>, acc_sigt>;
+    using signaturet =
+      std::tuple<intt, acc_sigt, labelt, std::vector<edge_signaturet>>;
+
+    std::map<signaturet, intt> signature_map;
+    std::map<intt, intt> new_state_class;
+
+    for(auto &state : body)
+    {
+      std::vector<edge_signaturet> edges;
+      for(auto &edge : state.second)
+      {
+        std::vector<intt> dest_classes;
+        for(auto &dest : edge.dest_states)
+          dest_classes.push_back(state_class.at(dest));
+        edges.emplace_back(edge.label, dest_classes, edge.acc_sig);
+      }
+
+      std::sort(edges.begin(), edges.end());
+      edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+      signaturet signature{
+        state_class.at(state.first.number),
+        state.first.acc_sig,
+        state.first.label,
+        std::move(edges)};
+
+      auto new_class = signature_map
+                         .emplace(std::move(signature), signature_map.size())
+                         .first->second;
+      new_state_class[state.first.number] = new_class;
+    }
+
+    state_class = std::move(new_state_class);
+
+    if(signature_map.size() == number_of_classes)
+      break;
+
+    number_of_classes = signature_map.size();
+  }
+
+  renumber_states(state_class);
+}
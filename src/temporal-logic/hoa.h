@@ -16,6 +16,7 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 // https://adl.github.io/hoaf/hoaf.pdf
 class hoat
@@ -82,6 +83,24 @@ public:
   // These are irrelevant when using the standard Buechi
   // acceptance criterion.
   void buechi_acceptance_cleanup();
+
+  // The numbers of the start states, as given by the header.
+  std::vector<intt> start_states() const;
+
+  // Remove the states that are not reachable from a start state,
+  // and number the remaining states consecutively.
+  void remove_unreachable_states();
+
+  // Merge the states that have the same acceptance sets and the
+  // same edges, up to the merging of the destination states.
+  // The merged automaton accepts the same language.
+  void merge_equivalent_states();
+
+protected:
+  // Renumber the states as given by the map, dropping the states that
+  // are not in the map, and merging the states with the same number.
+  // The edges of the first of the merged states are kept.
+  void renumber_states(const std::map<intt, intt> &);
 };
 
 #endif // CPROVER_TEMPORAL_LOGIC_HOA_H
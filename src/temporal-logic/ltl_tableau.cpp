@@ -0,0 +1,617 @@
+/*******************************************************************\
+
+Module: LTL to Buechi Translation via Tableau
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// LTL to Buechi Translation via Tableau
+
+#include "ltl_tableau.h"
+
+#include <verilog/sva_expr.h>
+
+#include "ltl.h"
+#include "nnf.h"
+#include "temporal_logic.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+// The formulas in the tableau use true, false, literals, and, or,
+// X, U and R only. The constructors below apply simple rewrites.
+
+static exprt make_junction(irep_idt id, const exprt::operandst &operands)
+{
+  // the neutral and the absorbing element
+  const bool neutral = id == ID_and;
+
+  exprt::operandst result;
+
+  for(auto &op : operands)
+  {
+    if(op.id() == id)
+    {
+      for(auto &sub_op : op.operands())
+        result.push_back(sub_op);
+    }
+    else if(op.is_constant() && op.is_true() == neutral)
+    {
+      // drop
+    }
+    else if(op.is_constant())
+      return op;
+    else
+      result.push_back(op);
+  }
+
+  // remove duplicates
+  std::set<exprt> seen;
+  exprt::operandst unique;
+  for(auto &op : result)
+    if(seen.insert(op).second)
+      unique.push_back(op);
+
+  if(unique.empty())
+    return neutral ? exprt{true_exprt{}} : exprt{false_exprt{}};
+  else if(unique.size() == 1)
+    return unique.front();
+  else if(id == ID_and)
+    return and_exprt{std::move(unique)};
+  else
+    return or_exprt{std::move(unique)};
+}
+
+static exprt make_X(exprt op)
+{
+  // X true = true, X false = false
+  if(op.is_constant())
+    return op;
+  return X_exprt{std::move(op)};
+}
+
+static exprt make_U(exprt lhs, exprt rhs)
+{
+  // φ U true = true, φ U false = false, false U ψ = ψ
+  if(rhs.is_constant() || lhs.is_false())
+    return rhs;
+
+  // F F ψ = F ψ
+  if(lhs.is_true() && rhs.id() == ID_U && to_U_expr(rhs).lhs().is_true())
+    return rhs;
+
+  return U_exprt{std::move(lhs), std::move(rhs)};
+}
+
+static exprt make_R(exprt lhs, exprt rhs)
+{
+  // φ R true = true, φ R false = false, true R ψ = ψ
+  if(rhs.is_constant() || lhs.is_true())
+    return rhs;
+
+  // G G ψ = G ψ
+  if(lhs.is_false() && rhs.id() == ID_R && to_R_expr(rhs).lhs().is_false())
+    return rhs;
+
+  return R_exprt{std::move(lhs), std::move(rhs)};
+}
+
+/// Maps an LTL formula in negation normal form onto the operators
+/// above, or returns {} when this is not possible.
+static std::optional<exprt> core(const exprt &expr)
+{
+  auto core_binary =
+    [](const exprt &expr) -> std::optional<std::pair<exprt, exprt>>
+  {
+    auto &binary_expr = to_binary_expr(expr);
+    auto lhs = core(binary_expr.lhs());
+    auto rhs = core(binary_expr.rhs());
+    if(!lhs.has_value() || !rhs.has_value())
+      return {};
+    return std::pair{std::move(*lhs), std::move(*rhs)};
+  };
+
+  if(expr.is_true())
+    return exprt{true_exprt{}};
+  else if(expr.is_false())
+    return exprt{false_exprt{}};
+  else if(
+    expr.id() == ID_and || expr.id() == ID_or || expr.id() == ID_sva_and ||
+    expr.id() == ID_sva_or)
+  {
+    exprt::operandst operands;
+    for(auto &op : expr.operands())
+    {
+      auto op_core = core(op);
+      if(!op_core.has_value())
+        return {};
+      operands.push_back(std::move(*op_core));
+    }
+    return make_junction(
+      expr.id() == ID_and || expr.id() == ID_sva_and ? ID_and : ID_or,
+      operands);
+  }
+  else if(!has_temporal_operator(expr))
+  {
+    // an atomic proposition, or its negation
+    return expr;
+  }
+  else if(expr.id() == ID_sva_boolean)
+  {
+    return core(to_sva_boolean_expr(expr).op());
+  }
+  else if(
+    expr.id() == ID_X || expr.id() == ID_sva_nexttime ||
+    expr.id() == ID_sva_s_nexttime)
+  {
+    auto op = core(to_unary_expr(expr).op());
+    if(!op.has_value())
+      return {};
+    return make_X(std::move(*op));
+  }
+  else if(expr.id() == ID_F || expr.id() == ID_sva_s_eventually)
+  {
+    // F φ = true U φ
+    auto op = core(to_unary_expr(expr).op());
+    if(!op.has_value())
+      return {};
+    return make_U(true_exprt{}, std::move(*op));
+  }
+  else if(expr.id() == ID_G || expr.id() == ID_sva_always)
+  {
+    // G φ = false R φ
+    auto op = core(to_unary_expr(expr).op());
+    if(!op.has_value())
+      return {};
+    return make_R(false_exprt{}, std::move(*op));
+  }
+  else if(expr.id() == ID_U || expr.id() == ID_sva_s_until)
+  {
+    auto ops = core_binary(expr);
+    if(!ops.has_value())
+      return {};
+    return make_U(ops->first, ops->second);
+  }
+  else if(expr.id() == ID_R)
+  {
+    auto ops = core_binary(expr);
+    if(!ops.has_value())
+      return {};
+    return make_R(ops->first, ops->second);
+  }
+  else if(expr.id() == ID_weak_U || expr.id() == ID_sva_until)
+  {
+    // φ W ψ = ψ R (φ ∨ ψ)
+    auto ops = core_binary(expr);
+    if(!ops.has_value())
+      return {};
+    return make_R(
+      ops->second, make_junction(ID_or, {ops->first, ops->second}));
+  }
+  else if(expr.id() == ID_strong_R)
+  {
+    // φ M ψ = ψ U (φ ∧ ψ)
+    auto ops = core_binary(expr);
+    if(!ops.has_value())
+      return {};
+    return make_U(
+      ops->second, make_junction(ID_and, {ops->first, ops->second}));
+  }
+  else if(expr.id() == ID_sva_until_with)
+  {
+    // φ until_with ψ = ψ R φ
+    auto ops = core_binary(expr);
+    if(!ops.has_value())
+      return {};
+    return make_R(ops->second, ops->first);
+  }
+  else if(expr.id() == ID_sva_s_until_with)
+  {
+    // φ s_until_with ψ = ψ M φ = φ U (ψ ∧ φ)
+    auto ops = core_binary(expr);
+    if(!ops.has_value())
+      return {};
+    return make_U(
+      ops->first, make_junction(ID_and, {ops->second, ops->first}));
+  }
+  else
+    return {};
+}
+
+/*******************************************************************\
+
+   Class: ltl_tableaut
+
+ Purpose:
+
+\*******************************************************************/
+
+class ltl_tableaut
+{
+public:
+  explicit ltl_tableaut(numberingt<exprt, irep_hash> &_atoms) : atoms(_atoms)
+  {
+  }
+
+  hoat operator()(const exprt &);
+
+protected:
+  numberingt<exprt, irep_hash> &atoms;
+
+  using formulast = std::set<exprt>;
+
+  // the literals, by number of the atom
+  using literalst = std::map<std::size_t, bool>;
+
+  // one way of satisfying a set of formulas in one step
+  struct covert
+  {
+    literalst literals;
+    formulast next;
+    // the U formulas whose right-hand side is postponed
+    formulast pending;
+  };
+
+  // the U subformulas, one acceptance condition each
+  std::vector<exprt> untils;
+
+  void collect_untils(const exprt &);
+
+  void expand(
+    std::vector<exprt> todo,
+    covert,
+    formulast done,
+    std::vector<covert> &dest);
+
+  static hoat::labelt label(const literalst &);
+};
+
+/*******************************************************************\
+
+Function: ltl_tableaut::collect_untils
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ltl_tableaut::collect_untils(const exprt &formula)
+{
+  std::set<exprt> seen;
+
+  formula.visit_pre(
+    [this, &seen](const exprt &expr)
+    {
+      if(expr.id() == ID_U && seen.insert(expr).second)
+        untils.push_back(expr);
+    });
+}
+
+/*******************************************************************\
+
+Function: ltl_tableaut::expand
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Compute the covers of the given formulas, i.e., the ways
+          of satisfying them in the current step
+
+\*******************************************************************/
+
+void ltl_tableaut::expand(
+  std::vector<exprt> todo,
+  covert cover,
+  formulast done,
+  std::vector<covert> &dest)
+{
+  while(!todo.empty())
+  {
+    exprt f = std::move(todo.back());
+    todo.pop_back();
+
+    if(!done.insert(f).second)
+      continue;
+
+    if(f.is_true())
+    {
+    }
+    else if(f.is_false())
+    {
+      return; // no cover
+    }
+    else if(f.id() == ID_and)
+    {
+      for(auto &op : f.operands())
+        todo.push_back(op);
+    }
+    else if(f.id() == ID_or)
+    {
+      for(auto &op : f.operands())
+      {
+        auto todo_op = todo;
+        todo_op.push_back(op);
+        expand(std::move(todo_op), cover, done, dest);
+      }
+      return;
+    }
+    else if(f.id() == ID_X)
+    {
+      cover.next.insert(to_X_expr(f).op());
+    }
+    else if(f.id() == ID_U)
+    {
+      // φ U ψ = ψ ∨ (φ ∧ X(φ U ψ))
+      auto &U = to_U_expr(f);
+      auto todo_now = todo;
+      todo_now.push_back(U.rhs());
+      expand(std::move(todo_now), cover, done, dest);
+
+      todo.push_back(U.lhs());
+      cover.next.insert(f);
+      cover.pending.insert(f);
+    }
+    else if(f.id() == ID_R)
+    {
+      // φ R ψ = ψ ∧ (φ ∨ X(φ R ψ))
+      auto &R = to_R_expr(f);
+      auto todo_now = todo;
+      todo_now.push_back(R.lhs());
+      todo_now.push_back(R.rhs());
+      expand(std::move(todo_now), cover, done, dest);
+
+      todo.push_back(R.rhs());
+      cover.next.insert(f);
+    }
+    else
+    {
+      // a literal
+      const bool polarity = f.id() != ID_not;
+      auto &atom = polarity ? f : to_not_expr(f).op();
+      auto number = atoms.number(atom);
+      auto insert_result = cover.literals.emplace(number, polarity);
+      if(insert_result.first->second != polarity)
+        return; // contradiction
+    }
+  }
+
+  dest.push_back(std::move(cover));
+}
+
+/*******************************************************************\
+
+Function: ltl_tableaut::label
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the HOA label for the conjunction of the literals
+
+\*******************************************************************/
+
+hoat::labelt ltl_tableaut::label(const literalst &literals)
+{
+  if(literals.empty())
+    return hoat::labelt{"t"};
+
+  std::optional<hoat::labelt> result;
+
+  for(auto &[number, polarity] : literals)
+  {
+    hoat::labelt literal{std::to_string(number)};
+
+    if(!polarity)
+    {
+      hoat::labelt negation{"!"};
+      negation.get_sub().push_back(std::move(literal));
+      literal = std::move(negation);
+    }
+
+    if(result.has_value())
+    {
+      hoat::labelt conjunction{"&"};
+      conjunction.get_sub().push_back(std::move(*result));
+      conjunction.get_sub().push_back(std::move(literal));
+      result = std::move(conjunction);
+    }
+    else
+      result = std::move(literal);
+  }
+
+  return *result;
+}
+
+/*******************************************************************\
+
+Function: ltl_tableaut::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+hoat ltl_tableaut::operator()(const exprt &formula)
+{
+  collect_untils(formula);
+
+  const std::size_t number_of_untils = untils.size();
+
+  // The states are the formulas to satisfy from now on, and the
+  // level of the degeneralization. The states on the last level
+  // are accepting.
+  using statet = std::pair<formulast, std::size_t>;
+  std::map<statet, hoat::intt> state_numbers;
+  std::vector<statet> queue;
+
+  auto state_number = [&](statet state) -> hoat::intt
+  {
+    auto result = state_numbers.emplace(state, state_numbers.size());
+    if(result.second)
+      queue.push_back(std::move(state));
+    return result.first->second;
+  };
+
+  state_number({{formula}, 0});
+
+  hoat::bodyt body;
+  std::optional<hoat::intt> sink;
+
+  for(std::size_t index = 0; index < queue.size(); index++)
+  {
+    // copy, the queue grows
+    const statet state = queue[index];
+    const auto &[formulas, level] = state;
+
+    hoat::state_namet state_name;
+    state_name.number = index;
+    if(level == number_of_untils)
+      state_name.acc_sig = {"0"};
+
+    std::vector<covert> covers;
+    expand(
+      std::vector<exprt>(formulas.begin(), formulas.end()), {}, {}, covers);
+
+    // the literals of the covers, per successor state
+    std::map<hoat::intt, std::set<literalst>> successors;
+
+    for(auto &cover : covers)
+    {
+      // advance the level past the acceptance conditions
+      // that this step satisfies
+      std::size_t next_level = level == number_of_untils ? 0 : level;
+      while(next_level < number_of_untils &&
+            cover.pending.find(untils[next_level]) == cover.pending.end())
+      {
+        next_level++;
+      }
+
+      auto successor = state_number({cover.next, next_level});
+      successors[successor].insert(cover.literals);
+    }
+
+    hoat::edgest edges;
+    std::vector<hoat::labelt> labels;
+    bool complete = false;
+
+    for(auto &[successor, literal_sets] : successors)
+    {
+      std::optional<hoat::labelt> edge_label;
+
+      for(auto &literals : literal_sets)
+      {
+        // skip when implied by another cover with the same successor
+        bool subsumed = false;
+        for(auto &other : literal_sets)
+        {
+          if(
+            &other != &literals && other.size() < literals.size() &&
+            std::includes(
+              literals.begin(), literals.end(), other.begin(), other.end()))
+          {
+            subsumed = true;
+            break;
+          }
+        }
+
+        if(subsumed)
+          continue;
+
+        if(literals.empty())
+          complete = true;
+
+        if(edge_label.has_value())
+        {
+          hoat::labelt disjunction{"|"};
+          disjunction.get_sub().push_back(std::move(*edge_label));
+          disjunction.get_sub().push_back(label(literals));
+          edge_label = std::move(disjunction);
+        }
+        else
+          edge_label = label(literals);
+      }
+
+      labels.push_back(*edge_label);
+      edges.push_back(hoat::edget{*edge_label, {successor}, {}});
+    }
+
+    // complete the automaton with a nonaccepting sink
+    if(!complete)
+    {
+      // the sink is on a level of its own, and thus nonaccepting
+      if(!sink.has_value())
+        sink = state_number({{false_exprt{}}, number_of_untils + 1});
+
+      hoat::labelt otherwise{"t"};
+
+      for(auto &l : labels)
+      {
+        hoat::labelt negation{"!"};
+        negation.get_sub().push_back(l);
+
+        if(otherwise.id() == "t")
+          otherwise = std::move(negation);
+        else
+        {
+          hoat::labelt conjunction{"&"};
+          conjunction.get_sub().push_back(std::move(otherwise));
+          conjunction.get_sub().push_back(std::move(negation));
+          otherwise = std::move(conjunction);
+        }
+      }
+
+      edges.push_back(hoat::edget{std::move(otherwise), {*sink}, {}});
+    }
+
+    body.emplace_back(std::move(state_name), std::move(edges));
+  }
+
+  hoat::headert header;
+  header.push_back({"HOA:", {"v1"}});
+  header.push_back({"States:", {std::to_string(body.size())}});
+  header.push_back({"Start:", {"0"}});
+
+  std::list<std::string> ap = {std::to_string(atoms.size())};
+  for(std::size_t number = 0; number < atoms.size(); number++)
+    ap.push_back("\"a" + std::to_string(number) + '"');
+  header.push_back({"AP:", std::move(ap)});
+
+  header.push_back({"acc-name:", {"Buchi"}});
+  header.push_back({"Acceptance:", {"1", "Inf(0)"}});
+  header.push_back({"properties:", {"state-acc", "complete"}});
+
+  return hoat{std::move(header), std::move(body)};
+}
+
+/*******************************************************************\
+
+Function: ltl_tableau
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::optional<hoat>
+ltl_tableau(const exprt &formula, numberingt<exprt, irep_hash> &atoms)
+{
+  auto formula_core = core(property_nnf(formula));
+
+  if(!formula_core.has_value())
+    return {};
+
+  return ltl_tableaut{atoms}(*formula_core);
+}
@@ -0,0 +1,33 @@
+/*******************************************************************\
+
+Module: LTL to Buechi Translation via Tableau
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// LTL to Buechi Translation via Tableau
+
+#ifndef CPROVER_TEMPORAL_LOGIC_LTL_TABLEAU_H
+#define CPROVER_TEMPORAL_LOGIC_LTL_TABLEAU_H
+
+#include <util/numbering.h>
+#include <util/std_expr.h>
+
+#include "hoa.h"
+
+#include <optional>
+
+/// Translates an LTL formula into a complete state-based Buechi
+/// automaton, in the form that Spot's ltl2tgba --sba --complete
+/// produces. The formula is taken to negation normal form, and is
+/// expanded into a generalized Buechi automaton with one acceptance
+/// condition per U subformula, which is then degeneralized.
+/// The atomic propositions are the non-temporal subformulas; the
+/// labels of the automaton give their numbers in the given numbering.
+/// Returns {} when the formula is not LTL, e.g., uses SVA sequences.
+std::optional<hoat>
+ltl_tableau(const exprt &, numberingt<exprt, irep_hash> &atoms);
+
+#endif // CPROVER_TEMPORAL_LOGIC_LTL_TABLEAU_H
@@ -9,6 +9,9 @@ Author: Daniel Kroening, dkr@amazon.com
 #include "ltl_to_buechi.h"
 
 #include <util/arith_tools.h>
+#include <util/bitvector_expr.h>
+#include <util/bitvector_types.h>
+#include <util/ebmc_statistics.h>
 #include <util/expr_util.h>
 #include <util/format_expr.h>
 #include <util/message.h>
@@ -16,14 +19,19 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <util/run.h>
 #include <util/std_expr.h>
 #include <util/std_types.h>
+#include <util/string2int.h>
 
 #include <ebmc/ebmc_error.h>
 #include <trans-word-level/next_symbol.h>
 
 #include "hoa.h"
 #include "ltl_sva_to_string.h"
+#include "ltl_tableau.h"
+#include "temporal_logic.h"
 
+#include <functional>
 #include <sstream>
+#include <unordered_map>
 
 void buechi_transt::rename_state_symbol(const symbol_exprt &new_state_symbol)
 {
@@ -46,12 +54,12 @@ void buechi_transt::rename_state_symbol(const symbol_exprt &new_state_symbol)
 
 exprt hoa_label_to_expr(
   const hoat::labelt &label,
-  const ltl_sva_to_stringt &ltl_sva_to_string)
+  const std::vector<exprt> &atoms)
 {
   std::vector<exprt> operands;
   operands.reserve(label.get_sub().size());
   for(auto &sub : label.get_sub())
-    operands.push_back(hoa_label_to_expr(sub, ltl_sva_to_string));
+    operands.push_back(hoa_label_to_expr(sub, atoms));
 
   if(label.id() == "t")
   {
@@ -79,10 +87,109 @@ exprt hoa_label_to_expr(
   else
   {
     // atomic proposition, given as number
-    return ltl_sva_to_string.atom(label.id_string());
+    auto number = safe_string2size_t(label.id_string());
+    PRECONDITION(number < atoms.size());
+    return atoms[number];
   }
 }
 
+/// Renumbers the atomic propositions in the labels of the automaton.
+/// Returns false if an atomic proposition has no new number.
+static bool relabel(
+  hoat::labelt &label,
+  const std::function<std::optional<std::size_t>(const std::string &)>
+    &renumber)
+{
+  if(
+    label.id() == "t" || label.id() == "f" || label.id() == "|" ||
+    label.id() == "&" || label.id() == "!")
+  {
+    for(auto &sub : label.get_sub())
+      if(!relabel(sub, renumber))
+        return false;
+    return true;
+  }
+  else
+  {
+    auto number = renumber(label.id_string());
+    if(!number.has_value())
+      return false;
+    label.id(std::to_string(*number));
+    return true;
+  }
+}
+
+static bool relabel(
+  hoat &hoa,
+  const std::function<std::optional<std::size_t>(const std::string &)>
+    &renumber)
+{
+  for(auto &state : hoa.body)
+    for(auto &edge : state.second)
+      if(!relabel(edge.label, renumber))
+        return false;
+
+  return true;
+}
+
+/// The skeleton of a formula: the maximal non-temporal subformulas,
+/// up to negation, are replaced by the atomic propositions
+/// buechi::ap0, buechi::ap1, ..., numbered in the order of their
+/// first occurrence. Formulas that only differ in their atomic
+/// propositions have the same skeleton.
+class ltl_skeletont
+{
+public:
+  explicit ltl_skeletont(const exprt &formula) : skeleton(rec(formula))
+  {
+  }
+
+  exprt skeleton;
+
+  // the atomic propositions of the formula, by number
+  std::vector<exprt> atoms;
+
+  // the number of the given atomic proposition of the skeleton
+  std::optional<std::size_t> number(const exprt &ap) const
+  {
+    auto it = numbers.find(ap);
+    if(it == numbers.end())
+      return {};
+    else
+      return it->second;
+  }
+
+protected:
+  std::unordered_map<exprt, std::size_t, irep_hash> numbers, atom_numbers;
+
+  exprt rec(const exprt &expr)
+  {
+    if(has_temporal_operator(expr))
+    {
+      exprt result = expr;
+      for(auto &op : result.operands())
+        op = rec(op);
+      return result;
+    }
+    else if(expr.is_constant() || expr.type().id() != ID_bool)
+      return expr;
+    else if(expr.id() == ID_not)
+      return not_exprt{rec(to_not_expr(expr).op())};
+    else
+    {
+      auto insert_result = atom_numbers.emplace(expr, atoms.size());
+      auto number = insert_result.first->second;
+
+      if(insert_result.second)
+        atoms.push_back(expr);
+
+      symbol_exprt ap{"buechi::ap" + std::to_string(number), bool_typet{}};
+      numbers.emplace(ap, number);
+      return std::move(ap);
+    }
+  }
+};
+
 // a nonaccepting state with an unconditional self-loop
 bool is_error_state(const std::pair<hoat::state_namet, hoat::edgest> &state)
 {
@@ -111,15 +218,17 @@ bool is_safety_only(const hoat &hoa)
   return true;
 }
 
-buechi_transt
-ltl_to_buechi(const exprt &property, message_handlert &message_handler)
+/// Runs Spot's ltl2tgba on the skeleton
+static hoat spot_translation(
+  const ltl_skeletont &skeleton,
+  message_handlert &message_handler)
 {
   ltl_sva_to_stringt ltl_sva_to_string;
 
   try
   {
     // Turn the skeleton of the property into a string
-    auto string = ltl_sva_to_string(property);
+    auto string = ltl_sva_to_string(skeleton.skeleton);
 
     // Run Spot's ltl2tgba
     std::ostringstream hoa_stream;
@@ -144,126 +253,393 @@ ltl_to_buechi(const exprt &property, message_handlert &message_handler)
 
     auto hoa = hoat::from_string(hoa_stream.str());
 
-    message.debug() << hoa << messaget::eom;
+    // use the numbers of the atomic propositions of the skeleton
+    bool relabeled = relabel(
+      hoa,
+      [&ltl_sva_to_string, &skeleton](const std::string &label)
+      { return skeleton.number(ltl_sva_to_string.atom(label)); });
 
-    // clean up accepting states
-    hoa.buechi_acceptance_cleanup();
+    if(!relabeled)
+      throw ebmc_errort{} << "unexpected atomic proposition from ltl2tgba";
+
+    return hoa;
+  }
+  catch(ltl_sva_to_string_unsupportedt error)
+  {
+    throw ebmc_errort{} << "failed to convert " << error.expr.id();
+  }
+}
+
+/// Translates the skeleton in-process, or returns {} when the
+/// formula is outside of the supported fragment
+static std::optional<hoat> internal_translation(const ltl_skeletont &skeleton)
+{
+  numberingt<exprt, irep_hash> tableau_atoms;
+  auto hoa = ltl_tableau(skeleton.skeleton, tableau_atoms);
+
+  if(!hoa.has_value())
+    return {};
+
+  // use the numbers of the atomic propositions of the skeleton
+  bool relabeled = relabel(
+    *hoa,
+    [&tableau_atoms, &skeleton](const std::string &label)
+    { return skeleton.number(tableau_atoms[safe_string2size_t(label)]); });
+
+  if(!relabeled)
+    return {};
+
+  return hoa;
+}
+
+/// The value of the atomic proposition under the constraints,
+/// if it is one of them or the negation of one of them
+static std::optional<bool>
+constant_value(const exprt &atom, const std::vector<exprt> &constraints)
+{
+  for(auto &constraint : constraints)
+  {
+    if(constraint == atom)
+      return true;
+    else if(constraint.id() == ID_not && to_not_expr(constraint).op() == atom)
+      return false;
+    else if(atom.id() == ID_not && to_not_expr(atom).op() == constraint)
+      return false;
+  }
+
+  return {};
+}
+
+static hoat::labelt fold_label(
+  const hoat::labelt &label,
+  const std::vector<std::optional<bool>> &values)
+{
+  if(label.id() == "t" || label.id() == "f")
+  {
+    return label;
+  }
+  else if(label.id() == "!")
+  {
+    PRECONDITION(label.get_sub().size() == 1);
+    auto op = fold_label(label.get_sub()[0], values);
+    if(op.id() == "t")
+      return hoat::labelt{"f"};
+    else if(op.id() == "f")
+      return hoat::labelt{"t"};
+    hoat::labelt result{"!"};
+    result.get_sub().push_back(std::move(op));
+    return result;
+  }
+  else if(label.id() == "&" || label.id() == "|")
+  {
+    PRECONDITION(label.get_sub().size() == 2);
+    auto lhs = fold_label(label.get_sub()[0], values);
+    auto rhs = fold_label(label.get_sub()[1], values);
+    // the neutral element and the absorbing element
+    const irep_idt neutral = label.id() == "&" ? "t" : "f";
+    const irep_idt absorbing = label.id() == "&" ? "f" : "t";
+    if(lhs.id() == absorbing || rhs.id() == absorbing)
+      return hoat::labelt{absorbing};
+    else if(lhs.id() == neutral)
+      return rhs;
+    else if(rhs.id() == neutral)
+      return lhs;
+    hoat::labelt result{label.id()};
+    result.get_sub().push_back(std::move(lhs));
+    result.get_sub().push_back(std::move(rhs));
+    return result;
+  }
+  else
+  {
+    // atomic proposition, given as number
+    auto number = safe_string2size_t(label.id_string());
+    PRECONDITION(number < values.size());
+    if(!values[number].has_value())
+      return label;
+    return hoat::labelt{*values[number] ? "t" : "f"};
+  }
+}
+
+/// Folds the atomic propositions that are constant under the
+/// constraints into the labels, and removes the edges whose labels
+/// are then false. Returns true iff any label has changed.
+static bool fold_constant_labels(
+  hoat &hoa,
+  const std::vector<exprt> &atoms,
+  const std::vector<exprt> &constraints)
+{
+  std::vector<std::optional<bool>> values;
+  values.reserve(atoms.size());
+  bool have_constant = false;
+
+  for(auto &atom : atoms)
+  {
+    values.push_back(constant_value(atom, constraints));
+    if(values.back().has_value())
+      have_constant = true;
+  }
+
+  if(!have_constant)
+    return false;
 
-    auto max_state_number = hoa.max_state_number();
-    auto state_type = range_typet{0, max_state_number};
-    const auto buechi_state = symbol_exprt{"buechi::state", state_type};
-    const auto buechi_next_state =
-      next_symbol_exprt{"buechi::state", state_type};
+  bool changed = false;
 
-    // construct the initial state constraint
-    std::vector<exprt> init_disjuncts;
+  for(auto &state : hoa.body)
+  {
+    auto &edges = state.second;
+    for(auto edge_it = edges.begin(); edge_it != edges.end();)
+    {
+      auto label = fold_label(edge_it->label, values);
+      if(label != edge_it->label)
+      {
+        changed = true;
+        ebmc_statistics().count("Buechi edges folded");
+      }
 
-    for(auto &item : hoa.header)
-      if(item.first == "Start:")
+      if(label.id() == "f")
+        edge_it = edges.erase(edge_it);
+      else
       {
-        if(item.second.size() != 1)
-          throw ebmc_errort() << "Start header must have one token";
-        auto state_number = string2integer(item.second.front());
-        init_disjuncts.push_back(
-          equal_exprt{buechi_state, from_integer(state_number, state_type)});
+        edge_it->label = std::move(label);
+        edge_it++;
       }
+    }
+  }
 
-    auto init = disjunction(init_disjuncts);
+  return changed;
+}
 
-    message.debug() << "Buechi initial state: " << format(init)
-                    << messaget::eom;
+/// Removes the unreachable states, and merges the equivalent states
+static void simplify(hoat &hoa, messaget &message)
+{
+  auto states_before = hoa.body.size();
 
-    exprt liveness_signal;
+  hoa.remove_unreachable_states();
+  hoa.merge_equivalent_states();
 
-    // Is safety sufficient?
-    if(is_safety_only(hoa))
-    {
-      liveness_signal = false_exprt{};
+  if(hoa.body.size() != states_before)
+  {
+    message.debug() << "Buechi automaton reduced from " << states_before
+                    << " to " << hoa.body.size() << " states" << messaget::eom;
+    ebmc_statistics().count(
+      "Buechi states removed", states_before - hoa.body.size());
+  }
+}
+
+/// Encodes the automaton as a transition system, with the given
+/// atomic propositions
+static buechi_transt hoa_to_buechi(
+  const hoat &hoa,
+  const std::vector<exprt> &atoms,
+  buechi_encodingt encoding,
+  messaget &message)
+{
+  auto max_state_number = hoa.max_state_number();
+  auto number_of_states = numeric_cast_v<std::size_t>(max_state_number + 1);
+
+  typet state_type;
+
+  switch(encoding)
+  {
+  case buechi_encodingt::BINARY:
+    state_type = range_typet{0, max_state_number};
+    break;
+  case buechi_encodingt::ONE_HOT:
+    state_type = unsignedbv_typet{number_of_states};
+    break;
+  case buechi_encodingt::GRAY:
+    state_type = unsignedbv_typet{
+      numeric_cast_v<std::size_t>(address_bits(number_of_states))};
+    break;
+  }
+
+  const auto buechi_state = symbol_exprt{"buechi::state", state_type};
+  const auto buechi_next_state = next_symbol_exprt{"buechi::state", state_type};
 
-      message.debug() << "Buechi liveness signal not required" << messaget::eom;
+  // the value of the state variable for the given automaton state
+  auto state_value = [encoding, &state_type](hoat::intt number) -> exprt
+  {
+    switch(encoding)
+    {
+    case buechi_encodingt::BINARY:
+      return from_integer(number, state_type);
+    case buechi_encodingt::ONE_HOT:
+      return from_integer(power(2, number), state_type);
+    case buechi_encodingt::GRAY:
+      return from_integer(number ^ (number >> 1), state_type);
     }
+    UNREACHABLE;
+  };
+
+  // true iff the automaton is in the given state; for one-hot,
+  // it suffices to test the bit of the state
+  auto in_state = [encoding, &buechi_state, &state_value](hoat::intt number)
+    -> exprt
+  {
+    if(encoding == buechi_encodingt::ONE_HOT)
+      return extractbit_exprt{buechi_state, number};
     else
+      return equal_exprt{buechi_state, state_value(number)};
+  };
+
+  // construct the initial state constraint
+  std::vector<exprt> init_disjuncts;
+
+  for(auto &item : hoa.header)
+    if(item.first == "Start:")
     {
-      // construct the liveness signal
-      std::vector<exprt> liveness_disjuncts;
+      if(item.second.size() != 1)
+        throw ebmc_errort() << "Start header must have one token";
+      auto state_number = safe_string2unsigned(item.second.front());
+      init_disjuncts.push_back(
+        equal_exprt{buechi_state, state_value(state_number)});
+    }
 
-      for(auto &state : hoa.body)
-        if(state.first.is_accepting())
-        {
-          liveness_disjuncts.push_back(equal_exprt{
-            buechi_state, from_integer(state.first.number, state_type)});
-        }
+  auto init = disjunction(init_disjuncts);
 
-      liveness_signal = disjunction(liveness_disjuncts);
+  message.debug() << "Buechi initial state: " << format(init) << messaget::eom;
 
-      message.debug() << "Buechi liveness signal: " << format(liveness_signal)
-                      << messaget::eom;
-    }
+  exprt liveness_signal;
 
-    // construct the error signal -- true when the next automaton state
-    // is nonaccepting with an unconditional self-loop.
-    std::vector<exprt> error_disjuncts;
+  // Is safety sufficient?
+  if(is_safety_only(hoa))
+  {
+    liveness_signal = false_exprt{};
 
-    std::map<hoat::intt, std::pair<hoat::state_namet, hoat::edgest>> state_map;
-    for(auto &state : hoa.body)
-      state_map[state.first.number] = state;
+    message.debug() << "Buechi liveness signal not required" << messaget::eom;
+  }
+  else
+  {
+    // construct the liveness signal
+    std::vector<exprt> liveness_disjuncts;
 
     for(auto &state : hoa.body)
-    {
-      for(auto &edge : state.second)
+      if(state.first.is_accepting())
       {
-        if(edge.dest_states.size() != 1)
-          throw ebmc_errort() << "edge must have one destination state";
-        auto dest_state_it = state_map.find(edge.dest_states.front());
-        CHECK_RETURN(dest_state_it != state_map.end());
-        if(is_error_state(dest_state_it->second))
-        {
-          auto pre = equal_exprt{
-            buechi_state, from_integer(state.first.number, state_type)};
-          auto cond = hoa_label_to_expr(edge.label, ltl_sva_to_string);
-          error_disjuncts.push_back(and_exprt{pre, cond});
-        }
+        liveness_disjuncts.push_back(in_state(state.first.number));
       }
-    }
 
-    auto error_signal = disjunction(error_disjuncts);
+    liveness_signal = disjunction(liveness_disjuncts);
 
-    message.debug() << "Buechi error signal: " << format(error_signal)
+    message.debug() << "Buechi liveness signal: " << format(liveness_signal)
                     << messaget::eom;
+  }
 
-    // construct the transition relation
-    std::vector<exprt> trans_disjuncts;
+  // construct the error signal -- true when the next automaton state
+  // is nonaccepting with an unconditional self-loop.
+  std::vector<exprt> error_disjuncts;
 
-    for(auto &state : hoa.body)
+  std::map<hoat::intt, std::pair<hoat::state_namet, hoat::edgest>> state_map;
+  for(auto &state : hoa.body)
+    state_map[state.first.number] = state;
+
+  for(auto &state : hoa.body)
+  {
+    for(auto &edge : state.second)
     {
-      auto pre =
-        equal_exprt{buechi_state, from_integer(state.first.number, state_type)};
-      for(auto &edge : state.second)
+      if(edge.dest_states.size() != 1)
+        throw ebmc_errort() << "edge must have one destination state";
+      auto dest_state_it = state_map.find(edge.dest_states.front());
+      CHECK_RETURN(dest_state_it != state_map.end());
+      if(is_error_state(dest_state_it->second))
       {
-        if(edge.dest_states.size() != 1)
-          throw ebmc_errort() << "edge must have one destination state";
-        auto cond = hoa_label_to_expr(edge.label, ltl_sva_to_string);
-        auto post = equal_exprt{
-          buechi_next_state,
-          from_integer(edge.dest_states.front(), state_type)};
-        trans_disjuncts.push_back(and_exprt{pre, cond, post});
+        auto pre = in_state(state.first.number);
+        auto cond = hoa_label_to_expr(edge.label, atoms);
+        error_disjuncts.push_back(and_exprt{pre, cond});
       }
     }
+  }
 
-    auto trans = disjunction(trans_disjuncts);
+  auto error_signal = disjunction(error_disjuncts);
 
-    message.debug() << "Buechi transition constraint: " << format(trans)
-                    << messaget::eom;
+  message.debug() << "Buechi error signal: " << format(error_signal)
+                  << messaget::eom;
+
+  // construct the transition relation
+  std::vector<exprt> trans_disjuncts;
 
-    return {
-      buechi_state,
-      std::move(init),
-      std::move(trans),
-      std::move(error_signal),
-      std::move(liveness_signal)};
+  for(auto &state : hoa.body)
+  {
+    auto pre = in_state(state.first.number);
+    for(auto &edge : state.second)
+    {
+      if(edge.dest_states.size() != 1)
+        throw ebmc_errort() << "edge must have one destination state";
+      auto cond = hoa_label_to_expr(edge.label, atoms);
+      auto post =
+        equal_exprt{buechi_next_state, state_value(edge.dest_states.front())};
+      trans_disjuncts.push_back(and_exprt{pre, cond, post});
+    }
   }
-  catch(ltl_sva_to_string_unsupportedt error)
+
+  auto trans = disjunction(trans_disjuncts);
+
+  message.debug() << "Buechi transition constraint: " << format(trans)
+                  << messaget::eom;
+
+  return {
+    buechi_state,
+    std::move(init),
+    std::move(trans),
+    std::move(error_signal),
+    std::move(liveness_signal)};
+}
+
+buechi_transt ltl_to_buechit::operator()(
+  const exprt &property,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+  const ltl_skeletont skeleton{property};
+
+  auto cache_it = cache.find(skeleton.skeleton);
+
+  if(cache_it == cache.end())
   {
-    throw ebmc_errort{} << "failed to convert " << error.expr.id();
+    std::optional<hoat> hoa;
+
+    if(options.backend == buechi_backendt::INTERNAL)
+    {
+      hoa = internal_translation(skeleton);
+
+      if(!hoa.has_value())
+        message.debug() << "falling back to ltl2tgba" << messaget::eom;
+    }
+
+    if(!hoa.has_value())
+      hoa = spot_translation(skeleton, message_handler);
+
+    message.debug() << *hoa << messaget::eom;
+
+    // clean up accepting states
+    hoa->buechi_acceptance_cleanup();
+
+    // remove unreachable and merge equivalent states
+    simplify(*hoa, message);
+
+    cache_it = cache.emplace(skeleton.skeleton, std::move(*hoa)).first;
   }
+  else
+  {
+    message.debug() << "Buechi automaton taken from cache" << messaget::eom;
+    ebmc_statistics().count("Buechi cache hits");
+  }
+
+  // The cached automaton does not depend on the design; the
+  // constraints of the design are folded into a copy.
+  if(!options.constraints.empty())
+  {
+    hoat hoa = cache_it->second;
+    if(fold_constant_labels(hoa, skeleton.atoms, options.constraints))
+    {
+      message.debug() << "Buechi automaton has constant labels"
+                      << messaget::eom;
+      simplify(hoa, message);
+      return hoa_to_buechi(hoa, skeleton.atoms, options.encoding, message);
+    }
+  }
+
+  return hoa_to_buechi(
+    cache_it->second, skeleton.atoms, options.encoding, message);
 }
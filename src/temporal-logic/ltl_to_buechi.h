@@ -11,6 +11,10 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include <util/std_expr.h>
 
+#include "hoa.h"
+
+#include <unordered_map>
+
 struct buechi_transt
 {
   symbol_exprt state_symbol;
@@ -39,6 +43,51 @@ struct buechi_transt
 
 class message_handlert;
 
-buechi_transt ltl_to_buechi(const exprt &formula, message_handlert &);
+/// The translators from LTL/SVA to Buechi automata
+enum class buechi_backendt
+{
+  INTERNAL, // in-process, using ltl2tgba for SVA sequences only
+  SPOT      // Spot's ltl2tgba
+};
+
+/// The encodings of the state of the automaton
+enum class buechi_encodingt
+{
+  BINARY,  // the state number
+  ONE_HOT, // one bit per state
+  GRAY     // the Gray code of the state number
+};
+
+struct buechi_optionst
+{
+  buechi_backendt backend = buechi_backendt::INTERNAL;
+  buechi_encodingt encoding = buechi_encodingt::BINARY;
+
+  // Constraints of the design. Edges whose labels are false
+  // under these are removed from the automaton.
+  std::vector<exprt> constraints;
+};
+
+/// Translates formulas into Buechi automata. The automata are
+/// cached for the lifetime of the translator, keyed by the formula
+/// up to renaming of the atomic propositions. Unreachable and
+/// equivalent states are removed.
+class ltl_to_buechit
+{
+public:
+  explicit ltl_to_buechit(buechi_optionst __options)
+    : options(std::move(__options))
+  {
+  }
+
+  buechi_transt operator()(const exprt &formula, message_handlert &);
+
+protected:
+  buechi_optionst options;
+
+  // The automata for the skeletons translated so far. The automata
+  // are complete, and thus, can be shared by any number of properties.
+  std::unordered_map<exprt, hoat, irep_hash> cache;
+};
 
 #endif
@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <cassert>
 #include <ostream>
 #include <string>
+#include <unordered_set>
 
 std::string aigt::label(nodest::size_type v) const {
   return "var(" + std::to_string(v) + ")";
@@ -110,3 +111,24 @@ std::ostream &operator<<(std::ostream &out, const aigt &aig) {
   aig.print(out);
   return out;
 }
+
+bvt aigt::conjuncts(literalt root) const {
+  bvt result;
+  std::vector<literalt> stack{root};
+  std::unordered_set<unsigned> seen;
+
+  while (!stack.empty()) {
+    literalt l = stack.back();
+    stack.pop_back();
+
+    if (!l.is_constant() && !l.sign() && get_node(l).is_and()) {
+      if (seen.insert(l.var_no()).second) {
+        stack.push_back(get_node(l).b);
+        stack.push_back(get_node(l).a);
+      }
+    } else if (!l.is_true())
+      result.push_back(l);
+  }
+
+  return result;
+}
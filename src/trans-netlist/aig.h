@@ -77,6 +77,10 @@ public:
 
   bool empty() const { return nodes.empty(); }
 
+  /// the conjuncts of the AND tree with the given root,
+  /// i.e., the literals below the non-negated AND nodes
+  bvt conjuncts(literalt) const;
+
   void print(std::ostream &out) const;
   void print(std::ostream &out, literalt a) const;
   void output_dot_node(std::ostream &out, nodest::size_type v) const;
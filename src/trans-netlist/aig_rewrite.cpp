@@ -0,0 +1,959 @@
+/*******************************************************************\
+
+Module: Rewriting and Balancing of And-Inverter Graphs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Rewriting and Balancing of And-Inverter Graphs
+
+#include "aig_rewrite.h"
+
+#include <util/ebmc_statistics.h>
+#include <util/invariant.h>
+
+#include <solvers/prop/literal_expr.h>
+
+#include "aig_strash.h"
+#include "netlist.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+
+/// Structures for the functions with up to four inputs,
+/// given as truth tables, computed on demand by choosing the
+/// cheapest of the decompositions x&f, !x&f, x|f, !x|f, x^f
+/// and the multiplexer over all input variables x.
+class aig_libraryt
+{
+public:
+  using truth_tablet = std::uint16_t;
+
+  /// the truth tables of the four inputs
+  static constexpr truth_tablet projections[4] = {
+    0xAAAA,
+    0xCCCC,
+    0xF0F0,
+    0xFF00};
+
+  /// the number of AND nodes of the structure
+  std::size_t cost(truth_tablet);
+
+  /// builds the structure over the given inputs
+  literalt build(truth_tablet, const std::array<literalt, 4> &, aig_strasht &);
+
+protected:
+  enum class kindt
+  {
+    CONST_FALSE,
+    CONST_TRUE,
+    INPUT,
+    AND_X,    // x & f1
+    AND_NOT_X, // !x & f0
+    OR_X,     // x | f0
+    OR_NOT_X, // !x | f1
+    XOR,      // x ^ f0
+    MUX       // x ? f1 : f0
+  };
+
+  struct entryt
+  {
+    std::size_t cost;
+    kindt kind;
+    unsigned x;
+  };
+
+  std::unordered_map<truth_tablet, entryt> table;
+
+  static truth_tablet cofactor(truth_tablet f, unsigned x, bool value)
+  {
+    unsigned shift = 1u << x;
+    unsigned p = projections[x];
+    unsigned c = value ? (f & p) : (f & ~p);
+    c |= value ? (c >> shift) : (c << shift);
+    return truth_tablet(c);
+  }
+};
+
+/*******************************************************************\
+
+Function: aig_libraryt::cost
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::size_t aig_libraryt::cost(truth_tablet f)
+{
+  auto entry_it = table.find(f);
+  if(entry_it != table.end())
+    return entry_it->second.cost;
+
+  entryt best{std::numeric_limits<std::size_t>::max(), kindt::CONST_FALSE, 0};
+
+  if(f == 0)
+    best = {0, kindt::CONST_FALSE, 0};
+  else if(f == 0xFFFF)
+    best = {0, kindt::CONST_TRUE, 0};
+  else
+  {
+    for(unsigned x = 0; x < 4; x++)
+      if(f == projections[x] || f == truth_tablet(~projections[x]))
+        best = {0, kindt::INPUT, x};
+  }
+
+  for(unsigned x = 0; x < 4 && best.cost != 0; x++)
+  {
+    auto f0 = cofactor(f, x, false), f1 = cofactor(f, x, true);
+
+    if(f0 == f1)
+      continue; // does not depend on x
+
+    entryt candidate;
+
+    if(f0 == 0)
+      candidate = {1 + cost(f1), kindt::AND_X, x};
+    else if(f1 == 0)
+      candidate = {1 + cost(f0), kindt::AND_NOT_X, x};
+    else if(f1 == 0xFFFF)
+      candidate = {1 + cost(f0), kindt::OR_X, x};
+    else if(f0 == 0xFFFF)
+      candidate = {1 + cost(f1), kindt::OR_NOT_X, x};
+    else if(f0 == truth_tablet(~f1))
+      candidate = {3 + cost(f0), kindt::XOR, x};
+    else
+      candidate = {3 + cost(f0) + cost(f1), kindt::MUX, x};
+
+    if(candidate.cost < best.cost)
+      best = candidate;
+  }
+
+  table[f] = best;
+  return best.cost;
+}
+
+/*******************************************************************\
+
+Function: aig_libraryt::build
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+literalt aig_libraryt::build(
+  truth_tablet f,
+  const std::array<literalt, 4> &inputs,
+  aig_strasht &strash)
+{
+  cost(f);
+  const auto entry = table.at(f);
+  const auto x = inputs[entry.x];
+  auto f0 = cofactor(f, entry.x, false), f1 = cofactor(f, entry.x, true);
+
+  switch(entry.kind)
+  {
+  case kindt::CONST_FALSE:
+    return const_literal(false);
+  case kindt::CONST_TRUE:
+    return const_literal(true);
+  case kindt::INPUT:
+    return x ^ (f != projections[entry.x]);
+  case kindt::AND_X:
+    return strash.land(x, build(f1, inputs, strash));
+  case kindt::AND_NOT_X:
+    return strash.land(!x, build(f0, inputs, strash));
+  case kindt::OR_X:
+    return strash.lor(x, build(f0, inputs, strash));
+  case kindt::OR_NOT_X:
+    return strash.lor(!x, build(f1, inputs, strash));
+  case kindt::XOR:
+    return strash.lxor(x, build(f0, inputs, strash));
+  case kindt::MUX:
+    return strash.lselect(
+      x, build(f1, inputs, strash), build(f0, inputs, strash));
+  }
+
+  UNREACHABLE;
+}
+
+class aig_rewritert
+{
+public:
+  aig_rewritert(netlistt &_netlist, message_handlert &_message_handler)
+    : netlist(_netlist), message(_message_handler)
+  {
+  }
+
+  void operator()();
+
+protected:
+  netlistt &netlist;
+  messaget message;
+  aig_libraryt library;
+
+  struct cutt
+  {
+    std::size_t size = 0;
+    std::array<std::size_t, 4> leaves;
+
+    bool contains(std::size_t n) const
+    {
+      return std::find(leaves.begin(), leaves.begin() + size, n) !=
+             leaves.begin() + size;
+    }
+  };
+
+  using cutst = std::vector<cutt>;
+
+  // the number of cuts kept per node
+  static constexpr std::size_t max_cuts = 8;
+
+  // the literals that are referenced from outside of the AIG
+  std::vector<literalt> roots() const;
+
+  // references from AND nodes and from the roots
+  std::vector<unsigned> references;
+  void count_references();
+
+  struct resultt
+  {
+    aigt aig;
+    std::vector<literalt> old_to_new;
+  };
+
+  using dependenciest =
+    std::function<void(std::size_t, std::vector<std::size_t> &)>;
+  using constructt = std::function<literalt(
+    std::size_t,
+    const std::vector<literalt> &old_to_new,
+    aig_strasht &,
+    const aigt &)>;
+
+  // builds the nodes that are reachable from the roots
+  resultt rebuild(const dependenciest &, const constructt &) const;
+
+  void apply(resultt &);
+
+  std::size_t depth(const aigt &, const std::vector<literalt> &roots) const;
+
+  std::size_t number_of_and_nodes(const aigt &aig) const
+  {
+    return std::count_if(aig.nodes.begin(), aig.nodes.end(), [](auto &n) {
+      return n.is_and();
+    });
+  }
+
+  resultt rewrite();
+  resultt balance();
+
+  static std::optional<cutt> merge(const cutt &, const cutt &);
+  aig_libraryt::truth_tablet truth_table(std::size_t n, const cutt &) const;
+  std::size_t dereference(std::size_t n, const cutt &);
+  void reference(std::size_t n, const cutt &);
+};
+
+/*******************************************************************\
+
+Function: aig_rewritert::roots
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::vector<literalt> aig_rewritert::roots() const
+{
+  std::vector<literalt> result;
+
+  for(auto &var_it : netlist.var_map.map)
+    for(auto &bit : var_it.second.bits)
+    {
+      result.push_back(bit.current);
+      result.push_back(bit.next);
+    }
+
+  for(auto *constraints :
+      {&netlist.constraints, &netlist.initial, &netlist.transition})
+  {
+    result.insert(result.end(), constraints->begin(), constraints->end());
+  }
+
+  for(auto &property_it : netlist.properties)
+    if(property_it.second.has_value())
+    {
+      property_it.second->visit_pre([&result](const exprt &expr) {
+        if(expr.id() == ID_literal)
+          result.push_back(to_literal_expr(expr).get_literal());
+      });
+    }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: aig_rewritert::count_references
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aig_rewritert::count_references()
+{
+  references.assign(netlist.number_of_nodes(), 0);
+
+  for(auto &node : netlist.nodes)
+    if(node.is_and())
+    {
+      for(auto l : {node.a, node.b})
+        if(!l.is_constant())
+          references[l.var_no()]++;
+    }
+
+  for(auto l : roots())
+    if(!l.is_constant())
+      references[l.var_no()]++;
+}
+
+/*******************************************************************\
+
+Function: aig_rewritert::rebuild
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: construct a new AIG on demand, starting from the roots;
+          the variable nodes are kept in their original order
+
+\*******************************************************************/
+
+aig_rewritert::resultt aig_rewritert::rebuild(
+  const dependenciest &dependencies,
+  const constructt &construct) const
+{
+  const std::size_t number_of_nodes = netlist.number_of_nodes();
+
+  resultt result;
+  aig_strasht strash{result.aig};
+  auto &old_to_new = result.old_to_new;
+  old_to_new.resize(number_of_nodes, const_literal(false));
+
+  enum class statet
+  {
+    NEW,
+    STARTED,
+    DONE
+  };
+  std::vector<statet> state(number_of_nodes, statet::NEW);
+
+  for(std::size_t n = 0; n < number_of_nodes; n++)
+    if(netlist.nodes[n].is_var())
+    {
+      old_to_new[n] = result.aig.new_var_node();
+      state[n] = statet::DONE;
+    }
+
+  std::vector<std::size_t> stack, deps;
+
+  for(auto root : roots())
+  {
+    if(root.is_constant())
+      continue;
+
+    stack.push_back(root.var_no());
+
+    while(!stack.empty())
+    {
+      auto n = stack.back();
+
+      switch(state[n])
+      {
+      case statet::DONE:
+        stack.pop_back();
+        break;
+
+      case statet::NEW:
+        state[n] = statet::STARTED;
+        deps.clear();
+        dependencies(n, deps);
+        for(auto d : deps)
+          if(state[d] != statet::DONE)
+            stack.push_back(d);
+        break;
+
+      case statet::STARTED:
+        old_to_new[n] = construct(n, old_to_new, strash, result.aig);
+        state[n] = statet::DONE;
+        stack.pop_back();
+        break;
+      }
+    }
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: aig_rewritert::apply
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aig_rewritert::apply(resultt &result)
+{
+  const auto &old_to_new = result.old_to_new;
+
+  netlist.renumber(std::move(result.aig.nodes), [&old_to_new](literalt l) {
+    return l.is_constant() ? l : old_to_new[l.var_no()] ^ l.sign();
+  });
+}
+
+/*******************************************************************\
+
+Function: aig_rewritert::depth
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the length of the longest path from a root to an input
+
+\*******************************************************************/
+
+std::size_t aig_rewritert::depth(
+  const aigt &aig,
+  const std::vector<literalt> &roots) const
+{
+  std::vector<std::size_t> level(aig.number_of_nodes(), 0);
+
+  for(std::size_t n = 0; n < aig.number_of_nodes(); n++)
+  {
+    auto &node = aig.nodes[n];
+    if(node.is_and())
+    {
+      for(auto l : {node.a, node.b})
+        if(!l.is_constant())
+          level[n] = std::max(level[n], level[l.var_no()] + 1);
+    }
+  }
+
+  std::size_t result = 0;
+
+  for(auto l : roots)
+    if(!l.is_constant())
+      result = std::max(result, level[l.var_no()]);
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: aig_rewritert::merge
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the union of two cuts, unless it has more than four leaves
+
+\*******************************************************************/
+
+std::optional<aig_rewritert::cutt>
+aig_rewritert::merge(const cutt &c1, const cutt &c2)
+{
+  // the leaves are sorted
+  cutt result;
+  std::size_t i = 0, j = 0;
+
+  while(i < c1.size || j < c2.size)
+  {
+    std::size_t leaf;
+
+    if(j == c2.size || (i < c1.size && c1.leaves[i] < c2.leaves[j]))
+      leaf = c1.leaves[i++];
+    else if(i == c1.size || c2.leaves[j] < c1.leaves[i])
+      leaf = c2.leaves[j++];
+    else
+    {
+      leaf = c1.leaves[i++];
+      j++;
+    }
+
+    if(result.size == 4)
+      return {};
+
+    result.leaves[result.size++] = leaf;
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: aig_rewritert::truth_table
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the function of node n in terms of the leaves of the cut
+
+\*******************************************************************/
+
+aig_libraryt::truth_tablet
+aig_rewritert::truth_table(std::size_t n, const cutt &cut) const
+{
+  std::unordered_map<std::size_t, aig_libraryt::truth_tablet> values;
+
+  for(std::size_t i = 0; i < cut.size; i++)
+    values[cut.leaves[i]] = aig_libraryt::projections[i];
+
+  std::function<aig_libraryt::truth_tablet(literalt)> evaluate =
+    [&](literalt l) -> aig_libraryt::truth_tablet {
+    if(l.is_constant())
+      return l.is_true() ? 0xFFFF : 0;
+
+    aig_libraryt::truth_tablet value;
+    auto value_it = values.find(l.var_no());
+
+    if(value_it != values.end())
+      value = value_it->second;
+    else
+    {
+      auto &node = netlist.nodes[l.var_no()];
+      DATA_INVARIANT(node.is_and(), "cut must separate node from inputs");
+      value = evaluate(node.a) & evaluate(node.b);
+      values[l.var_no()] = value;
+    }
+
+    return l.sign() ? aig_libraryt::truth_tablet(~value) : value;
+  };
+
+  return evaluate(literalt(n, false));
+}
+
+/*******************************************************************\
+
+Function: aig_rewritert::dereference
+
+  Inputs:
+
+ Outputs: the number of nodes that are only used by node n,
+          up to the leaves of the cut, including n
+
+ Purpose:
+
+\*******************************************************************/
+
+std::size_t aig_rewritert::dereference(std::size_t n, const cutt &cut)
+{
+  std::size_t result = 1;
+  auto &node = netlist.nodes[n];
+
+  for(auto l : {node.a, node.b})
+  {
+    if(l.is_constant())
+      continue;
+    auto m = l.var_no();
+    if(netlist.nodes[m].is_and() && !cut.contains(m))
+      if(--references[m] == 0)
+        result += dereference(m, cut);
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: aig_rewritert::reference
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: undo dereference
+
+\*******************************************************************/
+
+void aig_rewritert::reference(std::size_t n, const cutt &cut)
+{
+  auto &node = netlist.nodes[n];
+
+  for(auto l : {node.a, node.b})
+  {
+    if(l.is_constant())
+      continue;
+    auto m = l.var_no();
+    if(netlist.nodes[m].is_and() && !cut.contains(m))
+      if(references[m]++ == 0)
+        reference(m, cut);
+  }
+}
+
+/*******************************************************************\
+
+Function: aig_rewritert::rewrite
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: replace the cone of a cut by the structure from the
+          library when this frees more nodes than it adds
+
+\*******************************************************************/
+
+aig_rewritert::resultt aig_rewritert::rewrite()
+{
+  const std::size_t number_of_nodes = netlist.number_of_nodes();
+
+  count_references();
+
+  struct choicet
+  {
+    cutt cut;
+    aig_libraryt::truth_tablet truth_table;
+  };
+
+  std::vector<std::optional<choicet>> choices(number_of_nodes);
+  std::vector<cutst> cuts(number_of_nodes);
+
+  const cutst constant_cuts = {cutt{}};
+
+  auto operand_cuts = [&](literalt l) -> const cutst & {
+    return l.is_constant() ? constant_cuts : cuts[l.var_no()];
+  };
+
+  for(std::size_t n = 0; n < number_of_nodes; n++)
+  {
+    auto &node = netlist.nodes[n];
+
+    cutt trivial;
+    trivial.size = 1;
+    trivial.leaves[0] = n;
+
+    if(node.is_var())
+    {
+      cuts[n] = {trivial};
+      continue;
+    }
+
+    cutst result;
+
+    for(auto &c1 : operand_cuts(node.a))
+      for(auto &c2 : operand_cuts(node.b))
+      {
+        auto merged = merge(c1, c2);
+        if(!merged.has_value())
+          continue;
+
+        bool duplicate =
+          std::any_of(result.begin(), result.end(), [&merged](const cutt &c) {
+            return c.size == merged->size &&
+                   std::equal(
+                     c.leaves.begin(),
+                     c.leaves.begin() + c.size,
+                     merged->leaves.begin());
+          });
+
+        if(!duplicate)
+          result.push_back(*merged);
+      }
+
+    // pick the cut with the largest gain, if any
+    std::size_t best_gain = 0;
+
+    if(references[n] != 0)
+    {
+      for(auto &cut : result)
+      {
+        auto f = truth_table(n, cut);
+        auto cost = library.cost(f);
+        auto freed = dereference(n, cut);
+        reference(n, cut);
+
+        if(freed > cost && freed - cost > best_gain)
+        {
+          best_gain = freed - cost;
+          choices[n] = choicet{cut, f};
+        }
+      }
+    }
+
+    // keep the smallest cuts, and the trivial one
+    std::stable_sort(
+      result.begin(), result.end(), [](const cutt &a, const cutt &b) {
+        return a.size < b.size;
+      });
+
+    if(result.size() > max_cuts - 1)
+      result.resize(max_cuts - 1);
+
+    result.push_back(trivial);
+    cuts[n] = std::move(result);
+  }
+
+  auto dependencies = [&](std::size_t n, std::vector<std::size_t> &deps) {
+    if(choices[n].has_value())
+    {
+      auto &cut = choices[n]->cut;
+      deps.insert(deps.end(), cut.leaves.begin(), cut.leaves.begin() + cut.size);
+    }
+    else
+    {
+      auto &node = netlist.nodes[n];
+      for(auto l : {node.a, node.b})
+        if(!l.is_constant())
+          deps.push_back(l.var_no());
+    }
+  };
+
+  auto map = [](const std::vector<literalt> &old_to_new, literalt l) {
+    return l.is_constant() ? l : old_to_new[l.var_no()] ^ l.sign();
+  };
+
+  auto construct = [&](
+                     std::size_t n,
+                     const std::vector<literalt> &old_to_new,
+                     aig_strasht &strash,
+                     const aigt &) {
+    if(choices[n].has_value())
+    {
+      auto &cut = choices[n]->cut;
+      std::array<literalt, 4> inputs;
+      inputs.fill(const_literal(false));
+      for(std::size_t i = 0; i < cut.size; i++)
+        inputs[i] = old_to_new[cut.leaves[i]];
+      return library.build(choices[n]->truth_table, inputs, strash);
+    }
+    else
+    {
+      auto &node = netlist.nodes[n];
+      return strash.land(map(old_to_new, node.a), map(old_to_new, node.b));
+    }
+  };
+
+  return rebuild(dependencies, construct);
+}
+
+/*******************************************************************\
+
+Function: aig_rewritert::balance
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: rebuild the trees of ANDs with single fanout as balanced
+          trees, combining the operands with the lowest level first
+
+\*******************************************************************/
+
+aig_rewritert::resultt aig_rewritert::balance()
+{
+  count_references();
+
+  auto supergate = [this](std::size_t n, std::vector<literalt> &leaves) {
+    auto &node = netlist.nodes[n];
+    std::vector<literalt> stack = {node.b, node.a};
+
+    while(!stack.empty())
+    {
+      auto l = stack.back();
+      stack.pop_back();
+
+      if(
+        !l.is_constant() && !l.sign() && netlist.nodes[l.var_no()].is_and() &&
+        references[l.var_no()] == 1)
+      {
+        auto &operand = netlist.nodes[l.var_no()];
+        stack.push_back(operand.b);
+        stack.push_back(operand.a);
+      }
+      else
+        leaves.push_back(l);
+    }
+  };
+
+  auto dependencies = [&](std::size_t n, std::vector<std::size_t> &deps) {
+    std::vector<literalt> leaves;
+    supergate(n, leaves);
+    for(auto l : leaves)
+      if(!l.is_constant())
+        deps.push_back(l.var_no());
+  };
+
+  // levels of the nodes of the new AIG, extended as it grows
+  std::vector<std::size_t> level;
+
+  auto level_of = [&level](const aigt &aig, literalt l) -> std::size_t {
+    if(l.is_constant())
+      return 0;
+
+    for(std::size_t n = level.size(); n < aig.number_of_nodes(); n++)
+    {
+      auto &node = aig.nodes[n];
+      std::size_t node_level = 0;
+      if(node.is_and())
+      {
+        for(auto o : {node.a, node.b})
+          if(!o.is_constant())
+            node_level = std::max(node_level, level[o.var_no()] + 1);
+      }
+      level.push_back(node_level);
+    }
+
+    return level[l.var_no()];
+  };
+
+  auto construct = [&](
+                     std::size_t n,
+                     const std::vector<literalt> &old_to_new,
+                     aig_strasht &strash,
+                     const aigt &aig) {
+    std::vector<literalt> leaves;
+    supergate(n, leaves);
+
+    using entryt = std::pair<std::size_t, literalt>;
+    std::vector<entryt> heap;
+
+    for(auto l : leaves)
+    {
+      auto new_l = l.is_constant() ? l : old_to_new[l.var_no()] ^ l.sign();
+      heap.emplace_back(level_of(aig, new_l), new_l);
+    }
+
+    // a min-heap on the level
+    auto greater = [](const entryt &a, const entryt &b) {
+      return a.first > b.first ||
+             (a.first == b.first && a.second.get() > b.second.get());
+    };
+
+    std::make_heap(heap.begin(), heap.end(), greater);
+
+    while(heap.size() >= 2)
+    {
+      std::pop_heap(heap.begin(), heap.end(), greater);
+      auto a = heap.back().second;
+      heap.pop_back();
+      std::pop_heap(heap.begin(), heap.end(), greater);
+      auto b = heap.back().second;
+      heap.pop_back();
+
+      auto l = strash.land(a, b);
+      heap.emplace_back(level_of(aig, l), l);
+      std::push_heap(heap.begin(), heap.end(), greater);
+    }
+
+    return heap.front().second;
+  };
+
+  return rebuild(dependencies, construct);
+}
+
+/*******************************************************************\
+
+Function: aig_rewritert::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aig_rewritert::operator()()
+{
+  auto mapped_roots = [this](const resultt &result) {
+    std::vector<literalt> dest;
+    for(auto l : roots())
+      dest.push_back(
+        l.is_constant() ? l : result.old_to_new[l.var_no()] ^ l.sign());
+    return dest;
+  };
+
+  const auto nodes_before = number_of_and_nodes(netlist);
+  const auto depth_before = depth(netlist, roots());
+
+  auto nodes = nodes_before;
+  auto current_depth = depth_before;
+
+  // rewriting must not grow the AIG
+  auto rewritten = rewrite();
+  auto rewritten_nodes = number_of_and_nodes(rewritten.aig);
+
+  if(rewritten_nodes <= nodes)
+  {
+    current_depth = depth(rewritten.aig, mapped_roots(rewritten));
+    nodes = rewritten_nodes;
+    apply(rewritten);
+  }
+
+  // balancing must reduce the depth without growing the AIG
+  auto balanced = balance();
+  auto balanced_nodes = number_of_and_nodes(balanced.aig);
+  auto balanced_depth = depth(balanced.aig, mapped_roots(balanced));
+
+  if(balanced_nodes <= nodes && balanced_depth < current_depth)
+  {
+    current_depth = balanced_depth;
+    nodes = balanced_nodes;
+    apply(balanced);
+  }
+
+  message.statistics() << "AIG rewriting: " << nodes_before << " -> " << nodes
+                       << " AND nodes, depth " << depth_before << " -> "
+                       << current_depth << messaget::eom;
+
+  ebmc_statistics().count("AND nodes removed", nodes_before - nodes);
+  ebmc_statistics().count(
+    "depth reduction", double(depth_before) - double(current_depth));
+}
+
+/*******************************************************************\
+
+Function: aig_rewrite
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aig_rewrite(netlistt &netlist, message_handlert &message_handler)
+{
+  ebmc_phaset phase("aig rewrite");
+  aig_rewritert{netlist, message_handler}();
+}
@@ -0,0 +1,28 @@
+/*******************************************************************\
+
+Module: Rewriting and Balancing of And-Inverter Graphs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Rewriting and Balancing of And-Inverter Graphs
+
+#ifndef CPROVER_TRANS_NETLIST_AIG_REWRITE_H
+#define CPROVER_TRANS_NETLIST_AIG_REWRITE_H
+
+#include <util/message.h>
+
+class netlistt;
+
+/// Local rewriting of the netlist: the 4-input cuts of each node
+/// are enumerated, and the cone of a cut is replaced by the
+/// structure for its truth table from a library when that
+/// structure is smaller than the nodes that would be freed.
+/// Afterwards, trees of ANDs are balanced to reduce the depth.
+/// Nodes that are not referenced are dropped. The variable map,
+/// the constraints and the properties are updated.
+void aig_rewrite(netlistt &, message_handlert &);
+
+#endif // CPROVER_TRANS_NETLIST_AIG_REWRITE_H
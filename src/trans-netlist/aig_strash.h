@@ -0,0 +1,93 @@
+/*******************************************************************\
+
+Module: Structural Hashing for And-Inverter Graphs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Structural Hashing for And-Inverter Graphs
+
+#ifndef CPROVER_TRANS_NETLIST_AIG_STRASH_H
+#define CPROVER_TRANS_NETLIST_AIG_STRASH_H
+
+#include "aig.h"
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+/// Builds AND nodes in the given AIG, with constant propagation,
+/// trivial simplifications and structural hashing. Used by the
+/// netlist passes that construct a new AIG from an existing one,
+/// and for the gate primitives in convert_trans_to_netlistt.
+class aig_strasht
+{
+public:
+  explicit aig_strasht(aigt &_dest) : dest(_dest)
+  {
+  }
+
+  /// The AND of the literals, if it is trivial or already present.
+  /// Orders the operands as a side-effect.
+  std::optional<literalt> find_and(literalt &a, literalt &b) const
+  {
+    if(a.is_false() || b.is_false() || a == !b)
+      return const_literal(false);
+    if(a.is_true() || a == b)
+      return b;
+    if(b.is_true())
+      return a;
+
+    if(b.get() < a.get())
+      std::swap(a, b);
+
+    auto entry = and_nodes.find(key(a, b));
+    if(entry != and_nodes.end())
+      return entry->second;
+
+    return {};
+  }
+
+  /// Creates a new node, which must not be found by find_and.
+  literalt new_and_node(literalt a, literalt b)
+  {
+    literalt l = dest.new_and_node(a, b);
+    and_nodes.emplace(key(a, b), l);
+    return l;
+  }
+
+  literalt land(literalt a, literalt b)
+  {
+    auto found = find_and(a, b);
+    return found.has_value() ? *found : new_and_node(a, b);
+  }
+
+  literalt lor(literalt a, literalt b)
+  {
+    return !land(!a, !b);
+  }
+
+  literalt lxor(literalt a, literalt b)
+  {
+    return lor(land(a, !b), land(!a, b));
+  }
+
+  /// a ? b : c
+  literalt lselect(literalt a, literalt b, literalt c)
+  {
+    return lor(land(a, b), land(!a, c));
+  }
+
+protected:
+  aigt &dest;
+  std::unordered_map<std::uint64_t, literalt> and_nodes;
+
+  static std::uint64_t key(literalt a, literalt b)
+  {
+    return (std::uint64_t(a.get()) << 32) | b.get();
+  }
+};
+
+#endif // CPROVER_TRANS_NETLIST_AIG_STRASH_H
@@ -38,17 +38,85 @@ bmc_mapt::bmc_mapt(
     timeframe.resize(netlist.number_of_nodes());
 
     for(std::size_t n = 0; n < timeframe.size(); n++)
+      new_node(netlist, t, n, solver);
+  }
+}
+
+/*******************************************************************\
+
+Function: bmc_mapt::new_node
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void bmc_mapt::new_node(
+  const netlistt &netlist,
+  std::size_t t,
+  std::size_t n,
+  propt &solver)
+{
+  literalt solver_literal=solver.new_variable();
+  timeframe_map[t][n].solver_literal=solver_literal;
+
+  // keep a reverse map for variable nodes
+  if(netlist.nodes[n].is_var())
+  {
+    reverse_entryt &e=reverse_map[solver_literal];
+    e.timeframe=t;
+    e.netlist_literal=literalt(n, false);
+  }
+}
+
+/*******************************************************************\
+
+Function: bmc_mapt::add_timeframe
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Add a timeframe for incremental unwinding. The latches of
+          the new timeframe are not new variables, but the next-state
+          literals of the previous timeframe, and thus need no
+          constraints joining the timeframes.
+
+\*******************************************************************/
+
+void bmc_mapt::add_timeframe(const netlistt &netlist, propt &solver)
+{
+  const std::size_t t = timeframe_map.size();
+  timeframe_map.emplace_back();
+  timeframet &timeframe = timeframe_map.back();
+  timeframe.resize(netlist.number_of_nodes());
+
+  std::vector<bool> is_latch(timeframe.size(), false);
+
+  if(t != 0)
+  {
+    for(auto &var_it : netlist.var_map.map)
     {
-      literalt solver_literal=solver.new_variable();
-      timeframe[n].solver_literal=solver_literal;
+      if(!var_it.second.is_latch())
+        continue;
 
-      // keep a reverse map for variable nodes
-      if(netlist.nodes[n].is_var())
+      for(auto &bit : var_it.second.bits)
       {
-        reverse_entryt &e=reverse_map[solver_literal];
-        e.timeframe=t;
-        e.netlist_literal=literalt(n, false);
+        if(bit.current.is_constant())
+          continue;
+
+        auto n = bit.current.var_no();
+        timeframe[n].solver_literal =
+          translate(t - 1, bit.next) ^ bit.current.sign();
+        is_latch[n] = true;
       }
     }
   }
+
+  for(std::size_t n = 0; n < timeframe.size(); n++)
+    if(!is_latch[n])
+      new_node(netlist, t, n, solver);
 }
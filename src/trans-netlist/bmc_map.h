@@ -20,6 +20,13 @@ public:
   // this is number of cycles +1!
   bmc_mapt(const netlistt &, std::size_t no_timeframes, propt &);
 
+  // Add a timeframe, for incremental unwinding. The latches of
+  // the new timeframe are mapped to the next-state literals of the
+  // previous timeframe, and thus, these timeframes are not joined by
+  // unwind(). Those literals need to be frozen by the caller when
+  // the solver does variable elimination.
+  void add_timeframe(const netlistt &, propt &);
+
   inline literalt
   get(std::size_t timeframe, const var_mapt::vart::bitt &bit) const
   {
@@ -96,6 +103,13 @@ public:
     timeframe_map.clear();
     reverse_map.clear();
   }
+
+protected:
+  void new_node(
+    const netlistt &,
+    std::size_t timeframe,
+    std::size_t n,
+    propt &);
 };
 
 #endif
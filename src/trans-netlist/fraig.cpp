@@ -0,0 +1,448 @@
+/*******************************************************************\
+
+Module: SAT Sweeping of Netlists
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// SAT Sweeping of Netlists
+
+#include "fraig.h"
+
+#include <util/ebmc_statistics.h>
+
+#include <solvers/sat/satcheck.h>
+
+#include "aig_strash.h"
+#include "netlist.h"
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+
+class fraigt
+{
+public:
+  fraigt(netlistt &_netlist, message_handlert &_message_handler)
+    : netlist(_netlist), message(_message_handler), solver(_message_handler)
+  {
+  }
+
+  void operator()();
+
+protected:
+  netlistt &netlist;
+  messaget message;
+  satcheckt solver;
+
+  // the number of random words we start with, and the maximum
+  // number of words, including the ones from counterexamples
+  static constexpr std::size_t initial_words = 4;
+  static constexpr std::size_t max_words = 16;
+
+  // the maximum number of candidates tried for any one node
+  static constexpr std::size_t max_candidates = 4;
+
+  // the simulation values of the nodes of the original netlist,
+  // 'words' 64-bit words per node
+  std::size_t words = 0;
+  std::vector<std::uint64_t> sim;
+
+  // a word of counterexamples that is being filled
+  std::vector<std::uint64_t> pending;
+  std::size_t pending_count = 0;
+
+  // the new AIG
+  aigt dest;
+  aig_strasht strash{dest};
+  std::vector<literalt> dest_to_solver;
+
+  // from the nodes of the original netlist to the new AIG
+  std::vector<literalt> old_to_new;
+
+  // the original nodes that are kept, by simulation signature
+  std::vector<std::size_t> representatives;
+  std::unordered_map<std::size_t, std::vector<std::size_t>> classes;
+
+  std::size_t sat_calls = 0, merged = 0;
+
+  std::uint64_t sim_word(literalt l, std::size_t w) const
+  {
+    if(l.is_constant())
+      return l.is_true() ? ~std::uint64_t(0) : 0;
+
+    auto value = sim[l.var_no() * words + w];
+    return l.sign() ? ~value : value;
+  }
+
+  // the simulation values are normalized such that the
+  // first pattern is zero
+  bool phase(std::size_t n) const
+  {
+    return sim[n * words] & 1;
+  }
+
+  std::size_t signature(std::size_t n) const
+  {
+    std::uint64_t mask = phase(n) ? ~std::uint64_t(0) : 0;
+    std::size_t result = 0;
+    for(std::size_t w = 0; w < words; w++)
+      result = result * 1000003 ^ std::hash<std::uint64_t>{}(
+                                     sim[n * words + w] ^ mask);
+    return result;
+  }
+
+  bool is_constant_candidate(std::size_t n) const
+  {
+    std::uint64_t mask = phase(n) ? ~std::uint64_t(0) : 0;
+    for(std::size_t w = 0; w < words; w++)
+      if((sim[n * words + w] ^ mask) != 0)
+        return false;
+    return true;
+  }
+
+  bool same_simulation(std::size_t n, std::size_t r, bool negated) const
+  {
+    std::uint64_t mask = negated ? ~std::uint64_t(0) : 0;
+    for(std::size_t w = 0; w < words; w++)
+      if(sim[n * words + w] != (sim[r * words + w] ^ mask))
+        return false;
+    return true;
+  }
+
+  void simulate(std::size_t n);
+  void add_words(const std::vector<std::uint64_t> &var_words);
+  void rebuild_classes();
+
+  literalt to_solver(literalt l) const
+  {
+    if(l.is_constant())
+      return l;
+    return dest_to_solver[l.var_no()] ^ l.sign();
+  }
+
+  literalt map_literal(literalt l) const
+  {
+    if(l.is_constant())
+      return l;
+    return old_to_new[l.var_no()] ^ l.sign();
+  }
+
+  bool prove_equal(literalt, literalt);
+  void record_counterexample();
+};
+
+/*******************************************************************\
+
+Function: fraigt::simulate
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: compute the simulation values of an AND node
+
+\*******************************************************************/
+
+void fraigt::simulate(std::size_t n)
+{
+  const auto &node = netlist.nodes[n];
+
+  for(std::size_t w = 0; w < words; w++)
+    sim[n * words + w] = sim_word(node.a, w) & sim_word(node.b, w);
+}
+
+/*******************************************************************\
+
+Function: fraigt::add_words
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: extend the simulation by one word, with the given values
+          for the variable nodes, and re-simulate
+
+\*******************************************************************/
+
+void fraigt::add_words(const std::vector<std::uint64_t> &var_words)
+{
+  const std::size_t number_of_nodes = netlist.number_of_nodes();
+  const std::size_t new_words = words + 1;
+
+  std::vector<std::uint64_t> new_sim(number_of_nodes * new_words, 0);
+
+  for(std::size_t n = 0; n < number_of_nodes; n++)
+    if(netlist.nodes[n].is_var())
+    {
+      for(std::size_t w = 0; w < words; w++)
+        new_sim[n * new_words + w] = sim[n * words + w];
+      new_sim[n * new_words + words] = var_words[n];
+    }
+
+  sim.swap(new_sim);
+  words = new_words;
+
+  for(std::size_t n = 0; n < number_of_nodes; n++)
+    if(netlist.nodes[n].is_and())
+      simulate(n);
+}
+
+/*******************************************************************\
+
+Function: fraigt::rebuild_classes
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: re-sort the representatives after the simulation changed
+
+\*******************************************************************/
+
+void fraigt::rebuild_classes()
+{
+  classes.clear();
+
+  for(auto r : representatives)
+    classes[signature(r)].push_back(r);
+}
+
+/*******************************************************************\
+
+Function: fraigt::prove_equal
+
+  Inputs: two solver literals
+
+ Outputs: true if they are equivalent
+
+ Purpose:
+
+\*******************************************************************/
+
+bool fraigt::prove_equal(literalt sa, literalt sb)
+{
+  // look for an assignment with sa = value and sb = !value
+  for(bool value : {true, false})
+  {
+    literalt la = sa ^ !value, lb = sb ^ value;
+
+    // sb may be a constant
+    if(la.is_false() || lb.is_false())
+      continue;
+
+    bvt assumptions;
+    for(auto l : {la, lb})
+      if(!l.is_true())
+        assumptions.push_back(l);
+
+    sat_calls++;
+
+    switch(solver.prop_solve(assumptions))
+    {
+    case propt::resultt::P_SATISFIABLE:
+      record_counterexample();
+      return false;
+
+    case propt::resultt::P_UNSATISFIABLE:
+      break;
+
+    case propt::resultt::P_ERROR:
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*******************************************************************\
+
+Function: fraigt::record_counterexample
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: add the satisfying assignment to the pending simulation word
+
+\*******************************************************************/
+
+void fraigt::record_counterexample()
+{
+  if(words >= max_words)
+    return;
+
+  // The batch is full. It is flushed before the next node, as the
+  // classes can't be rebuilt while the candidates of a node are tried.
+  if(pending_count >= 64)
+    return;
+
+  const std::uint64_t bit = std::uint64_t(1) << pending_count;
+
+  for(std::size_t n = 0; n < old_to_new.size(); n++)
+  {
+    if(netlist.nodes[n].is_var())
+    {
+      if(solver.l_get(to_solver(old_to_new[n])).is_true())
+        pending[n] |= bit;
+      else
+        pending[n] &= ~bit;
+    }
+  }
+
+  pending_count++;
+}
+
+/*******************************************************************\
+
+Function: fraigt::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void fraigt::operator()()
+{
+  const std::size_t number_of_nodes = netlist.number_of_nodes();
+
+  // random simulation
+  words = initial_words;
+  sim.resize(number_of_nodes * words);
+
+  std::mt19937_64 random;
+
+  for(std::size_t n = 0; n < number_of_nodes; n++)
+  {
+    if(netlist.nodes[n].is_var())
+    {
+      for(std::size_t w = 0; w < words; w++)
+        sim[n * words + w] = random();
+    }
+    else
+      simulate(n);
+  }
+
+  pending.resize(number_of_nodes, 0);
+  old_to_new.reserve(number_of_nodes);
+
+  // The nodes are in topological order.
+  for(std::size_t n = 0; n < number_of_nodes; n++)
+  {
+    if(pending_count >= 64)
+    {
+      add_words(pending);
+      rebuild_classes();
+      pending_count = 0;
+    }
+
+    const auto &node = netlist.nodes[n];
+
+    if(node.is_var())
+    {
+      old_to_new.push_back(dest.new_var_node());
+      dest_to_solver.push_back(solver.new_variable());
+      representatives.push_back(n);
+      classes[signature(n)].push_back(n);
+      continue;
+    }
+
+    literalt a = map_literal(node.a), b = map_literal(node.b);
+
+    // simplified or structurally hashed to an existing node?
+    auto simplified = strash.find_and(a, b);
+    if(simplified.has_value())
+    {
+      old_to_new.push_back(*simplified);
+      continue;
+    }
+
+    // The node is encoded in the solver before it is created,
+    // and is only created if it turns out to be new.
+    literalt solver_literal = solver.land(to_solver(a), to_solver(b));
+    old_to_new.push_back(const_literal(false));
+
+    // a constant?
+    if(is_constant_candidate(n))
+    {
+      literalt constant = const_literal(phase(n));
+      if(prove_equal(solver_literal, constant))
+      {
+        old_to_new.back() = constant;
+        merged++;
+        continue;
+      }
+    }
+
+    // equivalent to a representative, or its negation?
+    auto &candidates = classes[signature(n)];
+    bool found = false;
+    std::size_t tried = 0;
+
+    for(auto r : candidates)
+    {
+      if(tried == max_candidates)
+        break;
+
+      bool negated = phase(n) != phase(r);
+
+      if(!same_simulation(n, r, negated))
+        continue;
+
+      tried++;
+
+      literalt target = old_to_new[r] ^ negated;
+
+      if(prove_equal(solver_literal, to_solver(target)))
+      {
+        old_to_new.back() = target;
+        found = true;
+        merged++;
+        break;
+      }
+    }
+
+    if(!found)
+    {
+      old_to_new.back() = strash.new_and_node(a, b);
+      dest_to_solver.push_back(solver_literal);
+      representatives.push_back(n);
+      candidates.push_back(n);
+    }
+  }
+
+  netlist.renumber(
+    std::move(dest.nodes), [this](literalt l) { return map_literal(l); });
+
+  message.statistics() << "Fraiging: " << merged << " nodes merged, "
+                       << sat_calls << " SAT calls" << messaget::eom;
+}
+
+/*******************************************************************\
+
+Function: fraig
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void fraig(netlistt &netlist, message_handlert &message_handler)
+{
+  ebmc_phaset phase("fraig");
+
+  const auto nodes_before = netlist.number_of_nodes();
+
+  fraigt{netlist, message_handler}();
+
+  ebmc_statistics().count(
+    "nodes removed", nodes_before - netlist.number_of_nodes());
+}
@@ -0,0 +1,30 @@
+/*******************************************************************\
+
+Module: SAT Sweeping of Netlists
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// SAT Sweeping of Netlists
+
+#ifndef CPROVER_TRANS_NETLIST_FRAIG_H
+#define CPROVER_TRANS_NETLIST_FRAIG_H
+
+#include <util/message.h>
+
+class netlistt;
+
+/// Merges functionally equivalent nodes of the netlist ("fraiging").
+/// Candidate equivalences, including equivalences with constants and
+/// with negations of other nodes, are obtained by bit-parallel random
+/// simulation, and are then proven or refuted with incremental SAT
+/// calls. Counterexamples to candidates are used to refine the
+/// simulation. The equivalences are combinational, i.e., the latches
+/// and inputs are treated as free variables, so the transition
+/// relation is preserved exactly. The nodes are renumbered, and the
+/// variable map, the constraints and the properties are updated.
+void fraig(netlistt &, message_handlert &);
+
+#endif // CPROVER_TRANS_NETLIST_FRAIG_H
@@ -0,0 +1,625 @@
+/*******************************************************************\
+
+Module: Writing Traces in FST Format
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Writing Traces in FST Format
+
+#include "fst_writer.h"
+
+#include <util/invariant.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <ostream>
+
+#ifdef HAVE_ZLIB
+#  include <zlib.h>
+#endif
+
+// block types
+static constexpr char FST_BL_HDR = 0;
+static constexpr char FST_BL_VCDATA = 1;
+static constexpr char FST_BL_GEOM = 3;
+static constexpr char FST_BL_HIER = 4;
+
+// hierarchy entries
+static constexpr char FST_ST_VCD_MODULE = 0;
+static constexpr char FST_ST_VCD_SCOPE = char(254);
+static constexpr char FST_ST_VCD_UPSCOPE = char(255);
+static constexpr char FST_VT_VCD_INTEGER = 1;
+static constexpr char FST_VT_VCD_REG = 5;
+static constexpr char FST_VT_VCD_WIRE = 16;
+static constexpr char FST_VD_IMPLICIT = 0;
+
+/*******************************************************************\
+
+Function: put_u64
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: big endian
+
+\*******************************************************************/
+
+static void put_u64(std::string &dest, std::uint64_t value)
+{
+  for(int shift = 56; shift >= 0; shift -= 8)
+    dest += char((value >> shift) & 0xff);
+}
+
+/*******************************************************************\
+
+Function: put_varint
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: LEB128, least significant group first
+
+\*******************************************************************/
+
+static void put_varint(std::string &dest, std::uint64_t value)
+{
+  while(value >= 0x80)
+  {
+    dest += char((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+
+  dest += char(value);
+}
+
+/*******************************************************************\
+
+Function: put_block
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the section length includes the length itself,
+          but not the block type
+
+\*******************************************************************/
+
+static void put_block(std::string &dest, char type, const std::string &body)
+{
+  dest += type;
+  put_u64(dest, body.size() + 8);
+  dest += body;
+}
+
+/*******************************************************************\
+
+Function: crc32
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::uint32_t crc32(const std::string &data)
+{
+  static const auto table = []() {
+    std::array<std::uint32_t, 256> table;
+    for(std::uint32_t i = 0; i < 256; i++)
+    {
+      std::uint32_t c = i;
+      for(int k = 0; k < 8; k++)
+        c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+      table[i] = c;
+    }
+    return table;
+  }();
+
+  std::uint32_t crc = 0xffffffff;
+
+  for(unsigned char ch : data)
+    crc = table[(crc ^ ch) & 0xff] ^ (crc >> 8);
+
+  return crc ^ 0xffffffff;
+}
+
+/*******************************************************************\
+
+Function: gzip_stored
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: a gzip member with stored (uncompressed) deflate blocks,
+          which is what the hierarchy block requires
+
+\*******************************************************************/
+
+static std::string gzip_stored(const std::string &data)
+{
+  auto put_u16_le = [](std::string &dest, std::uint32_t value) {
+    dest += char(value & 0xff);
+    dest += char((value >> 8) & 0xff);
+  };
+
+  // magic, deflate, no flags, no time, no extra flags, unknown OS
+  std::string result("\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10);
+
+  std::size_t pos = 0;
+
+  do
+  {
+    std::size_t len = std::min(data.size() - pos, std::size_t(0xffff));
+    bool final = pos + len == data.size();
+    result += char(final ? 1 : 0);
+    put_u16_le(result, len);
+    put_u16_le(result, ~len & 0xffff);
+    result.append(data, pos, len);
+    pos += len;
+  } while(pos != data.size());
+
+  std::uint32_t crc = crc32(data);
+  put_u16_le(result, crc & 0xffff);
+  put_u16_le(result, crc >> 16);
+  put_u16_le(result, data.size() & 0xffff);
+  put_u16_le(result, (data.size() >> 16) & 0xffff);
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: zlib_compress
+
+  Inputs:
+
+ Outputs: the zlib stream, or the empty string when the data
+          does not get smaller
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::string zlib_compress(const std::string &data)
+{
+#ifdef HAVE_ZLIB
+  uLongf size = compressBound(data.size());
+  std::string result(size, '\0');
+
+  if(
+    compress2(
+      reinterpret_cast<Bytef *>(result.data()),
+      &size,
+      reinterpret_cast<const Bytef *>(data.data()),
+      data.size(),
+      Z_DEFAULT_COMPRESSION) == Z_OK &&
+    size < data.size())
+  {
+    result.resize(size);
+    return result;
+  }
+#endif
+
+  return {};
+}
+
+/*******************************************************************\
+
+Function: fst_writert::same_design
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: are the definitions valid for the given trace?
+
+\*******************************************************************/
+
+bool fst_writert::same_design(const trans_tracet &trace) const
+{
+  if(identifiers.size() != trace.variables.size())
+    return false;
+
+  for(std::size_t v = 0; v < identifiers.size(); v++)
+    if(identifiers[v] != trace.variables[v].lhs.get_identifier())
+      return false;
+
+  return true;
+}
+
+/*******************************************************************\
+
+Function: fst_writert::hierarchy_rec
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void fst_writert::hierarchy_rec(
+  const waveform_scopet &scope,
+  std::string &dest)
+{
+  number_of_scopes++;
+
+  dest += FST_ST_VCD_SCOPE;
+  dest += FST_ST_VCD_MODULE;
+  dest += scope.name;
+  dest += '\0';
+  dest += '\0'; // no component name
+
+  for(auto &signal : scope.signals)
+  {
+    if(signal.signal_class == "integer")
+      dest += FST_VT_VCD_INTEGER;
+    else if(signal.signal_class == "reg")
+      dest += FST_VT_VCD_REG;
+    else
+      dest += FST_VT_VCD_WIRE;
+
+    dest += FST_VD_IMPLICIT;
+    dest += signal.reference;
+    if(!signal.suffix.empty())
+      dest += ' ' + signal.suffix;
+    dest += '\0';
+    put_varint(dest, signal.width);
+    put_varint(dest, 0); // not an alias, i.e., a new handle
+
+    handles.push_back({signal.variable, signal.width});
+  }
+
+  for(auto &sub_scope : scope.scopes)
+    hierarchy_rec(sub_scope, dest);
+
+  dest += FST_ST_VCD_UPSCOPE;
+}
+
+/*******************************************************************\
+
+Function: fst_writert::build_definitions
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void fst_writert::build_definitions(
+  const trans_tracet &trace,
+  const namespacet &ns)
+{
+  identifiers.clear();
+  identifiers.reserve(trace.variables.size());
+
+  for(auto &variable : trace.variables)
+    identifiers.push_back(variable.lhs.get_identifier());
+
+  handles.clear();
+  number_of_scopes = 0;
+
+  std::string hierarchy;
+  hierarchy_rec(waveform_hierarchy(trace, ns), hierarchy);
+
+  std::string body;
+  put_u64(body, hierarchy.size());
+  body += gzip_stored(hierarchy);
+  hierarchy_block.clear();
+  put_block(hierarchy_block, FST_BL_HIER, body);
+
+  // the widths of the handles, stored uncompressed
+  std::string geometry;
+  for(auto &handle : handles)
+    put_varint(geometry, handle.width);
+
+  body.clear();
+  put_u64(body, geometry.size());
+  put_u64(body, handles.size());
+  body += geometry;
+  geometry_block.clear();
+  put_block(geometry_block, FST_BL_GEOM, body);
+}
+
+/*******************************************************************\
+
+Function: fst_writert::value_change_block
+
+  Inputs: the timeframes from/to, and the values of the handles
+          before the first timeframe
+
+ Outputs: the values after the last timeframe
+
+ Purpose: Each handle gets a chain of changes, each with the distance
+          to the previous change in the time table of the block.
+          Single bits and vectors of 0/1 are packed.
+
+\*******************************************************************/
+
+void fst_writert::value_change_block(
+  const trans_tracet &trace,
+  const namespacet &ns,
+  std::size_t from,
+  std::size_t to,
+  std::vector<std::string> &values,
+  std::string &dest)
+{
+  // the values at the beginning of the block
+  std::string frame;
+  for(auto &value : values)
+    frame += value;
+
+  std::vector<std::string> chains(handles.size());
+  std::vector<std::size_t> previous(handles.size(), 0);
+  std::string value;
+
+  for(std::size_t t = from; t < to; t++)
+  {
+    const std::size_t index = t - from;
+
+    for(std::size_t h = 0; h < handles.size(); h++)
+    {
+      const auto &handle = handles[h];
+
+      if(!trace.value_changed(handle.variable, t))
+        continue;
+
+      value.clear();
+      waveform_value(trace, ns, handle.variable, t, value);
+      value.resize(handle.width, 'x');
+
+      if(value == values[h])
+        continue;
+
+      const std::uint64_t delta = index - previous[h];
+      previous[h] = index;
+      auto &chain = chains[h];
+
+      if(handle.width == 1)
+      {
+        if(value[0] == '0' || value[0] == '1')
+          put_varint(chain, (delta << 2) | ((value[0] - '0') << 1));
+        else
+          put_varint(chain, (delta << 4) | 1); // 'x'
+      }
+      else if(value.find('x') == std::string::npos)
+      {
+        put_varint(chain, delta << 1);
+        char byte = 0;
+        for(std::size_t i = 0; i < value.size(); i++)
+        {
+          if(value[i] == '1')
+            byte |= char(0x80 >> (i % 8));
+          if(i % 8 == 7 || i + 1 == value.size())
+          {
+            chain += byte;
+            byte = 0;
+          }
+        }
+      }
+      else
+      {
+        put_varint(chain, (delta << 1) | 1);
+        chain += value;
+      }
+
+      values[h].swap(value);
+    }
+  }
+
+  std::string body;
+  put_u64(body, from);
+  put_u64(body, to - 1);
+
+  // the memory the reader needs for the chains
+  std::size_t chain_size = 0;
+  for(auto &chain : chains)
+    chain_size += chain.size();
+  put_u64(body, chain_size);
+
+  // The frame, the chains and the time table are compressed
+  // when that makes them smaller.
+  auto frame_compressed = zlib_compress(frame);
+  put_varint(body, frame.size());
+  if(frame_compressed.empty())
+  {
+    put_varint(body, frame.size());
+    put_varint(body, handles.size());
+    body += frame;
+  }
+  else
+  {
+    put_varint(body, frame_compressed.size());
+    put_varint(body, handles.size());
+    body += frame_compressed;
+  }
+
+  put_varint(body, handles.size());
+
+  // the offsets of the chains are relative to the pack type
+  const std::size_t pack_type_position = body.size();
+  body += 'Z';
+
+  std::string chain_table;
+  std::size_t previous_offset = 0, empty = 0;
+
+  for(auto &chain : chains)
+  {
+    if(chain.empty())
+    {
+      empty++;
+      continue;
+    }
+
+    if(empty != 0)
+    {
+      put_varint(chain_table, empty << 1);
+      empty = 0;
+    }
+
+    const std::size_t offset = body.size() - pack_type_position;
+    put_varint(chain_table, ((offset - previous_offset) << 1) | 1);
+    previous_offset = offset;
+
+    // the uncompressed length, or zero when not compressed
+    auto chain_compressed = zlib_compress(chain);
+    if(chain_compressed.empty())
+    {
+      put_varint(body, 0);
+      body += chain;
+    }
+    else
+    {
+      put_varint(body, chain.size());
+      body += chain_compressed;
+    }
+  }
+
+  if(empty != 0)
+    put_varint(chain_table, empty << 1);
+
+  body += chain_table;
+  put_u64(body, chain_table.size());
+
+  // one entry per timeframe, the first one absolute
+  std::string time_table;
+  put_varint(time_table, from);
+  for(std::size_t t = from + 1; t < to; t++)
+    put_varint(time_table, 1);
+
+  auto time_table_compressed = zlib_compress(time_table);
+  body += time_table_compressed.empty() ? time_table : time_table_compressed;
+  put_u64(body, time_table.size());
+  put_u64(
+    body,
+    time_table_compressed.empty() ? time_table.size()
+                                  : time_table_compressed.size());
+  put_u64(body, to - from);
+
+  put_block(dest, FST_BL_VCDATA, body);
+}
+
+/*******************************************************************\
+
+Function: fst_writert::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void fst_writert::operator()(
+  const trans_tracet &trace,
+  const namespacet &ns,
+  std::ostream &out)
+{
+  const std::size_t timeframes =
+    trace.no_timeframes() == 0 ? 0 : trace.timeframes_to_show();
+
+  if(timeframes != 0 && !same_design(trace))
+    build_definitions(trace, ns);
+
+  // blocks of about one megabyte
+  std::size_t bits = 0;
+  for(auto &handle : handles)
+    bits += handle.width;
+
+  const std::size_t timeframes_per_block = std::max(
+    std::size_t(1), (std::size_t(8) << 20) / std::max(bits, std::size_t(1)));
+
+  const std::size_t number_of_blocks =
+    (timeframes + timeframes_per_block - 1) / timeframes_per_block;
+
+  std::string buffer;
+
+  // the header block
+  {
+    std::string body;
+    put_u64(body, 0);                                    // start time
+    put_u64(body, timeframes == 0 ? 0 : timeframes - 1); // end time
+    const double endian_test = 2.7182818284590452354;
+    body.append(reinterpret_cast<const char *>(&endian_test), 8);
+    put_u64(body, 0); // memory used by the writer
+    put_u64(body, timeframes == 0 ? 0 : number_of_scopes);
+    put_u64(body, timeframes == 0 ? 0 : handles.size()); // variables
+    put_u64(body, timeframes == 0 ? 0 : handles.size()); // max. handle
+    put_u64(body, number_of_blocks);
+    body += char(-9); // 1ns
+
+    std::string version = "EBMC";
+    version.resize(128, '\0');
+    body += version;
+
+    time_t t;
+    time(&t);
+    std::string date = ctime(&t);
+    date.resize(119, '\0');
+    body += date;
+
+    body += '\0';     // Verilog
+    put_u64(body, 0); // time zero
+
+    put_block(buffer, FST_BL_HDR, body);
+  }
+
+  if(timeframes == 0)
+  {
+    out.write(buffer.data(), buffer.size());
+    return;
+  }
+
+  std::vector<std::string> values;
+  values.reserve(handles.size());
+  for(auto &handle : handles)
+    values.emplace_back(handle.width, 'x');
+
+  for(std::size_t from = 0; from < timeframes; from += timeframes_per_block)
+  {
+    std::size_t to = std::min(from + timeframes_per_block, timeframes);
+    value_change_block(trace, ns, from, to, values, buffer);
+    out.write(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+
+  buffer += geometry_block;
+  buffer += hierarchy_block;
+  out.write(buffer.data(), buffer.size());
+}
+
+/*******************************************************************\
+
+Function: show_trans_trace_fst
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void show_trans_trace_fst(
+  const trans_tracet &trace,
+  messaget &,
+  const namespacet &ns,
+  std::ostream &out)
+{
+  fst_writert()(trace, ns, out);
+}
@@ -0,0 +1,68 @@
+/*******************************************************************\
+
+Module: Writing Traces in FST Format
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Writing Traces in FST Format
+
+#ifndef CPROVER_TRANS_NETLIST_FST_WRITER_H
+#define CPROVER_TRANS_NETLIST_FST_WRITER_H
+
+#include "vcd_writer.h"
+
+/// Writes traces in the FST format read by GTKWave and Surfer.
+/// The value changes are split into blocks that can be loaded
+/// separately. Vectors are stored as packed bits, and the times
+/// of changes as variable-length deltas. The value changes are
+/// compressed with zlib where that makes them smaller.
+/// As with VCD, the hierarchy is computed for the first trace, and
+/// is reused for all further traces over the same variables.
+class fst_writert
+{
+public:
+  /// write the trace as a complete FST file
+  void
+  operator()(const trans_tracet &, const namespacet &, std::ostream &);
+
+protected:
+  // the identifiers of the variables the definitions were built for
+  std::vector<irep_idt> identifiers;
+
+  // the signals in the order of the FST handles
+  struct handlet
+  {
+    std::size_t variable;
+    std::size_t width;
+  };
+
+  std::vector<handlet> handles;
+  std::size_t number_of_scopes = 0;
+
+  // the geometry and the hierarchy blocks
+  std::string geometry_block, hierarchy_block;
+
+  bool same_design(const trans_tracet &) const;
+  void build_definitions(const trans_tracet &, const namespacet &);
+  void hierarchy_rec(const waveform_scopet &, std::string &);
+
+  // the value change block for the given timeframes
+  void value_change_block(
+    const trans_tracet &,
+    const namespacet &,
+    std::size_t from,
+    std::size_t to,
+    std::vector<std::string> &values,
+    std::string &dest);
+};
+
+void show_trans_trace_fst(
+  const trans_tracet &,
+  messaget &,
+  const namespacet &,
+  std::ostream &);
+
+#endif // CPROVER_TRANS_NETLIST_FST_WRITER_H
@@ -0,0 +1,573 @@
+/*******************************************************************\
+
+Module: Invariant Mining for Netlists
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Invariant Mining for Netlists
+
+#include "invariant_mining.h"
+
+#include <util/ebmc_statistics.h>
+#include <util/threeval.h>
+
+#include <solvers/sat/satcheck.h>
+
+#include "netlist.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <random>
+#include <set>
+
+class invariant_miningt
+{
+public:
+  invariant_miningt(
+    const netlistt &_netlist,
+    message_handlert &_message_handler)
+    : netlist(_netlist), message(_message_handler)
+  {
+  }
+
+  std::vector<bvt> operator()();
+
+protected:
+  const netlistt &netlist;
+  messaget message;
+
+  struct latch_bitt
+  {
+    literalt current, next;
+    tvt initial;
+  };
+
+  std::vector<latch_bitt> latch_bits;
+
+  // the indices of the latch bits of the variables with more than one bit
+  std::vector<std::vector<std::size_t>> latch_vars;
+
+  // the values of the latch bits in the simulation, 64 runs per word
+  std::vector<std::vector<std::uint64_t>> signatures;
+
+  // Pairs are only considered among this many non-constant latch
+  // bits; beyond that, only pairs within the same variable.
+  static constexpr std::size_t max_pair_latches = 256;
+
+  void collect_latches();
+  void simulate();
+  std::vector<bvt> candidates();
+  void houdini_base(std::vector<bvt> &);
+  void houdini_step(std::vector<bvt> &);
+
+  // the literals of the netlist nodes in the given solver,
+  // for one timeframe
+  std::vector<literalt> encode(propt &) const;
+
+  // the literal of the latch bit that is true or false
+  literalt lit(std::size_t i, bool value) const
+  {
+    return latch_bits[i].current ^ !value;
+  }
+
+  // true iff the clause holds in all runs of the simulation
+  bool holds_in_simulation(const std::vector<std::size_t> &bits, bool value)
+    const;
+
+  static std::uint64_t
+  value(const std::vector<std::uint64_t> &values, literalt l)
+  {
+    if(l.is_constant())
+      return l.is_true() ? ~std::uint64_t(0) : 0;
+    auto v = values[l.var_no()];
+    return l.sign() ? ~v : v;
+  }
+
+  static tvt l_get(const propt &solver, literalt l)
+  {
+    return l.is_constant() ? tvt(l.is_true()) : solver.l_get(l);
+  }
+
+  // a clause over netlist literals as literal of the solver
+  static literalt clause_literal(
+    propt &solver,
+    const bvt &clause,
+    const std::function<literalt(literalt)> &map)
+  {
+    bvt literals;
+    literals.reserve(clause.size());
+    for(auto l : clause)
+      literals.push_back(map(l));
+    return solver.lor(literals);
+  }
+};
+
+/*******************************************************************\
+
+Function: invariant_miningt::collect_latches
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: collect the latch bits, with their initial values, where
+          these are given by a unit conjunct of the initial state
+
+\*******************************************************************/
+
+void invariant_miningt::collect_latches()
+{
+  std::map<std::size_t, tvt> initial_values;
+
+  // The initial state is given as one AND tree.
+  for(auto l : netlist.initial)
+    for(auto conjunct : netlist.conjuncts(l))
+      if(!conjunct.is_constant() && netlist.nodes[conjunct.var_no()].is_var())
+        initial_values[conjunct.var_no()] = tvt(!conjunct.sign());
+
+  for(const auto &[identifier, var] : netlist.var_map.map)
+  {
+    if(!var.is_latch())
+      continue;
+
+    std::vector<std::size_t> var_bits;
+
+    for(auto &bit : var.bits)
+    {
+      if(bit.current.is_constant())
+        continue;
+
+      auto initial_it = initial_values.find(bit.current.var_no());
+      auto initial = initial_it == initial_values.end()
+                       ? tvt::unknown()
+                       : initial_it->second;
+      if(bit.current.sign())
+        initial = !initial;
+
+      var_bits.push_back(latch_bits.size());
+      latch_bits.push_back({bit.current, bit.next, initial});
+    }
+
+    if(var_bits.size() >= 2)
+      latch_vars.push_back(std::move(var_bits));
+  }
+}
+
+/*******************************************************************\
+
+Function: invariant_miningt::simulate
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: bit-parallel random simulation from the initial state
+
+\*******************************************************************/
+
+void invariant_miningt::simulate()
+{
+  const std::size_t number_of_nodes = netlist.number_of_nodes();
+  const std::size_t steps = 32;
+
+  std::mt19937_64 random;
+
+  std::vector<std::uint64_t> state, values(number_of_nodes, 0);
+
+  for(auto &latch_bit : latch_bits)
+  {
+    if(latch_bit.initial.is_known())
+      state.push_back(latch_bit.initial.is_true() ? ~std::uint64_t(0) : 0);
+    else
+      state.push_back(random());
+  }
+
+  // from a node to the value of the node in the current state
+  std::map<std::size_t, std::size_t> latch_of_node;
+  for(std::size_t i = 0; i < latch_bits.size(); i++)
+    latch_of_node[latch_bits[i].current.var_no()] = i;
+
+  signatures.resize(latch_bits.size());
+
+  for(std::size_t step = 0; step < steps; step++)
+  {
+    for(std::size_t n = 0; n < number_of_nodes; n++)
+    {
+      const auto &node = netlist.nodes[n];
+      if(node.is_and())
+        values[n] = value(values, node.a) & value(values, node.b);
+      else
+      {
+        auto latch_it = latch_of_node.find(n);
+        if(latch_it == latch_of_node.end())
+          values[n] = random();
+        else if(latch_bits[latch_it->second].current.sign())
+          values[n] = ~state[latch_it->second];
+        else
+          values[n] = state[latch_it->second];
+      }
+    }
+
+    for(std::size_t i = 0; i < latch_bits.size(); i++)
+      signatures[i].push_back(state[i]);
+
+    for(std::size_t i = 0; i < latch_bits.size(); i++)
+      state[i] = value(values, latch_bits[i].next);
+  }
+}
+
+/*******************************************************************\
+
+Function: invariant_miningt::holds_in_simulation
+
+  Inputs: the latch bits of the clause, and their polarity
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool invariant_miningt::holds_in_simulation(
+  const std::vector<std::size_t> &bits,
+  bool value) const
+{
+  const auto mask = value ? 0 : ~std::uint64_t(0);
+
+  for(std::size_t step = 0; step < signatures.front().size(); step++)
+  {
+    std::uint64_t word = 0;
+    for(auto i : bits)
+      word |= signatures[i][step] ^ mask;
+    if(word != ~std::uint64_t(0))
+      return false;
+  }
+
+  return true;
+}
+
+/*******************************************************************\
+
+Function: invariant_miningt::candidates
+
+  Inputs:
+
+ Outputs: the candidate invariants, as clauses
+
+ Purpose: constant latches, clauses over pairs of latches, and
+          one-hot variables that hold in all runs of the simulation
+
+\*******************************************************************/
+
+std::vector<bvt> invariant_miningt::candidates()
+{
+  std::set<bvt> result;
+
+  auto add = [&result](bvt clause)
+  {
+    std::sort(clause.begin(), clause.end());
+    result.insert(std::move(clause));
+  };
+
+  std::vector<std::size_t> non_constant;
+
+  // constant latches
+  for(std::size_t i = 0; i < latch_bits.size(); i++)
+  {
+    if(holds_in_simulation({i}, true))
+      add({lit(i, true)});
+    else if(holds_in_simulation({i}, false))
+      add({lit(i, false)});
+    else
+      non_constant.push_back(i);
+  }
+
+  auto add_pairs = [&](std::size_t i, std::size_t j)
+  {
+    for(bool value_i : {false, true})
+      for(bool value_j : {false, true})
+      {
+        bool holds = true;
+        for(std::size_t step = 0; step < signatures[i].size() && holds; step++)
+        {
+          auto word_i = value_i ? signatures[i][step] : ~signatures[i][step];
+          auto word_j = value_j ? signatures[j][step] : ~signatures[j][step];
+          holds = (word_i | word_j) == ~std::uint64_t(0);
+        }
+
+        if(holds)
+          add({lit(i, value_i), lit(j, value_j)});
+      }
+  };
+
+  // implications and equivalences between pairs of latches
+  if(non_constant.size() <= max_pair_latches)
+  {
+    for(std::size_t a = 0; a < non_constant.size(); a++)
+      for(std::size_t b = a + 1; b < non_constant.size(); b++)
+        add_pairs(non_constant[a], non_constant[b]);
+  }
+  else
+  {
+    message.debug() << "invariant mining: too many latches for pairs"
+                    << messaget::eom;
+  }
+
+  // one-hot variables
+  for(auto &var_bits : latch_vars)
+  {
+    if(!holds_in_simulation(var_bits, true))
+      continue;
+
+    bvt at_least_one;
+    for(auto i : var_bits)
+      at_least_one.push_back(lit(i, true));
+    add(std::move(at_least_one));
+
+    // the at-most-one part, which is pairwise
+    if(non_constant.size() > max_pair_latches)
+      for(std::size_t a = 0; a < var_bits.size(); a++)
+        for(std::size_t b = a + 1; b < var_bits.size(); b++)
+          add_pairs(var_bits[a], var_bits[b]);
+  }
+
+  return {result.begin(), result.end()};
+}
+
+/*******************************************************************\
+
+Function: invariant_miningt::encode
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::vector<literalt> invariant_miningt::encode(propt &solver) const
+{
+  const std::size_t number_of_nodes = netlist.number_of_nodes();
+  std::vector<literalt> node_literals(number_of_nodes);
+
+  auto to_solver = [&node_literals](literalt l)
+  { return l.is_constant() ? l : node_literals[l.var_no()] ^ l.sign(); };
+
+  for(std::size_t n = 0; n < number_of_nodes; n++)
+  {
+    const auto &node = netlist.nodes[n];
+    if(node.is_and())
+      node_literals[n] = solver.land(to_solver(node.a), to_solver(node.b));
+    else
+      node_literals[n] = solver.new_variable();
+  }
+
+  for(auto l : netlist.constraints)
+    solver.l_set_to_true(to_solver(l));
+
+  return node_literals;
+}
+
+/*******************************************************************\
+
+Function: invariant_miningt::houdini_base
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: remove the candidates that fail in an initial state
+
+\*******************************************************************/
+
+void invariant_miningt::houdini_base(std::vector<bvt> &clauses)
+{
+  satcheckt solver{message.get_message_handler()};
+  auto node_literals = encode(solver);
+
+  auto to_solver = [&node_literals](literalt l)
+  { return l.is_constant() ? l : node_literals[l.var_no()] ^ l.sign(); };
+
+  for(auto l : netlist.initial)
+    for(auto conjunct : netlist.conjuncts(l))
+      solver.l_set_to_true(to_solver(conjunct));
+
+  std::vector<literalt> literals;
+  for(auto &clause : clauses)
+    literals.push_back(clause_literal(solver, clause, to_solver));
+
+  while(!clauses.empty())
+  {
+    bvt violated;
+    for(auto l : literals)
+      violated.push_back(!l);
+
+    switch(solver.prop_solve({solver.lor(violated)}))
+    {
+    case propt::resultt::P_UNSATISFIABLE:
+      return;
+
+    case propt::resultt::P_SATISFIABLE:
+    {
+      // keep the candidates that hold in the initial state of the model
+      std::size_t j = 0;
+      for(std::size_t k = 0; k < clauses.size(); k++)
+      {
+        if(!l_get(solver, literals[k]).is_false())
+        {
+          clauses[j] = std::move(clauses[k]);
+          literals[j] = literals[k];
+          j++;
+        }
+      }
+      clauses.resize(j);
+      literals.resize(j);
+      break;
+    }
+
+    case propt::resultt::P_ERROR:
+      clauses.clear();
+      return;
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: invariant_miningt::houdini_step
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the candidates are assumed in the current state and checked
+          in the next state, removing the candidates that fail until
+          the remaining ones are mutually inductive
+
+\*******************************************************************/
+
+void invariant_miningt::houdini_step(std::vector<bvt> &clauses)
+{
+  satcheckt solver{message.get_message_handler()};
+  auto node_literals = encode(solver);
+
+  auto to_solver = [&node_literals](literalt l)
+  { return l.is_constant() ? l : node_literals[l.var_no()] ^ l.sign(); };
+
+  for(auto l : netlist.transition)
+    solver.l_set_to_true(to_solver(l));
+
+  // from a latch node to its next-state literal in the solver
+  std::map<std::size_t, literalt> next_of_node;
+  for(auto &latch_bit : latch_bits)
+    next_of_node[latch_bit.current.var_no()] =
+      to_solver(latch_bit.next) ^ latch_bit.current.sign();
+
+  auto to_solver_next = [&next_of_node](literalt l)
+  { return next_of_node.at(l.var_no()) ^ l.sign(); };
+
+  std::vector<literalt> current_literals, next_literals;
+  for(auto &clause : clauses)
+  {
+    current_literals.push_back(clause_literal(solver, clause, to_solver));
+    next_literals.push_back(clause_literal(solver, clause, to_solver_next));
+  }
+
+  while(!clauses.empty())
+  {
+    bvt assumptions = current_literals, violated;
+    for(auto l : next_literals)
+      violated.push_back(!l);
+    assumptions.push_back(solver.lor(violated));
+
+    switch(solver.prop_solve(assumptions))
+    {
+    case propt::resultt::P_UNSATISFIABLE:
+      return;
+
+    case propt::resultt::P_SATISFIABLE:
+    {
+      // keep the candidates that hold in the next state of the model
+      std::size_t j = 0;
+      for(std::size_t k = 0; k < clauses.size(); k++)
+      {
+        if(!l_get(solver, next_literals[k]).is_false())
+        {
+          clauses[j] = std::move(clauses[k]);
+          current_literals[j] = current_literals[k];
+          next_literals[j] = next_literals[k];
+          j++;
+        }
+      }
+      clauses.resize(j);
+      current_literals.resize(j);
+      next_literals.resize(j);
+      break;
+    }
+
+    case propt::resultt::P_ERROR:
+      clauses.clear();
+      return;
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: invariant_miningt::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::vector<bvt> invariant_miningt::operator()()
+{
+  collect_latches();
+
+  if(latch_bits.empty())
+    return {};
+
+  simulate();
+
+  auto clauses = candidates();
+
+  message.statistics() << "Invariant candidates: " << clauses.size()
+                       << messaget::eom;
+  ebmc_statistics().count("invariant candidates", clauses.size());
+
+  houdini_base(clauses);
+  houdini_step(clauses);
+
+  message.statistics() << "Invariants: " << clauses.size() << messaget::eom;
+  ebmc_statistics().count("invariants", clauses.size());
+
+  return clauses;
+}
+
+/*******************************************************************\
+
+Function: mine_invariants
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::vector<bvt>
+mine_invariants(const netlistt &netlist, message_handlert &message_handler)
+{
+  return invariant_miningt{netlist, message_handler}();
+}
@@ -0,0 +1,34 @@
+/*******************************************************************\
+
+Module: Invariant Mining for Netlists
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Invariant Mining for Netlists
+
+#ifndef CPROVER_TRANS_NETLIST_INVARIANT_MINING_H
+#define CPROVER_TRANS_NETLIST_INVARIANT_MINING_H
+
+#include <util/message.h>
+
+#include <solvers/prop/literal.h>
+
+#include <vector>
+
+class netlistt;
+
+/// Mines invariants over the latches of the netlist.
+/// The candidates are constant latches, clauses over pairs of latches
+/// (implications and equivalences), and one-hot encodings of
+/// variables, as suggested by bit-parallel random simulation from the
+/// initial state. The largest subset of the candidates that holds
+/// initially and is mutually inductive is computed with one
+/// incremental SAT solver (Houdini).
+/// Returns the invariants as clauses over the current-state
+/// literals of the latches.
+std::vector<bvt> mine_invariants(const netlistt &, message_handlert &);
+
+#endif // CPROVER_TRANS_NETLIST_INVARIANT_MINING_H
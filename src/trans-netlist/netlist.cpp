@@ -9,6 +9,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "netlist.h"
 
 #include <solvers/flattening/boolbv_width.h>
+#include <solvers/prop/literal_expr.h>
 
 #include <ctype.h>
 #include <sstream>
@@ -218,3 +219,64 @@ void netlistt::output_dot(std::ostream &out) const
     }
   }
 }
+
+/*******************************************************************\
+
+Function: netlistt::renumber
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void netlistt::renumber(
+  nodest &&new_nodes,
+  const std::function<literalt(literalt)> &map_literal)
+{
+  nodes = std::move(new_nodes);
+
+  for(auto &l : constraints)
+    l = map_literal(l);
+
+  for(auto &l : initial)
+    l = map_literal(l);
+
+  for(auto &l : transition)
+    l = map_literal(l);
+
+  for(auto &var_it : var_map.map)
+    for(auto &bit : var_it.second.bits)
+    {
+      bit.current = map_literal(bit.current);
+      bit.next = map_literal(bit.next);
+    }
+
+  // the sets of variables are keyed by node number
+  var_map.reverse_map.clear();
+  var_map.latches.clear();
+  var_map.inputs.clear();
+  var_map.outputs.clear();
+  var_map.wires.clear();
+  var_map.nondets.clear();
+  var_map.build_reverse_map();
+
+  std::function<void(exprt &)> map_expr = [&](exprt &expr) {
+    if(expr.id() == ID_literal)
+    {
+      auto &literal_expr = to_literal_expr(expr);
+      literal_expr.set_literal(map_literal(literal_expr.get_literal()));
+    }
+    else
+    {
+      for(auto &op : expr.operands())
+        map_expr(op);
+    }
+  };
+
+  for(auto &property_it : properties)
+    if(property_it.second.has_value())
+      map_expr(property_it.second.value());
+}
@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "aig.h"
 #include "var_map.h"
 
+#include <functional>
 #include <iosfwd>
 #include <variant>
 
@@ -41,6 +42,11 @@ public:
   virtual std::string label(unsigned n) const;
   virtual std::string dot_label(unsigned n) const;
   
+  // Replaces the nodes by the given ones, and maps the literals
+  // in the variable map, the constraints and the properties
+  // using the given function.
+  void renumber(nodest &&, const std::function<literalt(literalt)> &);
+
   void swap(netlistt &other)
   {
     aigt::swap(other);
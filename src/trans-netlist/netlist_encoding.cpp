@@ -0,0 +1,295 @@
+/*******************************************************************\
+
+Module: Polarity-Aware CNF Encoding of Netlists
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Polarity-Aware CNF Encoding of Netlists
+
+#include "netlist_encoding.h"
+
+#include <solvers/prop/literal_expr.h>
+
+#include <algorithm>
+
+/*******************************************************************\
+
+Function: netlist_encodingt::netlist_encodingt
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Compute the polarities of the nodes and the gates,
+          from the outputs towards the inputs
+
+\*******************************************************************/
+
+netlist_encodingt::netlist_encodingt(const netlistt &netlist)
+{
+  const auto &nodes = netlist.nodes;
+
+  std::vector<unsigned> polarity(nodes.size(), 0);
+  std::vector<std::size_t> fanout(nodes.size(), 0);
+  std::vector<bool> is_root(nodes.size(), false);
+  std::vector<bool> absorbed(nodes.size(), false);
+
+  auto add_polarity = [&](literalt l, unsigned p) {
+    if(!l.is_constant())
+      polarity[l.var_no()] |= l.sign() ? flip(p) : p;
+  };
+
+  auto add_root = [&](literalt l, unsigned p) {
+    if(l.is_constant())
+      return;
+    add_polarity(l, p);
+    is_root[l.var_no()] = true;
+  };
+
+  for(auto *constraints :
+      {&netlist.constraints, &netlist.initial, &netlist.transition})
+  {
+    for(auto l : *constraints)
+      add_root(l, POS);
+  }
+
+  for(auto &var_it : netlist.var_map.map)
+    for(auto &bit : var_it.second.bits)
+    {
+      add_root(bit.current, POS | NEG);
+      if(var_it.second.is_latch())
+        add_root(bit.next, POS | NEG);
+    }
+
+  for(auto &property_it : netlist.properties)
+    if(property_it.second.has_value())
+    {
+      property_it.second->visit_pre([&add_root](const exprt &expr) {
+        if(expr.id() == ID_literal)
+          add_root(to_literal_expr(expr).get_literal(), POS | NEG);
+      });
+    }
+
+  for(auto &node : nodes)
+    if(node.is_and())
+    {
+      if(!node.a.is_constant())
+        fanout[node.a.var_no()]++;
+      if(!node.b.is_constant())
+        fanout[node.b.var_no()]++;
+    }
+
+  // Can the node of the literal be folded into the gate of its
+  // only user?
+  auto absorbable = [&](literalt l) {
+    return !l.is_constant() && nodes[l.var_no()].is_and() &&
+           fanout[l.var_no()] == 1 && !is_root[l.var_no()];
+  };
+
+  // The users of a node have larger numbers than the node.
+  for(std::size_t n = nodes.size(); n-- != 0;)
+  {
+    auto &node = nodes[n];
+
+    if(!node.is_and())
+      continue;
+
+    if(absorbed[n])
+    {
+      statistics.absorbed++;
+      continue;
+    }
+
+    if(polarity[n] == 0)
+    {
+      statistics.unused++;
+      continue;
+    }
+
+    gatet gate;
+    gate.node = n;
+    gate.polarity = polarity[n];
+
+    // n = !(s & t) & !(!s & e) = !(s ? t : e)
+    if(
+      node.a.sign() && node.b.sign() && absorbable(node.a) &&
+      absorbable(node.b))
+    {
+      auto &x = nodes[node.a.var_no()];
+      auto &y = nodes[node.b.var_no()];
+
+      for(auto [s, t] : {std::pair{x.a, x.b}, std::pair{x.b, x.a}})
+      {
+        if(s.is_constant())
+          continue;
+        if(s == !y.a)
+          gate.inputs = {s, t, y.b};
+        else if(s == !y.b)
+          gate.inputs = {s, t, y.a};
+        else
+          continue;
+        break;
+      }
+    }
+
+    if(gate.inputs.size() == 3)
+    {
+      absorbed[node.a.var_no()] = true;
+      absorbed[node.b.var_no()] = true;
+
+      literalt s = gate.inputs[0], t = gate.inputs[1], e = gate.inputs[2];
+
+      if(e == !t)
+      {
+        // n = !(s ? t : !t) = s ^ t
+        gate.kind = kindt::XOR;
+        gate.inputs = {s, t};
+        add_polarity(s, POS | NEG);
+        add_polarity(t, POS | NEG);
+        statistics.xor_gates++;
+      }
+      else
+      {
+        gate.kind = kindt::MUX;
+        // the mux is the negation of the node
+        unsigned mux_polarity = flip(gate.polarity);
+        add_polarity(s, POS | NEG);
+        add_polarity(t, mux_polarity);
+        add_polarity(e, mux_polarity);
+        statistics.mux_gates++;
+      }
+    }
+    else
+    {
+      // collect the conjuncts, folding AND nodes that are used
+      // only here
+      gate.kind = kindt::AND;
+      bvt stack = {node.b, node.a};
+
+      while(!stack.empty())
+      {
+        literalt l = stack.back();
+        stack.pop_back();
+
+        if(!l.sign() && absorbable(l))
+        {
+          absorbed[l.var_no()] = true;
+          stack.push_back(nodes[l.var_no()].b);
+          stack.push_back(nodes[l.var_no()].a);
+        }
+        else
+        {
+          gate.inputs.push_back(l);
+          add_polarity(l, gate.polarity);
+        }
+      }
+
+      if(gate.inputs.size() > 2)
+        statistics.wide_and_gates++;
+      else
+        statistics.and_gates++;
+    }
+
+    if(gate.polarity != (POS | NEG))
+      statistics.one_sided++;
+
+    gates.push_back(std::move(gate));
+  }
+
+  // emit the gates in the order of the nodes
+  std::reverse(gates.begin(), gates.end());
+}
+
+/*******************************************************************\
+
+Function: netlist_encodingt::encode
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void netlist_encodingt::encode(
+  const bmc_mapt &bmc_map,
+  cnft &solver,
+  std::size_t timeframe) const
+{
+  for(auto &gate : gates)
+  {
+    literalt o = bmc_map.get(timeframe, gate.node);
+    bvt inputs;
+    inputs.reserve(gate.inputs.size());
+    for(auto l : gate.inputs)
+      inputs.push_back(bmc_map.translate(timeframe, l));
+
+    const bool pos = gate.polarity & POS, neg = gate.polarity & NEG;
+
+    switch(gate.kind)
+    {
+    case kindt::AND:
+      if(pos)
+      {
+        for(auto i : inputs)
+          solver.lcnf({!o, i});
+      }
+
+      if(neg)
+      {
+        bvt clause;
+        clause.reserve(inputs.size() + 1);
+        clause.push_back(o);
+        for(auto i : inputs)
+          clause.push_back(!i);
+        solver.lcnf(clause);
+      }
+      break;
+
+    case kindt::XOR:
+    {
+      // o = a ^ b
+      literalt a = inputs[0], b = inputs[1];
+
+      if(pos)
+      {
+        solver.lcnf({!o, a, b});
+        solver.lcnf({!o, !a, !b});
+      }
+
+      if(neg)
+      {
+        solver.lcnf({o, !a, b});
+        solver.lcnf({o, a, !b});
+      }
+    }
+    break;
+
+    case kindt::MUX:
+    {
+      // !o = s ? t : e, including the redundant clauses,
+      // which help propagation
+      literalt s = inputs[0], t = inputs[1], e = inputs[2];
+
+      if(neg)
+      {
+        solver.lcnf({o, !s, t});
+        solver.lcnf({o, s, e});
+        solver.lcnf({o, t, e});
+      }
+
+      if(pos)
+      {
+        solver.lcnf({!o, !s, !t});
+        solver.lcnf({!o, s, !e});
+        solver.lcnf({!o, !t, !e});
+      }
+    }
+    break;
+    }
+  }
+}
@@ -0,0 +1,80 @@
+/*******************************************************************\
+
+Module: Polarity-Aware CNF Encoding of Netlists
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Polarity-Aware CNF Encoding of Netlists
+
+#ifndef CPROVER_TRANS_NETLIST_NETLIST_ENCODING_H
+#define CPROVER_TRANS_NETLIST_NETLIST_ENCODING_H
+
+#include <solvers/sat/cnf.h>
+
+#include "bmc_map.h"
+#include "netlist.h"
+
+/// A CNF encoding for the AND nodes of a netlist, computed once and
+/// then emitted per timeframe.
+/// Nodes are encoded only in the polarities in which they are used
+/// (Plaisted-Greenbaum), starting from the constraints, the
+/// transition and initial-state constraints (positive), and the
+/// next-state functions of the latches, the wires and the properties
+/// (both polarities, which keeps the values in traces exact).
+/// Nodes outside of the cone of these roots get no clauses.
+/// XOR/XNOR and MUX/ITE structures over three AND nodes, and trees of
+/// AND nodes with single fanout, are encoded as one gate.
+class netlist_encodingt
+{
+public:
+  explicit netlist_encodingt(const netlistt &);
+
+  /// add the clauses for the AND nodes of the given timeframe
+  void encode(const bmc_mapt &, cnft &, std::size_t timeframe) const;
+
+  struct statisticst
+  {
+    std::size_t and_gates = 0, wide_and_gates = 0, xor_gates = 0,
+                mux_gates = 0, one_sided = 0, absorbed = 0, unused = 0;
+  };
+
+  const statisticst &get_statistics() const
+  {
+    return statistics;
+  }
+
+protected:
+  enum class kindt
+  {
+    AND,
+    XOR,
+    MUX
+  };
+
+  // polarities, as bits
+  static constexpr unsigned POS = 1, NEG = 2;
+
+  static unsigned flip(unsigned polarity)
+  {
+    return ((polarity & POS) ? NEG : 0) | ((polarity & NEG) ? POS : 0);
+  }
+
+  struct gatet
+  {
+    kindt kind;
+    unsigned node;
+    unsigned polarity;
+    // AND: the conjuncts; XOR: a, b; MUX: select, then, else.
+    // The node is the output of AND and XOR gates, and the
+    // negated output of MUX gates.
+    bvt inputs;
+  };
+
+  std::vector<gatet> gates;
+  statisticst statistics;
+};
+
+#endif // CPROVER_TRANS_NETLIST_NETLIST_ENCODING_H
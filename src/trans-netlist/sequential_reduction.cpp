@@ -0,0 +1,635 @@
+/*******************************************************************\
+
+Module: Sequential Reduction of Netlists
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Sequential Reduction of Netlists
+
+#include "sequential_reduction.h"
+
+#include <util/ebmc_statistics.h>
+#include <util/invariant.h>
+#include <util/threeval.h>
+
+#include <solvers/sat/satcheck.h>
+
+#include "aig_strash.h"
+#include "netlist.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <random>
+
+class sequential_reductiont
+{
+public:
+  sequential_reductiont(netlistt &_netlist, message_handlert &_message_handler)
+    : netlist(_netlist), message(_message_handler)
+  {
+  }
+
+  void operator()();
+
+protected:
+  netlistt &netlist;
+  messaget message;
+
+  struct latch_bitt
+  {
+    std::size_t node; // the variable node of the current value
+    literalt next;
+    tvt initial;
+  };
+
+  std::vector<latch_bitt> latch_bits;
+
+  // from a node to its index in latch_bits, or latch_bits.size()
+  std::vector<std::size_t> latch_of_node;
+
+  // replacements for variable nodes of the netlist
+  std::vector<std::optional<literalt>> substitution;
+
+  using classt = std::vector<std::size_t>; // indices into latch_bits
+  using classest = std::vector<classt>;
+
+  std::size_t stuck_inputs = 0, constant_latches = 0, equivalent_latches = 0;
+
+  void collect_latches();
+  void find_stuck_inputs();
+  void find_constant_latches();
+  void find_equivalent_latches();
+  classest simulate_from_initial_state() const;
+  void apply();
+
+  // literal is asserted in every timeframe
+  void stuck_input(literalt);
+
+  static tvt value(const std::vector<tvt> &values, literalt l)
+  {
+    if(l.is_constant())
+      return tvt(l.is_true());
+    auto v = values[l.var_no()];
+    return l.sign() ? !v : v;
+  }
+
+  static std::uint64_t
+  value(const std::vector<std::uint64_t> &values, literalt l)
+  {
+    if(l.is_constant())
+      return l.is_true() ? ~std::uint64_t(0) : 0;
+    auto v = values[l.var_no()];
+    return l.sign() ? ~v : v;
+  }
+
+  bool is_constant_substitution(std::size_t n) const
+  {
+    return substitution[n].has_value() && substitution[n]->is_constant();
+  }
+};
+
+/*******************************************************************\
+
+Function: sequential_reductiont::collect_latches
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: collect the latch bits, with their initial values, where
+          these are given by a unit conjunct of the initial state
+
+\*******************************************************************/
+
+void sequential_reductiont::collect_latches()
+{
+  std::map<std::size_t, tvt> initial_values;
+
+  // The initial state is given as one AND tree.
+  for(auto l : netlist.initial)
+    for(auto conjunct : netlist.conjuncts(l))
+      if(!conjunct.is_constant() && netlist.nodes[conjunct.var_no()].is_var())
+        initial_values[conjunct.var_no()] = tvt(!conjunct.sign());
+
+  for(const auto &[identifier, var] : netlist.var_map.map)
+  {
+    if(!var.is_latch())
+      continue;
+
+    for(auto &bit : var.bits)
+    {
+      auto node = bit.current.var_no();
+      auto initial_it = initial_values.find(node);
+      latch_bits.push_back(
+        {node,
+         bit.next,
+         initial_it == initial_values.end() ? tvt::unknown()
+                                            : initial_it->second});
+    }
+  }
+
+  // deterministic order, independent of the hashing of identifiers
+  std::sort(
+    latch_bits.begin(),
+    latch_bits.end(),
+    [](const latch_bitt &a, const latch_bitt &b) { return a.node < b.node; });
+
+  latch_of_node.resize(netlist.number_of_nodes(), latch_bits.size());
+
+  for(std::size_t i = 0; i < latch_bits.size(); i++)
+    latch_of_node[latch_bits[i].node] = i;
+}
+
+/*******************************************************************\
+
+Function: sequential_reductiont::stuck_input
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void sequential_reductiont::stuck_input(literalt l)
+{
+  if(l.is_constant())
+    return;
+
+  auto node = l.var_no();
+  const auto &var_map = netlist.var_map;
+
+  if(
+    netlist.nodes[node].is_var() && !substitution[node].has_value() &&
+    (var_map.inputs.count(node) != 0 || var_map.nondets.count(node) != 0))
+  {
+    substitution[node] = const_literal(!l.sign());
+    stuck_inputs++;
+  }
+}
+
+/*******************************************************************\
+
+Function: sequential_reductiont::find_stuck_inputs
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void sequential_reductiont::find_stuck_inputs()
+{
+  for(auto l : netlist.constraints)
+    for(auto conjunct : netlist.conjuncts(l))
+      stuck_input(conjunct);
+
+  for(auto l : netlist.transition)
+    for(auto conjunct : netlist.conjuncts(l))
+      stuck_input(conjunct);
+}
+
+/*******************************************************************\
+
+Function: sequential_reductiont::find_constant_latches
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: ternary simulation from the initial state; the latches
+          that are not X in the fixed-point are constant
+
+\*******************************************************************/
+
+void sequential_reductiont::find_constant_latches()
+{
+  const std::size_t number_of_nodes = netlist.number_of_nodes();
+
+  std::vector<tvt> state;
+  state.reserve(latch_bits.size());
+  for(auto &latch_bit : latch_bits)
+    state.push_back(latch_bit.initial);
+
+  std::vector<tvt> values(number_of_nodes, tvt::unknown());
+
+  // Each iteration but the last turns at least one latch into X,
+  // hence the fixed-point is reached after at most this many.
+  const std::size_t max_iterations = latch_bits.size() + 1;
+
+  for(std::size_t iteration = 0; iteration < max_iterations; iteration++)
+  {
+    for(std::size_t n = 0; n < number_of_nodes; n++)
+    {
+      const auto &node = netlist.nodes[n];
+      if(node.is_and())
+        values[n] = value(values, node.a) && value(values, node.b);
+      else if(is_constant_substitution(n))
+        values[n] = tvt(substitution[n]->is_true());
+      else if(latch_of_node[n] != latch_bits.size())
+        values[n] = state[latch_of_node[n]];
+      else
+        values[n] = tvt::unknown();
+    }
+
+    bool changed = false;
+
+    for(std::size_t i = 0; i < latch_bits.size(); i++)
+    {
+      if(!state[i].is_known())
+        continue;
+
+      auto next = value(values, latch_bits[i].next);
+
+      if(next.get_value() != state[i].get_value())
+      {
+        state[i] = tvt::unknown();
+        changed = true;
+      }
+    }
+
+    if(!changed)
+    {
+      for(std::size_t i = 0; i < latch_bits.size(); i++)
+        if(state[i].is_known())
+        {
+          substitution[latch_bits[i].node] = const_literal(state[i].is_true());
+          constant_latches++;
+        }
+
+      return;
+    }
+  }
+
+  UNREACHABLE;
+}
+
+/*******************************************************************\
+
+Function: sequential_reductiont::simulate_from_initial_state
+
+  Inputs:
+
+ Outputs: the candidate classes of equivalent latches
+
+ Purpose: bit-parallel random simulation from the initial state;
+          the values of a latch are normalized by its initial value
+
+\*******************************************************************/
+
+sequential_reductiont::classest
+sequential_reductiont::simulate_from_initial_state() const
+{
+  const std::size_t number_of_nodes = netlist.number_of_nodes();
+  const std::size_t steps = 32;
+
+  std::mt19937_64 random;
+
+  std::vector<std::uint64_t> state, values(number_of_nodes, 0);
+
+  for(auto &latch_bit : latch_bits)
+  {
+    if(latch_bit.initial.is_known())
+      state.push_back(latch_bit.initial.is_true() ? ~std::uint64_t(0) : 0);
+    else
+      state.push_back(random());
+  }
+
+  std::vector<std::vector<std::uint64_t>> signatures(latch_bits.size());
+
+  for(std::size_t step = 0; step < steps; step++)
+  {
+    for(std::size_t n = 0; n < number_of_nodes; n++)
+    {
+      const auto &node = netlist.nodes[n];
+      if(node.is_and())
+        values[n] = value(values, node.a) & value(values, node.b);
+      else if(substitution[n].has_value())
+        values[n] = value(values, *substitution[n]);
+      else if(latch_of_node[n] != latch_bits.size())
+        values[n] = state[latch_of_node[n]];
+      else
+        values[n] = random();
+    }
+
+    for(std::size_t i = 0; i < latch_bits.size(); i++)
+    {
+      const auto &latch_bit = latch_bits[i];
+      auto mask = latch_bit.initial.is_true() ? ~std::uint64_t(0) : 0;
+      signatures[i].push_back(values[latch_bit.node] ^ mask);
+    }
+
+    for(std::size_t i = 0; i < latch_bits.size(); i++)
+      state[i] = value(values, latch_bits[i].next);
+  }
+
+  // Candidates need a known initial value for the base case.
+  std::map<std::vector<std::uint64_t>, classt> by_signature;
+
+  for(std::size_t i = 0; i < latch_bits.size(); i++)
+    if(
+      latch_bits[i].initial.is_known() &&
+      !substitution[latch_bits[i].node].has_value())
+    {
+      by_signature[signatures[i]].push_back(i);
+    }
+
+  classest classes;
+
+  for(auto &entry : by_signature)
+    if(entry.second.size() >= 2)
+      classes.push_back(std::move(entry.second));
+
+  return classes;
+}
+
+/*******************************************************************\
+
+Function: sequential_reductiont::find_equivalent_latches
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: signal correspondence: the candidate equivalences are
+          assumed in the current state and checked in the next
+          state, refining the candidates until they are inductive
+
+\*******************************************************************/
+
+void sequential_reductiont::find_equivalent_latches()
+{
+  classest classes = simulate_from_initial_state();
+
+  if(classes.empty())
+    return;
+
+  const std::size_t number_of_nodes = netlist.number_of_nodes();
+
+  satcheckt solver{message.get_message_handler()};
+  std::vector<literalt> node_literals(number_of_nodes);
+
+  auto to_solver = [&node_literals](literalt l) {
+    return l.is_constant() ? l : node_literals[l.var_no()] ^ l.sign();
+  };
+
+  for(std::size_t n = 0; n < number_of_nodes; n++)
+  {
+    const auto &node = netlist.nodes[n];
+    if(node.is_and())
+      node_literals[n] = solver.land(to_solver(node.a), to_solver(node.b));
+    else if(is_constant_substitution(n))
+      node_literals[n] = *substitution[n];
+    else
+      node_literals[n] = solver.new_variable();
+  }
+
+  for(auto l : netlist.constraints)
+    solver.l_set_to_true(to_solver(l));
+
+  for(auto l : netlist.transition)
+    solver.l_set_to_true(to_solver(l));
+
+  auto current = [&](std::size_t i) {
+    return node_literals[latch_bits[i].node];
+  };
+
+  auto next = [&](std::size_t i) { return to_solver(latch_bits[i].next); };
+
+  // the relative polarity of two latches in a class
+  auto phase = [&](std::size_t i, std::size_t r) {
+    return latch_bits[i].initial.get_value() !=
+           latch_bits[r].initial.get_value();
+  };
+
+  bool refined;
+
+  do
+  {
+    refined = false;
+
+    bvt assumptions;
+
+    for(auto &c : classes)
+      for(std::size_t k = 1; k < c.size(); k++)
+        assumptions.push_back(
+          solver.lequal(current(c[k]), current(c[0]) ^ phase(c[k], c[0])));
+
+    for(auto &c : classes)
+    {
+      for(std::size_t k = 1; k < c.size() && !refined; k++)
+      {
+        auto differ =
+          solver.lxor(next(c[k]), next(c[0]) ^ phase(c[k], c[0]));
+
+        if(differ.is_false())
+          continue;
+
+        bvt query = assumptions;
+        if(!differ.is_true())
+          query.push_back(differ);
+
+        switch(solver.prop_solve(query))
+        {
+        case propt::resultt::P_UNSATISFIABLE:
+          break;
+
+        case propt::resultt::P_SATISFIABLE:
+          refined = true;
+          break;
+
+        case propt::resultt::P_ERROR:
+          return;
+        }
+      }
+
+      if(refined)
+        break;
+    }
+
+    if(refined)
+    {
+      // split the classes using the next state of the counterexample
+      auto next_value = [&](std::size_t i) {
+        auto l = next(i);
+        bool v = l.is_constant() ? l.is_true() : solver.l_get(l).is_true();
+        return v != latch_bits[i].initial.is_true();
+      };
+
+      classest new_classes;
+
+      for(auto &c : classes)
+      {
+        classt part[2];
+        for(auto i : c)
+          part[next_value(i)].push_back(i);
+        for(auto &p : part)
+          if(p.size() >= 2)
+            new_classes.push_back(std::move(p));
+      }
+
+      classes.swap(new_classes);
+    }
+  } while(refined && !classes.empty());
+
+  for(auto &c : classes)
+  {
+    // the representative has the smallest node number
+    auto r = c[0];
+    for(std::size_t k = 1; k < c.size(); k++)
+    {
+      substitution[latch_bits[c[k]].node] =
+        literalt(latch_bits[r].node, false) ^ phase(c[k], r);
+      equivalent_latches++;
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: sequential_reductiont::apply
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: rebuild the netlist using the substitution
+
+\*******************************************************************/
+
+void sequential_reductiont::apply()
+{
+  const std::size_t number_of_nodes = netlist.number_of_nodes();
+
+  // A variable is removed when all its bits are replaced;
+  // it then becomes a wire. The other replaced bits
+  // are only replaced where they are used.
+  std::vector<bool> removed(number_of_nodes, false);
+
+  for(auto &[identifier, var] : netlist.var_map.map)
+  {
+    if(!var.is_latch() && !var.is_input() && !var.is_nondet())
+      continue;
+
+    bool all = std::all_of(
+      var.bits.begin(), var.bits.end(), [this](const var_mapt::vart::bitt &b) {
+        return substitution[b.current.var_no()].has_value();
+      });
+
+    if(!all)
+      continue;
+
+    for(auto &bit : var.bits)
+    {
+      removed[bit.current.var_no()] = true;
+      bit.next = const_literal(false);
+    }
+
+    var.vartype = var_mapt::vart::vartypet::WIRE;
+  }
+
+  aigt dest;
+  aig_strasht strash{dest};
+
+  // old_to_new is used for the references from outside of the AIG,
+  // whereas logic is used for the references within the AIG
+  std::vector<literalt> old_to_new(number_of_nodes), logic(number_of_nodes);
+
+  auto map = [](const std::vector<literalt> &m, literalt l) {
+    return l.is_constant() ? l : m[l.var_no()] ^ l.sign();
+  };
+
+  for(std::size_t n = 0; n < number_of_nodes; n++)
+  {
+    const auto &node = netlist.nodes[n];
+
+    if(node.is_and())
+    {
+      logic[n] = strash.land(map(logic, node.a), map(logic, node.b));
+      old_to_new[n] = logic[n];
+    }
+    else if(removed[n])
+    {
+      // the representatives have smaller node numbers
+      logic[n] = map(logic, *substitution[n]);
+      old_to_new[n] = logic[n];
+    }
+    else
+    {
+      old_to_new[n] = dest.new_var_node();
+      logic[n] = substitution[n].has_value() ? map(logic, *substitution[n])
+                                             : old_to_new[n];
+    }
+  }
+
+  netlist.renumber(std::move(dest.nodes), [&](literalt l) {
+    return map(old_to_new, l);
+  });
+}
+
+/*******************************************************************\
+
+Function: sequential_reductiont::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void sequential_reductiont::operator()()
+{
+  const auto latches_before = netlist.var_map.latches.size();
+
+  substitution.resize(netlist.number_of_nodes());
+
+  collect_latches();
+  find_stuck_inputs();
+  find_constant_latches();
+  find_equivalent_latches();
+
+  if(stuck_inputs != 0 || constant_latches != 0 || equivalent_latches != 0)
+    apply();
+
+  const auto latches_removed =
+    latches_before - netlist.var_map.latches.size();
+
+  message.statistics() << "Sequential reduction: " << stuck_inputs
+                       << " stuck inputs, " << constant_latches
+                       << " constant latches, " << equivalent_latches
+                       << " equivalent latches, " << latches_removed
+                       << " latches removed" << messaget::eom;
+
+  ebmc_statistics().count("stuck inputs", stuck_inputs);
+  ebmc_statistics().count("constant latches", constant_latches);
+  ebmc_statistics().count("equivalent latches", equivalent_latches);
+  ebmc_statistics().count("latches removed", latches_removed);
+}
+
+/*******************************************************************\
+
+Function: sequential_reduction
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void sequential_reduction(netlistt &netlist, message_handlert &message_handler)
+{
+  ebmc_phaset phase("sequential reduction");
+  sequential_reductiont{netlist, message_handler}();
+}
@@ -0,0 +1,30 @@
+/*******************************************************************\
+
+Module: Sequential Reduction of Netlists
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Sequential Reduction of Netlists
+
+#ifndef CPROVER_TRANS_NETLIST_SEQUENTIAL_REDUCTION_H
+#define CPROVER_TRANS_NETLIST_SEQUENTIAL_REDUCTION_H
+
+#include <util/message.h>
+
+class netlistt;
+
+/// Replaces inputs that are fixed by a unit constraint by constants,
+/// latches that are constant in all reachable states (as shown by
+/// ternary simulation from the initial state) by constants, and
+/// latches that are equivalent, or negated equivalent, in all
+/// reachable states (as shown by induction, i.e., signal
+/// correspondence) by one representative.
+/// Variables whose bits are all replaced are no longer latches or
+/// inputs, but wires defined by the replacement, and thus still
+/// appear with their correct values in counterexamples.
+void sequential_reduction(netlistt &, message_handlert &);
+
+#endif // CPROVER_TRANS_NETLIST_SEQUENTIAL_REDUCTION_H
@@ -26,6 +26,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <verilog/sva_expr.h>
 
 #include "aig_prop.h"
+#include "aig_strash.h"
 #include "netlist.h"
 #include "netlist_boolbv.h"
 
@@ -51,7 +52,8 @@ public:
       ns(_symbol_table),
       dest(_dest),
       aig_prop(dest, _message_handler),
-      solver(ns, aig_prop, _message_handler, dest.var_map)
+      solver(ns, aig_prop, _message_handler, dest.var_map),
+      gate_strash(dest)
   {
   }
 
@@ -141,6 +143,13 @@ protected:
 
   literalt convert_rhs(const rhst &);
 
+  // Fast path for the constraints generated for the Verilog
+  // built-in gate primitives, which bypasses boolbvt, and
+  // merges structurally identical gates.
+  std::optional<bvt> convert_gate(const exprt &, std::size_t width);
+  std::optional<bvt> convert_gate_operand(const exprt &, std::size_t width);
+  aig_strasht gate_strash;
+
   void finalize_lhs(lhs_mapt::iterator);
 
   void convert_lhs_rec(const exprt &expr, std::size_t from, std::size_t to);
@@ -651,7 +660,12 @@ literalt convert_trans_to_netlistt::convert_rhs(const rhst &rhs)
     rhs_entry.converted=true;
 
     // now we can convert
-    rhs_entry.bv = solver.convert_bv(rhs_entry.expr);
+    auto gate_bv = convert_gate(rhs_entry.expr, rhs_entry.width);
+
+    if(gate_bv.has_value())
+      rhs_entry.bv = std::move(gate_bv.value());
+    else
+      rhs_entry.bv = solver.convert_bv(rhs_entry.expr);
 
     DATA_INVARIANT(rhs_entry.bv.size() == rhs_entry.width, "bit-width match");
   }
@@ -662,6 +676,153 @@ literalt convert_trans_to_netlistt::convert_rhs(const rhst &rhs)
 
 /*******************************************************************\
 
+Function: convert_trans_to_netlistt::convert_gate_operand
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: symbols and constants only
+
+\*******************************************************************/
+
+std::optional<bvt> convert_trans_to_netlistt::convert_gate_operand(
+  const exprt &expr,
+  std::size_t width)
+{
+  if(expr.id() == ID_symbol)
+  {
+    auto v_it = dest.var_map.map.find(to_symbol_expr(expr).get_identifier());
+
+    if(v_it == dest.var_map.map.end() || v_it->second.bits.size() != width)
+      return {};
+
+    bvt bv;
+    bv.reserve(width);
+
+    for(auto &bit : v_it->second.bits)
+      bv.push_back(bit.current);
+
+    return bv;
+  }
+  else if(expr.is_true() && width == 1)
+    return bvt{const_literal(true)};
+  else if(expr.is_false() && width == 1)
+    return bvt{const_literal(false)};
+  else if(
+    expr.id() == ID_constant &&
+    (expr.type().id() == ID_unsignedbv || expr.type().id() == ID_signedbv))
+  {
+    auto value = numeric_cast<mp_integer>(to_constant_expr(expr));
+
+    if(!value.has_value())
+      return {};
+
+    // most significant bit first
+    const auto binary = integer2binary(*value, width);
+
+    bvt bv;
+    bv.reserve(width);
+
+    for(std::size_t i = 0; i < width; i++)
+      bv.push_back(const_literal(binary[width - 1 - i] == '1'));
+
+    return bv;
+  }
+  else
+    return {};
+}
+
+/*******************************************************************\
+
+Function: convert_trans_to_netlistt::convert_gate
+
+  Inputs:
+
+ Outputs: {} if the expression is not of the shape generated
+          for a gate primitive
+
+ Purpose:
+
+\*******************************************************************/
+
+std::optional<bvt>
+convert_trans_to_netlistt::convert_gate(const exprt &expr, std::size_t width)
+{
+  const irep_idt &id = expr.id();
+
+  bool is_not = id == ID_not || id == ID_bitnot;
+  bool is_and = id == ID_and || id == ID_bitand || id == ID_nand ||
+                id == ID_bitnand;
+  bool is_or =
+    id == ID_or || id == ID_bitor || id == ID_nor || id == ID_bitnor;
+  bool is_xor = id == ID_xor || id == ID_bitxor || id == ID_xnor ||
+                id == ID_bitxnor;
+  bool negate = id == ID_nand || id == ID_bitnand || id == ID_nor ||
+                id == ID_bitnor || id == ID_xnor || id == ID_bitxnor;
+
+  // buf
+  if(id == ID_symbol || id == ID_constant)
+    return convert_gate_operand(expr, width);
+
+  if(!is_not && !is_and && !is_or && !is_xor)
+    return {};
+
+  if(expr.operands().empty())
+    return {};
+
+  std::vector<bvt> operands;
+  operands.reserve(expr.operands().size());
+
+  for(auto &op : expr.operands())
+  {
+    auto op_bv = convert_gate_operand(op, width);
+    if(!op_bv.has_value())
+      return {};
+    operands.push_back(std::move(op_bv.value()));
+  }
+
+  bvt bv;
+  bv.reserve(width);
+
+  for(std::size_t i = 0; i < width; i++)
+  {
+    literalt l;
+
+    if(is_not)
+    {
+      if(operands.size() != 1)
+        return {};
+      l = !operands.front()[i];
+    }
+    else if(is_and)
+    {
+      l = const_literal(true);
+      for(auto &op : operands)
+        l = gate_strash.land(op[i], l);
+    }
+    else if(is_or)
+    {
+      l = const_literal(true);
+      for(auto &op : operands)
+        l = gate_strash.land(!op[i], l);
+      l = !l;
+    }
+    else // xor
+    {
+      l = const_literal(false);
+      for(auto &op : operands)
+        l = gate_strash.lxor(op[i], l);
+    }
+
+    bv.push_back(negate ? !l : l);
+  }
+
+  return bv;
+}
+
+/*******************************************************************\
+
 Function: convert_trans_to_netlistt::add_equality
 
   Inputs:
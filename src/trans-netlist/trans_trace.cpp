@@ -8,11 +8,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "trans_trace.h"
 
+#include <util/arith_tools.h>
 #include <util/ebmc_util.h>
 #include <util/expr_util.h>
 #include <util/json_irep.h>
-#include <util/pointer_offset_size.h>
-#include <util/prefix.h>
 #include <util/std_expr.h>
 #include <util/xml.h>
 
@@ -23,7 +22,6 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "instantiate_netlist.h"
 
 #include <cassert>
-#include <ctime>
 #include <iostream>
 #include <string>
 
@@ -45,9 +43,9 @@ std::optional<std::size_t> trans_tracet::get_max_failing_timeframe() const
 {
   std::optional<std::size_t> max = {};
 
-  for(std::size_t t = 0; t < states.size(); t++)
+  for(std::size_t t = 0; t < property_failed.size(); t++)
   {
-    if(states[t].property_failed)
+    if(property_failed[t])
       max=t;
   }
   
@@ -68,8 +66,8 @@ Function: trans_tracet::get_min_failing_timeframe
 
 std::optional<std::size_t> trans_tracet::get_min_failing_timeframe() const
 {
-  for(std::size_t t = 0; t < states.size(); t++)
-    if(states[t].property_failed)
+  for(std::size_t t = 0; t < property_failed.size(); t++)
+    if(property_failed[t])
       return t;
 
   return {};
@@ -77,7 +75,7 @@ std::optional<std::size_t> trans_tracet::get_min_failing_timeframe() const
 
 /*******************************************************************\
 
-Function: bvrep2binary
+Function: trans_tracet::resize
 
   Inputs:
 
@@ -87,21 +85,23 @@ Function: bvrep2binary
 
 \*******************************************************************/
 
-std::string bvrep2binary(const constant_exprt &expr)
+void trans_tracet::resize(columnt &column, std::size_t width)
 {
-  const auto &value = expr.get_value();
-  std::size_t width = to_bitvector_type(expr.type()).get_width();
-  std::string result;
-  result.reserve(width);
-  for(std::size_t dest_index = 0; dest_index < width; dest_index++)
-    result.push_back(
-      get_bvrep_bit(value, width, width - dest_index - 1) ? '1' : '0');
-  return result;
+  if(width == 0)
+  {
+    column.exprs.resize(no_timeframes(), nil_exprt());
+  }
+  else
+  {
+    std::size_t words = (no_timeframes() * width + 63) / 64;
+    column.value.resize(words, 0);
+    column.known.resize(words, 0);
+  }
 }
 
 /*******************************************************************\
 
-Function: show_trans_state
+Function: trans_tracet::set_no_timeframes
 
   Inputs:
 
@@ -111,64 +111,17 @@ Function: show_trans_state
 
 \*******************************************************************/
 
-void show_trans_state(
-  std::size_t timeframe,
-  const trans_tracet::statet &state,
-  const namespacet &ns)
+void trans_tracet::set_no_timeframes(std::size_t no_timeframes)
 {
-  std::cout << "Transition system state " << timeframe << "\n";
-  std::cout << "----------------------------------------------------\n";
-
-  for(const auto & a : state.assignments)
-  {
-    assert(a.lhs.id()==ID_symbol);
-
-    const symbolt &symbol=ns.lookup(to_symbol_expr(a.lhs));
-    
-    if(symbol.is_auxiliary)
-      continue;
-
-    std::cout << "  " << symbol.display_name() << " = ";
-
-    const exprt &rhs=a.rhs;
-
-    if(rhs.is_nil())
-      std::cout << "?";
-    else
-      std::cout << from_expr(ns, symbol.name, rhs);
-
-    if(rhs.type().id() == ID_unsignedbv || rhs.type().id() == ID_signedbv)
-    {
-      std::size_t width=to_bitvector_type(rhs.type()).get_width();
-
-      if(width >= 2 && width <= 32 && rhs.id() == ID_constant)
-      {
-        std::cout << " ("
-                  << integer2binary(
-                       numeric_cast_v<mp_integer>(to_constant_expr(rhs)), width)
-                  << ')';
-      }
-    }
-    else if(rhs.type().id() == ID_bv)
-    {
-      std::size_t width = to_bv_type(rhs.type()).get_width();
+  property_failed.resize(no_timeframes, false);
 
-      if(width>=2 && width<=32 &&
-         rhs.id()==ID_constant)
-      {
-        std::cout << " (" << bvrep2binary(to_constant_expr(rhs)) << ')';
-      }
-    }
-
-    std::cout << '\n';
-  }
-
-  std::cout << '\n' << std::flush;
+  for(std::size_t v = 0; v < variables.size(); v++)
+    resize(columns[v], variables[v].width);
 }
 
 /*******************************************************************\
 
-Function: show_trans_trace
+Function: trans_tracet::add_variable
 
   Inputs:
 
@@ -178,95 +131,77 @@ Function: show_trans_trace
 
 \*******************************************************************/
 
-void show_trans_trace(
-  const trans_tracet &trace,
-  messaget &message,
-  const namespacet &ns,
-  std::ostream &out)
+std::size_t trans_tracet::add_variable(
+  symbol_exprt lhs,
+  std::size_t width,
+  source_locationt location)
 {
-  PRECONDITION(!trace.states.empty());
-
-  auto l = trace.get_min_failing_timeframe().value_or(trace.states.size() - 1);
-
-  for(std::size_t t = 0; t <= l; t++)
-    show_trans_state(t, trace.states[t], ns);
+  variables.emplace_back(std::move(lhs), width, std::move(location));
+  columns.emplace_back();
+  resize(columns.back(), width);
+  return variables.size() - 1;
 }
 
 /*******************************************************************\
 
-Function: xml
+Function: trans_tracet::restrict_variables
 
   Inputs:
 
  Outputs:
 
- Purpose: Transform trans_tracet to XML
+ Purpose:
 
 \*******************************************************************/
 
-xmlt xml(const trans_tracet &trace, const namespacet &ns)
+void trans_tracet::restrict_variables(
+  const std::unordered_set<irep_idt> &identifiers)
 {
-  PRECONDITION(!trace.states.empty());
-
-  auto min_failing_timeframe_opt = trace.get_min_failing_timeframe();
-
-  auto last_time_frame =
-    min_failing_timeframe_opt.value_or(trace.states.size() - 1);
-
-  xmlt dest = xmlt{"trans_trace"};
-
-  dest.new_element("mode").data=trace.mode;
+  std::size_t kept = 0;
 
-  for(std::size_t t = 0; t <= last_time_frame; t++)
+  for(std::size_t v = 0; v < variables.size(); v++)
   {
-    assert(t<trace.states.size());
-  
-    xmlt &xml_state=dest.new_element("state");
-    const trans_tracet::statet &state=trace.states[t];
+    if(identifiers.find(variables[v].lhs.get_identifier()) == identifiers.end())
+      continue;
 
-    xml_state.new_element("timeframe").data=std::to_string(t); // will go away
-    xml_state.set_attribute("timeframe", t);
-    
-    for(const auto & a : state.assignments)
+    if(kept != v)
     {
-      xmlt &xml_assignment=xml_state.new_element("assignment");
+      variables[kept] = std::move(variables[v]);
+      columns[kept] = std::move(columns[v]);
+    }
 
-      assert(a.lhs.id()==ID_symbol);
-      const symbolt &symbol=ns.lookup(to_symbol_expr(a.lhs));
+    kept++;
+  }
 
-      std::string value_string=from_expr(ns, symbol.name, a.rhs);
-      std::string type_string=from_type(ns, symbol.name, symbol.type);
+  variables.erase(variables.begin() + kept, variables.end());
+  columns.erase(columns.begin() + kept, columns.end());
+}
 
-      if(a.rhs.is_nil())
-        value_string="?";
-      else
-        xml_assignment.new_element("value_expression").new_element(xml(a.rhs, ns));
+/*******************************************************************\
 
-      xml_assignment.new_element("identifier").data=id2string(symbol.name);
-      xml_assignment.new_element("base_name").data=id2string(symbol.base_name);
-      xml_assignment.new_element("display_name").data=id2string(symbol.display_name());
-      xml_assignment.new_element("value").data=value_string;
-      xml_assignment.new_element("type").data=type_string;
-      xml_assignment.new_element("mode").data=id2string(symbol.mode);
+Function: trans_tracet::packed_width
 
-      #if 0
-      if(a.location.is_not_nil())
-      {
-        xmlt &xml_location=xml_assignment.new_element();
+  Inputs:
 
-        convert(a.location, xml_location);
-        xml_location.name="location";
-      }
-      #endif
-    }
-  }
+ Outputs:
 
-  return dest;
+ Purpose:
+
+\*******************************************************************/
+
+std::size_t trans_tracet::packed_width(const typet &type)
+{
+  if(type.id() == ID_bool)
+    return 1;
+  else if(type.id() == ID_unsignedbv || type.id() == ID_signedbv)
+    return to_bitvector_type(type).get_width();
+  else
+    return 0;
 }
 
 /*******************************************************************\
 
-Function: json
+Function: trans_tracet::set_bit
 
   Inputs:
 
@@ -276,62 +211,63 @@ Function: json
 
 \*******************************************************************/
 
-jsont json(const trans_tracet &trace, const namespacet &ns)
+void trans_tracet::set_bit(
+  std::size_t variable,
+  std::size_t timeframe,
+  std::size_t bit_nr,
+  tvt value)
 {
-  json_objectt json_trace;
-
-  json_trace["mode"] = json_stringt(trace.mode);
-  json_arrayt &json_states = json_trace["states"].make_array();
+  const std::size_t width = variables[variable].width;
+  PRECONDITION(bit_nr < width && timeframe < no_timeframes());
 
-  for(auto &state : trace.states)
-  {
-    json_arrayt json_assignments;
+  auto &column = columns[variable];
+  std::size_t index = timeframe * width + bit_nr;
+  std::uint64_t mask = std::uint64_t(1) << (index % 64);
 
-    for(const auto &a : state.assignments)
-    {
-      json_objectt json_assignment;
+  if(value.is_known())
+    column.known[index / 64] |= mask;
+  else
+    column.known[index / 64] &= ~mask;
 
-      DATA_INVARIANT(a.lhs.id() == ID_symbol, "assignment lhs must be symbol");
-      const symbolt &symbol = ns.lookup(to_symbol_expr(a.lhs));
+  if(value.is_true())
+    column.value[index / 64] |= mask;
+  else
+    column.value[index / 64] &= ~mask;
+}
 
-      if(symbol.is_auxiliary)
-        continue; // drop
+/*******************************************************************\
 
-      std::string lhs_string = from_expr(ns, symbol.name, a.lhs);
+Function: trans_tracet::get_bit
 
-      std::string value_string =
-        a.rhs.is_nil() ? "" : from_expr(ns, symbol.name, a.rhs);
+  Inputs:
 
-      std::string type_string = from_type(ns, symbol.name, symbol.type);
+ Outputs:
 
-      json_assignment["lhs"] = json_stringt(lhs_string);
-      json_assignment["identifier"] = json_stringt(id2string(symbol.name));
-      json_assignment["base_name"] = json_stringt(id2string(symbol.base_name));
-      json_assignment["display_name"] =
-        json_stringt(id2string(symbol.display_name()));
-      json_assignment["value"] = json_stringt(value_string);
-      json_assignment["lhs_type"] = json_stringt(type_string);
-      json_assignment["mode"] = json_stringt(id2string(symbol.mode));
-      json_assignment["state_var"] = jsont::json_boolean(symbol.is_state_var);
+ Purpose:
 
-      if(a.location.is_not_nil())
-        json_assignment["location"] = json(a.location);
+\*******************************************************************/
 
-      json_assignments.push_back(std::move(json_assignment));
-    }
+tvt trans_tracet::get_bit(
+  std::size_t variable,
+  std::size_t timeframe,
+  std::size_t bit_nr) const
+{
+  const std::size_t width = variables[variable].width;
+  PRECONDITION(bit_nr < width && timeframe < no_timeframes());
 
-    json_states.push_back(std::move(json_assignments));
+  auto &column = columns[variable];
+  std::size_t index = timeframe * width + bit_nr;
+  std::uint64_t mask = std::uint64_t(1) << (index % 64);
 
-    if(state.property_failed)
-      break; // done
-  }
+  if(!(column.known[index / 64] & mask))
+    return tvt::unknown();
 
-  return std::move(json_trace);
+  return tvt((column.value[index / 64] & mask) != 0);
 }
 
 /*******************************************************************\
 
-Function: show_trans_trace_xml
+Function: trans_tracet::set_value
 
   Inputs:
 
@@ -341,39 +277,83 @@ Function: show_trans_trace_xml
 
 \*******************************************************************/
 
-void show_trans_trace_xml(
-  const trans_tracet &trace,
-  messaget &,
-  const namespacet &ns,
-  std::ostream &out)
+void trans_tracet::set_value(
+  std::size_t variable,
+  std::size_t timeframe,
+  exprt value)
 {
-  xml(trace, ns).output(out);
+  const std::size_t width = variables[variable].width;
+
+  if(width == 0)
+  {
+    PRECONDITION(timeframe < no_timeframes());
+    columns[variable].exprs[timeframe] = std::move(value);
+  }
+  else if(value.is_true() || value.is_false())
+  {
+    PRECONDITION(width == 1);
+    set_bit(variable, timeframe, 0, tvt(value.is_true()));
+  }
+  else if(
+    value.id() == ID_constant && (value.type().id() == ID_unsignedbv ||
+                                  value.type().id() == ID_signedbv))
+  {
+    PRECONDITION(to_bitvector_type(value.type()).get_width() == width);
+    const auto &bvrep = to_constant_expr(value).get_value();
+    for(std::size_t i = 0; i < width; i++)
+      set_bit(variable, timeframe, i, tvt(get_bvrep_bit(bvrep, width, i)));
+  }
+  else
+  {
+    // not a constant
+    for(std::size_t i = 0; i < width; i++)
+      set_bit(variable, timeframe, i, tvt::unknown());
+  }
 }
 
 /*******************************************************************\
 
-Function: show_trans_trace_json
+Function: trans_tracet::get_value
 
   Inputs:
 
  Outputs:
 
- Purpose:
+ Purpose: Materialize the value
 
 \*******************************************************************/
 
-void show_trans_trace_json(
-  const trans_tracet &trace,
-  messaget &,
-  const namespacet &ns,
-  std::ostream &out)
+exprt trans_tracet::get_value(std::size_t variable, std::size_t timeframe)
+  const
 {
-  out << json(trace, ns);
+  const auto &lhs = variables[variable].lhs;
+  const std::size_t width = variables[variable].width;
+
+  if(width == 0)
+    return columns[variable].exprs[timeframe];
+
+  std::string bits(width, '?');
+  bool known = false;
+
+  for(std::size_t i = 0; i < width; i++)
+  {
+    tvt bit = get_bit(variable, timeframe, i);
+    if(bit.is_known())
+    {
+      known = true;
+      bits[width - i - 1] = bit.is_true() ? '1' : '0';
+    }
+  }
+
+  if(!known)
+    return nil_exprt();
+
+  return bitstring_to_expr(bits, lhs.type());
 }
 
 /*******************************************************************\
 
-Function: vcd_width
+Function: trans_tracet::value_changed
 
   Inputs:
 
@@ -383,62 +363,35 @@ Function: vcd_width
 
 \*******************************************************************/
 
-static mp_integer vcd_width(
-  const typet &type,
-  const namespacet &ns)
+bool trans_tracet::value_changed(std::size_t variable, std::size_t timeframe)
+  const
 {
-  if(
-    type.id() == ID_unsignedbv || type.id() == ID_signedbv ||
-    type.id() == ID_bv || type.id() == ID_fixedbv || type.id() == ID_floatbv ||
-    type.id() == ID_pointer)
-  {
-    return to_bitvector_type(type).get_width();
-  }
-  else if(type.id()==ID_array)
-  {
-    auto &array_type = to_array_type(type);
-    mp_integer sub = vcd_width(array_type.element_type(), ns);
-
-    // get size
-    const exprt &size = array_type.size();
+  if(timeframe == 0)
+    return true;
 
-    // constant?
-    mp_integer i;
+  const std::size_t width = variables[variable].width;
 
-    if(to_integer_non_constant(size, i))
-      return -1; // we cannot distinguish the elements
-    
-    return sub*i;
+  if(width == 0)
+  {
+    auto &exprs = columns[variable].exprs;
+    return exprs[timeframe] != exprs[timeframe - 1];
   }
-  else if(type.id()==ID_struct)
+
+  for(std::size_t i = 0; i < width; i++)
   {
-    const struct_typet &struct_type=to_struct_type(type);
-    const struct_typet::componentst &components=
-      struct_type.components();
-      
-    mp_integer result=0;
-    
-    for(const auto & it : components)
+    if(
+      get_bit(variable, timeframe, i) != get_bit(variable, timeframe - 1, i))
     {
-      const typet &subtype=it.type();
-      mp_integer sub_size = *pointer_offset_size(subtype, ns);
-      if(sub_size==-1) return -1;
-      result+=sub_size;
+      return true;
     }
-    
-    return result;
   }
-  else if(type.id()==ID_bool)
-    return 1;
-  else if(type.id()==ID_integer)
-    return 32; // no better idea.
-  else
-    return -1;
+
+  return false;
 }
 
 /*******************************************************************\
 
-Function: as_vcd_binary
+Function: bitstring_to_expr
 
   Inputs:
 
@@ -448,68 +401,83 @@ Function: as_vcd_binary
 
 \*******************************************************************/
 
-static std::string as_vcd_binary(
-  const exprt &expr,
-  const namespacet &ns)
+exprt bitstring_to_expr(const std::string &src, const typet &type)
 {
-  const auto &type = expr.type();
-
-  if(expr.id()==ID_constant)
+  if(type.id() == ID_unsignedbv)
   {
-    if(
-      type.id() == ID_unsignedbv || type.id() == ID_signedbv ||
-      type.id() == ID_bv || type.id() == ID_fixedbv ||
-      type.id() == ID_floatbv || type.id() == ID_pointer ||
-      type.id() == ID_integer)
-    {
-      mp_integer i = numeric_cast_v<mp_integer>(to_constant_expr(expr));
-      auto width = numeric_cast_v<std::size_t>(vcd_width(type, ns));
-      return integer2binary(i, width);
-    }
+    return from_integer(binary2integer(src, false), type);
   }
-  else if(expr.id()==ID_array)
+  else if(type.id() == ID_signedbv)
   {
-    std::string result;
-
-    forall_operands(it, expr)
-      result+=as_vcd_binary(*it, ns);
-    
-    return result;
+    return from_integer(binary2integer(src, true), type);
   }
-  else if(expr.id()==ID_struct)
+  else if(type.id() == ID_range)
   {
-    std::string result;
-
-    forall_operands(it, expr)
-      result+=as_vcd_binary(*it, ns);
-    
-    return result;
+    // from_integer doesn't support range_typet
+    mp_integer i = binary2integer(src, false);
+    mp_integer from = string2integer(type.get_string(ID_from));
+    return constant_exprt(integer2string(i + from), type);
+  }
+  else if(type.id()==ID_bool)
+  {
+    if(src=="0")
+      return false_exprt();
+    else if(src=="1")
+      return true_exprt();
+    else
+      PRECONDITION(false);
   }
-  else if(expr.id()==ID_union)
+  else if(type.id()==ID_array)
   {
-    return as_vcd_binary(to_union_expr(expr).op(), ns);
+    const array_typet &array_type=to_array_type(type);
+    exprt::operandst elements;
+
+    // we can only do constant sizes
+    PRECONDITION(array_type.size().is_constant());
+    auto size_opt =
+      numeric_cast<mp_integer>(to_constant_expr(array_type.size()));
+    PRECONDITION(size_opt.has_value());
+    std::size_t size_int = size_opt.value().to_ulong();
+    elements.resize(size_int);
+    std::size_t op_width=src.size()/size_int;
+
+    for(std::size_t i=0; i<size_int; i++)
+      elements[size_int - i - 1] = bitstring_to_expr(
+        std::string(src, i * op_width, op_width), array_type.element_type());
+
+    return array_exprt(std::move(elements), array_type);
   }
+  else
+    PRECONDITION(false);
+}
+
+/*******************************************************************\
 
-  // build "xxx"
+Function: bvrep2binary
 
-  mp_integer width=vcd_width(type, ns);
+  Inputs:
 
-  if(width>=0)
-  {
-    std::string result;
+ Outputs:
 
-    for(; width!=0; --width)
-      result+='x';
+ Purpose:
 
-    return result;
-  }
-  
-  return "";
+\*******************************************************************/
+
+std::string bvrep2binary(const constant_exprt &expr)
+{
+  const auto &value = expr.get_value();
+  std::size_t width = to_bitvector_type(expr.type()).get_width();
+  std::string result;
+  result.reserve(width);
+  for(std::size_t dest_index = 0; dest_index < width; dest_index++)
+    result.push_back(
+      get_bvrep_bit(value, width, width - dest_index - 1) ? '1' : '0');
+  return result;
 }
 
 /*******************************************************************\
 
-Function: vcd_identifier
+Function: show_trans_state
 
   Inputs:
 
@@ -519,21 +487,62 @@ Function: vcd_identifier
 
 \*******************************************************************/
 
-std::string vcd_identifier(const std::string &id)
+void show_trans_state(
+  std::size_t timeframe,
+  const trans_tracet &trace,
+  const namespacet &ns)
 {
-  std::string result=id;
+  std::cout << "Transition system state " << timeframe << "\n";
+  std::cout << "----------------------------------------------------\n";
+
+  for(std::size_t v = 0; v < trace.variables.size(); v++)
+  {
+    const symbolt &symbol = ns.lookup(trace.variables[v].lhs);
+    
+    if(symbol.is_auxiliary)
+      continue;
 
-  if((has_prefix(result, "verilog::")) || (has_prefix(result, "Verilog::")))
-    result.erase(0, 9);
-  else if(has_prefix(result, "smv::"))
-    result.erase(0, 5);
+    std::cout << "  " << symbol.display_name() << " = ";
 
-  return result;
+    const exprt rhs = trace.get_value(v, timeframe);
+
+    if(rhs.is_nil())
+      std::cout << "?";
+    else
+      std::cout << from_expr(ns, symbol.name, rhs);
+
+    if(rhs.type().id() == ID_unsignedbv || rhs.type().id() == ID_signedbv)
+    {
+      std::size_t width=to_bitvector_type(rhs.type()).get_width();
+
+      if(width >= 2 && width <= 32 && rhs.id() == ID_constant)
+      {
+        std::cout << " ("
+                  << integer2binary(
+                       numeric_cast_v<mp_integer>(to_constant_expr(rhs)), width)
+                  << ')';
+      }
+    }
+    else if(rhs.type().id() == ID_bv)
+    {
+      std::size_t width = to_bv_type(rhs.type()).get_width();
+
+      if(width>=2 && width<=32 &&
+         rhs.id()==ID_constant)
+      {
+        std::cout << " (" << bvrep2binary(to_constant_expr(rhs)) << ')';
+      }
+    }
+
+    std::cout << '\n';
+  }
+
+  std::cout << '\n' << std::flush;
 }
 
 /*******************************************************************\
 
-Function: vcd_reference
+Function: show_trans_trace
 
   Inputs:
 
@@ -543,86 +552,85 @@ Function: vcd_reference
 
 \*******************************************************************/
 
-std::string vcd_reference(const symbolt &symbol, const std::string &prefix)
+void show_trans_trace(
+  const trans_tracet &trace,
+  messaget &message,
+  const namespacet &ns,
+  std::ostream &out)
 {
-  std::string result = id2string(symbol.name);
+  PRECONDITION(trace.no_timeframes() != 0);
 
-  if(!prefix.empty() && has_prefix(result, prefix))
-    result.erase(0, prefix.size());
-
-  return result;
+  for(std::size_t t = 0; t < trace.timeframes_to_show(); t++)
+    show_trans_state(t, trace, ns);
 }
 
 /*******************************************************************\
 
-Function: show_trans_state_vcd
+Function: xml
 
   Inputs:
 
  Outputs:
 
- Purpose: dumps the counterexample state in vcd format to be
-          viewed in modelsim or any other simulator
+ Purpose: Transform trans_tracet to XML
 
 \*******************************************************************/
 
-void show_trans_state_vcd(
-  std::size_t timeframe,
-  const trans_tracet::statet &previous_state,
-  const trans_tracet::statet &current_state,
-  const namespacet &ns,
-  std::ostream &out)
+xmlt xml(const trans_tracet &trace, const namespacet &ns)
 {
-  out << "#" << timeframe << '\n';
+  PRECONDITION(trace.no_timeframes() != 0);
 
-  // build map for previous state  
-  std::map<irep_idt, exprt> previous_values;
+  xmlt dest = xmlt{"trans_trace"};
 
-  for(const auto & a : previous_state.assignments)
-    previous_values[a.lhs.get(ID_identifier)]=a.rhs;
+  dest.new_element("mode").data=trace.mode;
 
-  // now dump current state
-  for(const auto & a : current_state.assignments)
+  for(std::size_t t = 0; t < trace.timeframes_to_show(); t++)
   {
-    assert(a.lhs.id()==ID_symbol);
+    xmlt &xml_state=dest.new_element("state");
 
-    const symbolt &symbol=
-      ns.lookup(to_symbol_expr(a.lhs));
-    
-    if(symbol.is_auxiliary)
-      continue;
+    xml_state.new_element("timeframe").data=std::to_string(t); // will go away
+    xml_state.set_attribute("timeframe", t);
     
-    if(timeframe!=0)
-      if(previous_values[symbol.name]==a.rhs)
-        continue; // value didn't change!
-  
-    if(a.rhs.is_nil()) // no value
-      continue;
-  
-    std::string display_name=id2string(symbol.display_name());
-
-    if(a.lhs.type().id()==ID_bool)
+    for(std::size_t v = 0; v < trace.variables.size(); v++)
     {
-      // booleans are special -- no space!
+      xmlt &xml_assignment=xml_state.new_element("assignment");
 
-      if(a.rhs.is_true())
-        out << '1' << vcd_identifier(display_name) << '\n';
-      else if(a.rhs.is_false())
-        out << '0' << vcd_identifier(display_name) << '\n';
+      const symbolt &symbol = ns.lookup(trace.variables[v].lhs);
+      const exprt rhs = trace.get_value(v, t);
+
+      std::string value_string=from_expr(ns, symbol.name, rhs);
+      std::string type_string=from_type(ns, symbol.name, symbol.type);
+
+      if(rhs.is_nil())
+        value_string="?";
       else
-        out << 'x' << vcd_identifier(display_name) << '\n';
-    }
-    else
-    {
-      out << 'b' << as_vcd_binary(a.rhs, ns) << ' '
-          << vcd_identifier(display_name) << '\n';
+        xml_assignment.new_element("value_expression").new_element(xml(rhs, ns));
+
+      xml_assignment.new_element("identifier").data=id2string(symbol.name);
+      xml_assignment.new_element("base_name").data=id2string(symbol.base_name);
+      xml_assignment.new_element("display_name").data=id2string(symbol.display_name());
+      xml_assignment.new_element("value").data=value_string;
+      xml_assignment.new_element("type").data=type_string;
+      xml_assignment.new_element("mode").data=id2string(symbol.mode);
+
+      #if 0
+      if(trace.variables[v].location.is_not_nil())
+      {
+        xmlt &xml_location=xml_assignment.new_element();
+
+        convert(trace.variables[v].location, xml_location);
+        xml_location.name="location";
+      }
+      #endif
     }
   }
+
+  return dest;
 }
 
 /*******************************************************************\
 
-Function: vcd_suffix
+Function: json
 
   Inputs:
 
@@ -632,212 +640,101 @@ Function: vcd_suffix
 
 \*******************************************************************/
 
-static std::string vcd_suffix(
-  const typet &type,
-  const namespacet &ns)
+jsont json(const trans_tracet &trace, const namespacet &ns)
 {
-  if(type.id()==ID_unsignedbv ||
-     type.id()==ID_signedbv ||
-     type.id()==ID_bv ||
-     type.id()==ID_fixedbv ||
-     type.id()==ID_floatbv ||
-     type.id()==ID_verilog_signedbv ||
-     type.id()==ID_verilog_unsignedbv)
-  {
-    mp_integer width=vcd_width(type, ns);
-    mp_integer offset=string2integer(type.get_string(ID_C_offset));
-
-    mp_integer left_bound, right_bound;
+  json_objectt json_trace;
 
-    left_bound = offset;
-    right_bound = left_bound+width-1;
+  json_trace["mode"] = json_stringt(trace.mode);
+  json_arrayt &json_states = json_trace["states"].make_array();
 
-    if(!type.get_bool(ID_C_increasing))
-      std::swap(left_bound, right_bound);
-    
-    return "["+integer2string(left_bound)+":"+integer2string(right_bound)+"]";
-  }
-  else if(type.id()==ID_array)
+  for(std::size_t t = 0; t < trace.no_timeframes(); t++)
   {
-    // get size
-    auto &array_type = to_array_type(type);
-    const exprt &size = array_type.size();
-
-    // constant?
-    mp_integer i;
+    json_arrayt json_assignments;
 
-    if(to_integer_non_constant(size, i))
-      return ""; // we cannot distinguish the elements
+    for(std::size_t v = 0; v < trace.variables.size(); v++)
+    {
+      json_objectt json_assignment;
 
-    mp_integer left_bound, right_bound;
-    left_bound=0;
-    right_bound=left_bound+i-1;
+      const auto &variable = trace.variables[v];
+      const symbolt &symbol = ns.lookup(variable.lhs);
 
-    return "[" + integer2string(left_bound) + ":" +
-           integer2string(right_bound) + "]" +
-           vcd_suffix(array_type.element_type(), ns);
-  }
-  else if(type.id()==ID_bool)
-    return "";
-  else if(type.id()==ID_integer)
-    return "";
-  else
-  {
-    mp_integer width=vcd_width(type, ns);
-    mp_integer left_bound, right_bound;
-    left_bound=0;
-    right_bound=left_bound+width-1;
-    return "["+integer2string(left_bound)+":"+integer2string(right_bound)+"]";
-  }
-}
+      if(symbol.is_auxiliary)
+        continue; // drop
 
-/*******************************************************************\
+      std::string lhs_string = from_expr(ns, symbol.name, variable.lhs);
 
-Function: vcd_hierarchy_rec
+      const exprt rhs = trace.get_value(v, t);
 
-  Inputs:
+      std::string value_string =
+        rhs.is_nil() ? "" : from_expr(ns, symbol.name, rhs);
 
- Outputs:
+      std::string type_string = from_type(ns, symbol.name, symbol.type);
 
- Purpose: 
+      json_assignment["lhs"] = json_stringt(lhs_string);
+      json_assignment["identifier"] = json_stringt(id2string(symbol.name));
+      json_assignment["base_name"] = json_stringt(id2string(symbol.base_name));
+      json_assignment["display_name"] =
+        json_stringt(id2string(symbol.display_name()));
+      json_assignment["value"] = json_stringt(value_string);
+      json_assignment["lhs_type"] = json_stringt(type_string);
+      json_assignment["mode"] = json_stringt(id2string(symbol.mode));
+      json_assignment["state_var"] = jsont::json_boolean(symbol.is_state_var);
 
-\*******************************************************************/
+      if(variable.location.is_not_nil())
+        json_assignment["location"] = json(variable.location);
 
-void vcd_hierarchy_rec(
-  const namespacet &ns,
-  const std::set<irep_idt> &ids,
-  const std::string &prefix,
-  std::ostream &out,
-  std::size_t depth)
-{
-  std::set<std::string> sub_modules;
-  std::set<irep_idt> signals;
-  
-  for(const auto & it : ids)
-  {
-    if(has_prefix(id2string(it), prefix))
-    {
-      std::string rest=
-        std::string(id2string(it), prefix.size(), std::string::npos);
-      std::size_t dot_pos=rest.find('.');
-      if(dot_pos==std::string::npos)
-        signals.insert(it);
-      else
-        sub_modules.insert(std::string(rest, 0, dot_pos));
+      json_assignments.push_back(std::move(json_assignment));
     }
-  }
 
-  // do signals first
-  for(const auto & it : signals)
-  {
-    const symbolt &symbol=ns.lookup(it);
-    
-    if(symbol.is_auxiliary) continue;
-
-    std::string display_name = id2string(symbol.display_name());
-    
-    std::string signal_class;
-    
-    if(symbol.type.id()==ID_integer)
-      signal_class="integer";
-    else if(symbol.is_state_var)
-      signal_class="reg";
-    else
-      signal_class="wire";
+    json_states.push_back(std::move(json_assignments));
 
-    mp_integer width=vcd_width(symbol.type, ns);
-    
-    std::string suffix=vcd_suffix(symbol.type, ns);
-    
-    if(width>=1)
-      out << std::string(depth * 2, ' ') << "$var " << signal_class << " "
-          << width << " " << vcd_identifier(display_name) << " "
-          << vcd_reference(symbol, prefix) << (suffix == "" ? "" : " ")
-          << suffix << " $end" << '\n';
+    if(trace.property_failed[t])
+      break; // done
   }
-  
-  // now do sub modules
-  for(const auto & identifier : sub_modules)
-  {
-    out << std::string(depth*2, ' ')
-        << "$scope module " << identifier << " $end\n";
 
-    // recursive call
-    vcd_hierarchy_rec(ns, ids, prefix+identifier+".", out, depth+1);
-    
-    out << std::string(depth*2, ' ')
-        << "$upscope $end\n";
-  }
+  return std::move(json_trace);
 }
 
 /*******************************************************************\
 
-Function: show_trans_trace_vcd
+Function: show_trans_trace_xml
 
   Inputs:
 
  Outputs:
 
- Purpose: dumps the counterexample trace in vcd format to be
-          viewed in modelsim or any other simulator
+ Purpose:
 
 \*******************************************************************/
 
-void show_trans_trace_vcd(
+void show_trans_trace_xml(
   const trans_tracet &trace,
-  messaget &message,
+  messaget &,
   const namespacet &ns,
   std::ostream &out)
 {
-  time_t t;
-  time(&t);
-  out << "$date\n  " << ctime(&t) << "$end" << '\n';
-
-  out << "$timescale\n  1ns\n$end" << '\n';
-  
-  if(trace.states.empty()) return;
-
-  const trans_tracet::statet &state=trace.states[0];
-
-  assert(!state.assignments.empty());
-
-  // get identifiers
-  std::set<irep_idt> ids;
-  
-  for(const auto & a : state.assignments)
-  {
-    assert(a.lhs.id()==ID_symbol);
-    ids.insert(to_symbol_expr(a.lhs).get_identifier());
-  }
-
-  // determine module
-
-  const symbolt &symbol1 =
-    ns.lookup(state.assignments.front().lhs.get(ID_identifier));
-
-  auto &module_symbol = ns.lookup(symbol1.module);
-
-  // print those in the top module
-
-  out << "$scope module " << module_symbol.display_name() << " $end\n";
+  xml(trace, ns).output(out);
+}
 
-  // split up into hierarchy
-  vcd_hierarchy_rec(ns, ids, id2string(module_symbol.name) + ".", out, 1);
+/*******************************************************************\
 
-  out << "$upscope $end\n";  
+Function: show_trans_trace_json
 
-  out << "$enddefinitions $end\n";
+  Inputs:
 
-  auto l = trace.get_min_failing_timeframe().value_or(trace.states.size() - 1);
+ Outputs:
 
-  // initial state
+ Purpose:
 
-  show_trans_state_vcd(0, trace.states[0], trace.states[0], ns, out);
-  
-  // following ones
+\*******************************************************************/
 
-  for(std::size_t t = 1; t <= l; t++)
-    show_trans_state_vcd(t, trace.states[t-1], trace.states[t], ns, out);
+void show_trans_trace_json(
+  const trans_tracet &trace,
+  messaget &,
+  const namespacet &ns,
+  std::ostream &out)
+{
+  out << json(trace, ns);
 }
 
 /*******************************************************************\
@@ -854,19 +751,16 @@ Function: show_trans_state_numbered
 
 void show_trans_state_numbered(
   std::size_t timeframe,
-  const trans_tracet::statet &state,
+  const trans_tracet &trace,
   const namespacet &ns)
 {
-  for(const auto &a : state.assignments)
+  for(std::size_t v = 0; v < trace.variables.size(); v++)
   {
-    DATA_INVARIANT(
-      a.lhs.id() == ID_symbol, "trace assignment lhs must be symbol");
-
-    const symbolt &symbol = ns.lookup(to_symbol_expr(a.lhs));
+    const symbolt &symbol = ns.lookup(trace.variables[v].lhs);
 
     std::cout << symbol.display_name() << '@' << timeframe << " = ";
 
-    const exprt &rhs = a.rhs;
+    const exprt rhs = trace.get_value(v, timeframe);
 
     if(rhs.is_nil())
       std::cout << "?";
@@ -895,10 +789,8 @@ void show_trans_trace_numbered(
   const namespacet &ns,
   std::ostream &out)
 {
-  PRECONDITION(!trace.states.empty());
-
-  auto l = trace.get_min_failing_timeframe().value_or(trace.states.size() - 1);
+  PRECONDITION(trace.no_timeframes() != 0);
 
-  for(std::size_t t = 0; t <= l; t++)
-    show_trans_state_numbered(t, trace.states[t], ns);
+  for(std::size_t t = 0; t < trace.timeframes_to_show(); t++)
+    show_trans_state_numbered(t, trace, ns);
 }
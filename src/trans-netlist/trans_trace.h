@@ -11,59 +11,123 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/expr.h>
 #include <util/namespace.h>
+#include <util/std_expr.h>
 #include <util/threeval.h>
 #include <util/ui_message.h>
 
+#include <cstdint>
+#include <unordered_set>
+
 class jsont;
 
+/// A trace of a transition system, stored by column: each variable
+/// has a header shared by all timeframes, and its values are either
+/// bit-packed, with a value and a known bit per bit and timeframe,
+/// or kept as expressions when the type cannot be packed.
+/// Values are materialized as expressions only on request.
 class trans_tracet
 {
 public:
-  class statet
+  class variablet
   {
   public:
-    class assignmentt
-    {
-    public:
-      exprt lhs;
-      exprt rhs;
-      source_locationt location;
-
-      assignmentt(
-        exprt __lhs,
-        exprt __rhs,
-        source_locationt __location = source_locationt::nil())
-        : lhs(std::move(__lhs)),
-          rhs(std::move(__rhs)),
-          location(std::move(__location))
-      {
-      }
-    };
-
-    typedef std::list<assignmentt> assignmentst;
-    assignmentst assignments;
-    
-    bool property_failed;
-    
-    statet():property_failed(false)
+    symbol_exprt lhs;
+    source_locationt location;
+
+    // the number of bits per timeframe when the values are
+    // bit-packed, and zero when they are kept as expressions
+    std::size_t width;
+
+    variablet(
+      symbol_exprt __lhs,
+      std::size_t __width,
+      source_locationt __location)
+      : lhs(std::move(__lhs)),
+        location(std::move(__location)),
+        width(__width)
     {
     }
   };
 
-  // one state per timeframe
-  typedef std::vector<statet> statest;
-  statest states;
-  
+  typedef std::vector<variablet> variablest;
+  variablest variables;
+
+  // one entry per timeframe
+  std::vector<bool> property_failed;
+
   // mode of whole trace
   std::string mode;
 
+  std::size_t no_timeframes() const
+  {
+    return property_failed.size();
+  }
+
+  // the values in new timeframes are unknown
+  void set_no_timeframes(std::size_t);
+
+  // removes the variables that are not given
+  void restrict_variables(const std::unordered_set<irep_idt> &);
+
+  // returns the index of the new variable
+  std::size_t add_variable(
+    symbol_exprt lhs,
+    std::size_t width,
+    source_locationt location = source_locationt::nil());
+
+  // the number of bits when values of the given type
+  // can be bit-packed, and zero otherwise
+  static std::size_t packed_width(const typet &);
+
+  // bits are numbered from the least significant one
+  void set_bit(
+    std::size_t variable,
+    std::size_t timeframe,
+    std::size_t bit_nr,
+    tvt value);
+
+  tvt get_bit(std::size_t variable, std::size_t timeframe, std::size_t bit_nr)
+    const;
+
+  // nil is an unknown value
+  void set_value(std::size_t variable, std::size_t timeframe, exprt value);
+
+  // returns nil when the value is unknown
+  exprt get_value(std::size_t variable, std::size_t timeframe) const;
+
+  // does the value differ from the one in the previous timeframe?
+  bool value_changed(std::size_t variable, std::size_t timeframe) const;
+
   // returns the latest failing timeframe, if any
   std::optional<std::size_t> get_max_failing_timeframe() const;
 
   // returns the earliest failing timeframe, if any
   std::optional<std::size_t> get_min_failing_timeframe() const;
+
+  // the timeframes to show: up to the earliest failing one
+  std::size_t timeframes_to_show() const
+  {
+    return get_min_failing_timeframe().value_or(no_timeframes() - 1) + 1;
+  }
+
+protected:
+  struct columnt
+  {
+    // bit number timeframe*width+bit_nr
+    std::vector<std::uint64_t> value, known;
+
+    // when the width is zero
+    std::vector<exprt> exprs;
+  };
+
+  std::vector<columnt> columns;
+
+  void resize(columnt &, std::size_t width);
 };
 
+// bit strings are given with the most significant bit first
+exprt bitstring_to_expr(const std::string &, const typet &);
+
 // outputting traces
 
 jsont json(const trans_tracet &, const namespacet &);
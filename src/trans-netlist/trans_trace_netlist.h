@@ -12,10 +12,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "bmc_map.h"
 #include "trans_trace.h"
 
+#include <unordered_set>
+
+// when given, only the values of the given variables are read
 trans_tracet compute_trans_trace(
   const bvt &prop_bv,
   const bmc_mapt &,
   const class propt &solver,
-  const namespacet &);
+  const namespacet &,
+  const std::optional<std::unordered_set<irep_idt>> &variables = {});
 
 #endif
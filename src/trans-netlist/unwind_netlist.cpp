@@ -8,6 +8,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "unwind_netlist.h"
 
+#include <util/ebmc_statistics.h>
 #include <util/ebmc_util.h>
 #include <util/expr_util.h>
 
@@ -21,24 +22,28 @@ Author: Daniel Kroening, kroening@kroening.com
 
 /*******************************************************************\
 
-Function: unwind
+Function: unwind_timeframe
 
   Inputs:
 
  Outputs:
 
- Purpose: Unwind timeframe by timeframe
+ Purpose: Unwind timeframe by timeframe; without encoding,
+          all AND nodes get the full Tseitin clauses
 
 \*******************************************************************/
 
-void unwind(
+static void unwind_timeframe(
   const netlistt &netlist,
   const bmc_mapt &bmc_map,
   messaget &message,
   cnft &solver,
   bool add_initial_state,
-  std::size_t t)
+  std::size_t t,
+  const netlist_encodingt *encoding)
 {
+  ebmc_phaset phase("timeframe " + std::to_string(t));
+
   bool first=(t==0);
   bool last=(t==bmc_map.timeframe_map.size()-1);
 
@@ -58,17 +63,24 @@ void unwind(
     message.progress() << "Transition " << t << "->" << t + 1 << messaget::eom;
 
   const bmc_mapt::timeframet &timeframe=bmc_map.timeframe_map[t];
-  
-  for(std::size_t n=0; n<timeframe.size(); n++)
-  {
-    const aig_nodet &node=netlist.get_node(literalt(n, false));
 
-    if(node.is_and())
+  if(encoding != nullptr)
+  {
+    encoding->encode(bmc_map, solver, t);
+  }
+  else
+  {
+    for(std::size_t n=0; n<timeframe.size(); n++)
     {
-      literalt la=bmc_map.translate(t, node.a);
-      literalt lb=bmc_map.translate(t, node.b);
+      const aig_nodet &node=netlist.get_node(literalt(n, false));
 
-      cnf_gate_and(solver, la, lb, timeframe[n].solver_literal);
+      if(node.is_and())
+      {
+        literalt la=bmc_map.translate(t, node.a);
+        literalt lb=bmc_map.translate(t, node.b);
+
+        cnf_gate_and(solver, la, lb, timeframe[n].solver_literal);
+      }
     }
   }
 
@@ -109,6 +121,55 @@ void unwind(
 
 /*******************************************************************\
 
+Function: unwind
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Unwind timeframe by timeframe
+
+\*******************************************************************/
+
+void unwind(
+  const netlistt &netlist,
+  const bmc_mapt &bmc_map,
+  messaget &message,
+  cnft &solver,
+  bool add_initial_state,
+  std::size_t t)
+{
+  unwind_timeframe(
+    netlist, bmc_map, message, solver, add_initial_state, t, nullptr);
+}
+
+/*******************************************************************\
+
+Function: unwind
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Unwind timeframe by timeframe, with the given encoding
+
+\*******************************************************************/
+
+void unwind(
+  const netlistt &netlist,
+  const bmc_mapt &bmc_map,
+  messaget &message,
+  cnft &solver,
+  bool add_initial_state,
+  std::size_t t,
+  const netlist_encodingt &encoding)
+{
+  unwind_timeframe(
+    netlist, bmc_map, message, solver, add_initial_state, t, &encoding);
+}
+
+/*******************************************************************\
+
 Function: unwind
 
   Inputs:
@@ -132,6 +193,30 @@ void unwind(
 
 /*******************************************************************\
 
+Function: unwind
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void unwind(
+  const netlistt &netlist,
+  const bmc_mapt &bmc_map,
+  messaget &message,
+  cnft &solver,
+  bool add_initial_state,
+  const netlist_encodingt &encoding)
+{
+  for(std::size_t t = 0; t < bmc_map.timeframe_map.size(); t++)
+    unwind(netlist, bmc_map, message, solver, add_initial_state, t, encoding);
+}
+
+/*******************************************************************\
+
 Function: unwind_property
 
   Inputs:
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "bmc_map.h"
 #include "netlist.h"
+#include "netlist_encoding.h"
 
 void unwind(
   const netlistt &netlist,
@@ -32,6 +33,24 @@ void unwind(
   bool add_initial_state,
   std::size_t timeframe);
 
+// as above, but using the given CNF encoding for the AND nodes
+void unwind(
+  const netlistt &netlist,
+  const bmc_mapt &bmc_map,
+  messaget &message,
+  cnft &solver,
+  bool add_initial_state,
+  const netlist_encodingt &);
+
+void unwind(
+  const netlistt &netlist,
+  const bmc_mapt &bmc_map,
+  messaget &message,
+  cnft &solver,
+  bool add_initial_state,
+  std::size_t timeframe,
+  const netlist_encodingt &);
+
 // Is the property supported?
 bool netlist_bmc_supports_property(const class exprt &);
 
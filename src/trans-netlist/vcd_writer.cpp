@@ -0,0 +1,685 @@
+/*******************************************************************\
+
+Module: Writing Traces in VCD Format
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Writing Traces in VCD Format
+
+#include "vcd_writer.h"
+
+#include <util/arith_tools.h>
+#include <util/pointer_offset_size.h>
+#include <util/prefix.h>
+#include <util/std_expr.h>
+
+#include <ctime>
+#include <map>
+#include <ostream>
+#include <set>
+
+/*******************************************************************\
+
+Function: vcd_width
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static mp_integer vcd_width(
+  const typet &type,
+  const namespacet &ns)
+{
+  if(
+    type.id() == ID_unsignedbv || type.id() == ID_signedbv ||
+    type.id() == ID_bv || type.id() == ID_fixedbv || type.id() == ID_floatbv ||
+    type.id() == ID_pointer)
+  {
+    return to_bitvector_type(type).get_width();
+  }
+  else if(type.id()==ID_array)
+  {
+    auto &array_type = to_array_type(type);
+    mp_integer sub = vcd_width(array_type.element_type(), ns);
+
+    // get size
+    const exprt &size = array_type.size();
+
+    // constant?
+    mp_integer i;
+
+    if(to_integer_non_constant(size, i))
+      return -1; // we cannot distinguish the elements
+    
+    return sub*i;
+  }
+  else if(type.id()==ID_struct)
+  {
+    const struct_typet &struct_type=to_struct_type(type);
+    const struct_typet::componentst &components=
+      struct_type.components();
+      
+    mp_integer result=0;
+    
+    for(const auto & it : components)
+    {
+      const typet &subtype=it.type();
+      mp_integer sub_size = *pointer_offset_size(subtype, ns);
+      if(sub_size==-1) return -1;
+      result+=sub_size;
+    }
+    
+    return result;
+  }
+  else if(type.id()==ID_bool)
+    return 1;
+  else if(type.id()==ID_integer)
+    return 32; // no better idea.
+  else
+    return -1;
+}
+
+/*******************************************************************\
+
+Function: as_vcd_binary
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::string as_vcd_binary(
+  const exprt &expr,
+  const namespacet &ns)
+{
+  const auto &type = expr.type();
+
+  if(expr.id()==ID_constant)
+  {
+    if(
+      type.id() == ID_unsignedbv || type.id() == ID_signedbv ||
+      type.id() == ID_bv || type.id() == ID_fixedbv ||
+      type.id() == ID_floatbv || type.id() == ID_pointer ||
+      type.id() == ID_integer)
+    {
+      mp_integer i = numeric_cast_v<mp_integer>(to_constant_expr(expr));
+      auto width = numeric_cast_v<std::size_t>(vcd_width(type, ns));
+      return integer2binary(i, width);
+    }
+  }
+  else if(expr.id()==ID_array)
+  {
+    std::string result;
+
+    forall_operands(it, expr)
+      result+=as_vcd_binary(*it, ns);
+    
+    return result;
+  }
+  else if(expr.id()==ID_struct)
+  {
+    std::string result;
+
+    forall_operands(it, expr)
+      result+=as_vcd_binary(*it, ns);
+    
+    return result;
+  }
+  else if(expr.id()==ID_union)
+  {
+    return as_vcd_binary(to_union_expr(expr).op(), ns);
+  }
+
+  // build "xxx"
+
+  mp_integer width=vcd_width(type, ns);
+
+  if(width>=0)
+  {
+    std::string result;
+
+    for(; width!=0; --width)
+      result+='x';
+
+    return result;
+  }
+  
+  return "";
+}
+
+/*******************************************************************\
+
+Function: vcd_reference
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::string
+vcd_reference(const symbolt &symbol, const std::string &prefix)
+{
+  std::string result = id2string(symbol.name);
+
+  if(!prefix.empty() && has_prefix(result, prefix))
+    result.erase(0, prefix.size());
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: vcd_suffix
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::string vcd_suffix(
+  const typet &type,
+  const namespacet &ns)
+{
+  if(type.id()==ID_unsignedbv ||
+     type.id()==ID_signedbv ||
+     type.id()==ID_bv ||
+     type.id()==ID_fixedbv ||
+     type.id()==ID_floatbv ||
+     type.id()==ID_verilog_signedbv ||
+     type.id()==ID_verilog_unsignedbv)
+  {
+    mp_integer width=vcd_width(type, ns);
+    mp_integer offset=string2integer(type.get_string(ID_C_offset));
+
+    mp_integer left_bound, right_bound;
+
+    left_bound = offset;
+    right_bound = left_bound+width-1;
+
+    if(!type.get_bool(ID_C_increasing))
+      std::swap(left_bound, right_bound);
+    
+    return "["+integer2string(left_bound)+":"+integer2string(right_bound)+"]";
+  }
+  else if(type.id()==ID_array)
+  {
+    // get size
+    auto &array_type = to_array_type(type);
+    const exprt &size = array_type.size();
+
+    // constant?
+    mp_integer i;
+
+    if(to_integer_non_constant(size, i))
+      return ""; // we cannot distinguish the elements
+
+    mp_integer left_bound, right_bound;
+    left_bound=0;
+    right_bound=left_bound+i-1;
+
+    return "[" + integer2string(left_bound) + ":" +
+           integer2string(right_bound) + "]" +
+           vcd_suffix(array_type.element_type(), ns);
+  }
+  else if(type.id()==ID_bool)
+    return "";
+  else if(type.id()==ID_integer)
+    return "";
+  else
+  {
+    mp_integer width=vcd_width(type, ns);
+    mp_integer left_bound, right_bound;
+    left_bound=0;
+    right_bound=left_bound+width-1;
+    return "["+integer2string(left_bound)+":"+integer2string(right_bound)+"]";
+  }
+}
+
+
+/*******************************************************************\
+
+Function: waveform_hierarchy_rec
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void waveform_hierarchy_rec(
+  const std::map<irep_idt, std::size_t> &ids,
+  const trans_tracet &trace,
+  const namespacet &ns,
+  const std::string &prefix,
+  waveform_scopet &scope)
+{
+  std::set<std::string> sub_modules;
+  std::vector<std::size_t> signals;
+
+  for(const auto &[identifier, v] : ids)
+  {
+    if(has_prefix(id2string(identifier), prefix))
+    {
+      std::string rest =
+        std::string(id2string(identifier), prefix.size(), std::string::npos);
+      std::size_t dot_pos = rest.find('.');
+      if(dot_pos == std::string::npos)
+        signals.push_back(v);
+      else
+        sub_modules.insert(std::string(rest, 0, dot_pos));
+    }
+  }
+
+  // do signals first
+  for(auto v : signals)
+  {
+    const symbolt &symbol = ns.lookup(trace.variables[v].lhs);
+
+    if(symbol.is_auxiliary)
+      continue;
+
+    mp_integer width = vcd_width(symbol.type, ns);
+
+    if(width < 1)
+      continue;
+
+    waveform_scopet::signalt signal;
+    signal.variable = v;
+    signal.width = numeric_cast_v<std::size_t>(width);
+    signal.reference = vcd_reference(symbol, prefix);
+    signal.suffix = vcd_suffix(symbol.type, ns);
+
+    if(symbol.type.id() == ID_integer)
+      signal.signal_class = "integer";
+    else if(symbol.is_state_var)
+      signal.signal_class = "reg";
+    else
+      signal.signal_class = "wire";
+
+    scope.signals.push_back(std::move(signal));
+  }
+
+  // now do sub modules
+  for(const auto &identifier : sub_modules)
+  {
+    scope.scopes.emplace_back();
+    scope.scopes.back().name = identifier;
+
+    // recursive call
+    waveform_hierarchy_rec(
+      ids, trace, ns, prefix + identifier + ".", scope.scopes.back());
+  }
+}
+
+/*******************************************************************\
+
+Function: waveform_hierarchy
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+waveform_scopet
+waveform_hierarchy(const trans_tracet &trace, const namespacet &ns)
+{
+  PRECONDITION(!trace.variables.empty());
+
+  std::map<irep_idt, std::size_t> ids;
+
+  for(std::size_t v = 0; v < trace.variables.size(); v++)
+    ids.emplace(trace.variables[v].lhs.get_identifier(), v);
+
+  // determine module
+  const symbolt &symbol1 = ns.lookup(trace.variables.front().lhs);
+  auto &module_symbol = ns.lookup(symbol1.module);
+
+  waveform_scopet top;
+  top.name = id2string(module_symbol.display_name());
+
+  // split up into hierarchy
+  waveform_hierarchy_rec(
+    ids, trace, ns, id2string(module_symbol.name) + ".", top);
+
+  return top;
+}
+
+/*******************************************************************\
+
+Function: waveform_value
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool waveform_value(
+  const trans_tracet &trace,
+  const namespacet &ns,
+  std::size_t v,
+  std::size_t t,
+  std::string &dest)
+{
+  const auto &variable = trace.variables[v];
+  const std::size_t start = dest.size();
+
+  if(variable.width != 0)
+  {
+    // straight from the bits, most significant bit first
+    bool known = false;
+
+    for(std::size_t i = variable.width; i-- != 0;)
+    {
+      tvt bit = trace.get_bit(v, t, i);
+      if(bit.is_known())
+      {
+        known = true;
+        dest += bit.is_true() ? '1' : '0';
+      }
+      else
+        dest += 'x';
+    }
+
+    if(!known)
+      dest.resize(start);
+
+    return known;
+  }
+
+  const exprt rhs = trace.get_value(v, t);
+
+  if(rhs.is_nil()) // no value
+    return false;
+
+  if(rhs.type().id() == ID_bool)
+    dest += rhs.is_true() ? '1' : rhs.is_false() ? '0' : 'x';
+  else
+    dest += as_vcd_binary(rhs, ns);
+
+  return true;
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::identifier_code
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: bijective base-94 numbering with the printable
+          characters '!' to '~'
+
+\*******************************************************************/
+
+std::string vcd_writert::identifier_code(std::size_t n)
+{
+  std::string result;
+
+  do
+  {
+    result += char('!' + n % 94);
+    n /= 94;
+  } while(n-- != 0);
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::same_design
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: are the definitions valid for the given trace?
+
+\*******************************************************************/
+
+bool vcd_writert::same_design(const trans_tracet &trace) const
+{
+  if(identifiers.size() != trace.variables.size())
+    return false;
+
+  for(std::size_t v = 0; v < identifiers.size(); v++)
+    if(identifiers[v] != trace.variables[v].lhs.get_identifier())
+      return false;
+
+  return true;
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::build_definitions
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void vcd_writert::build_definitions(
+  const trans_tracet &trace,
+  const namespacet &ns)
+{
+  identifiers.clear();
+  identifiers.reserve(trace.variables.size());
+
+  for(auto &variable : trace.variables)
+    identifiers.push_back(variable.lhs.get_identifier());
+
+  codes.clear();
+  codes.resize(trace.variables.size());
+  number_of_codes = 0;
+  definitions.clear();
+
+  auto top = waveform_hierarchy(trace, ns);
+
+  // print those in the top module
+  definitions += "$scope module " + top.name + " $end\n";
+  definitions_rec(top, 1);
+  definitions += "$upscope $end\n";
+  definitions += "$enddefinitions $end\n";
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::definitions_rec
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void vcd_writert::definitions_rec(
+  const waveform_scopet &scope,
+  std::size_t depth)
+{
+  const std::string indent(depth * 2, ' ');
+
+  for(auto &signal : scope.signals)
+  {
+    auto &code = codes[signal.variable];
+    code = identifier_code(number_of_codes++);
+
+    definitions += indent + "$var " + signal.signal_class + " " +
+                   std::to_string(signal.width) + " " + code + " " +
+                   signal.reference + (signal.suffix == "" ? "" : " ") +
+                   signal.suffix + " $end\n";
+  }
+
+  for(auto &sub_scope : scope.scopes)
+  {
+    definitions += indent + "$scope module " + sub_scope.name + " $end\n";
+    definitions_rec(sub_scope, depth + 1);
+    definitions += indent + "$upscope $end\n";
+  }
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::write_value
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: append the value of the given variable in the given
+          timeframe to the buffer, unless it is unknown
+
+\*******************************************************************/
+
+void vcd_writert::write_value(
+  const trans_tracet &trace,
+  const namespacet &ns,
+  std::size_t v,
+  std::size_t t)
+{
+  // booleans are special -- no 'b' and no space!
+  const bool is_bool = trace.variables[v].lhs.type().id() == ID_bool;
+  const std::size_t start = buffer.size();
+
+  if(!is_bool)
+    buffer += 'b';
+
+  if(!waveform_value(trace, ns, v, t, buffer))
+  {
+    buffer.resize(start);
+    return;
+  }
+
+  if(!is_bool)
+    buffer += ' ';
+
+  buffer += codes[v];
+  buffer += '\n';
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::flush
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void vcd_writert::flush(std::ostream &out)
+{
+  out.write(buffer.data(), buffer.size());
+  buffer.clear();
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void vcd_writert::operator()(
+  const trans_tracet &trace,
+  const namespacet &ns,
+  std::ostream &out)
+{
+  buffer.reserve(buffer_size + buffer_size / 4);
+
+  time_t t;
+  time(&t);
+  buffer += "$date\n  ";
+  buffer += ctime(&t);
+  buffer += "$end\n";
+
+  buffer += "$timescale\n  1ns\n$end\n";
+
+  if(trace.no_timeframes() == 0)
+  {
+    flush(out);
+    return;
+  }
+
+  if(!same_design(trace))
+    build_definitions(trace, ns);
+
+  buffer += definitions;
+
+  const std::size_t timeframes = trace.timeframes_to_show();
+
+  for(std::size_t timeframe = 0; timeframe < timeframes; timeframe++)
+  {
+    buffer += '#';
+    buffer += std::to_string(timeframe);
+    buffer += '\n';
+
+    for(std::size_t v = 0; v < codes.size(); v++)
+    {
+      if(!codes[v].empty() && trace.value_changed(v, timeframe))
+        write_value(trace, ns, v, timeframe);
+    }
+
+    if(buffer.size() >= buffer_size)
+      flush(out);
+  }
+
+  flush(out);
+}
+
+/*******************************************************************\
+
+Function: show_trans_trace_vcd
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: dumps the counterexample trace in vcd format to be
+          viewed in modelsim or any other simulator
+
+\*******************************************************************/
+
+void show_trans_trace_vcd(
+  const trans_tracet &trace,
+  messaget &,
+  const namespacet &ns,
+  std::ostream &out)
+{
+  vcd_writert()(trace, ns, out);
+}
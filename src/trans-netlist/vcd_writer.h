@@ -0,0 +1,98 @@
+/*******************************************************************\
+
+Module: Writing Traces in VCD Format
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Writing Traces in VCD Format
+
+#ifndef CPROVER_TRANS_NETLIST_VCD_WRITER_H
+#define CPROVER_TRANS_NETLIST_VCD_WRITER_H
+
+#include "trans_trace.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/// A scope of the hierarchy of a trace, as shown in waveform viewers
+struct waveform_scopet
+{
+  std::string name;
+
+  struct signalt
+  {
+    // the index of the variable in the trace
+    std::size_t variable;
+    // wire, reg or integer
+    std::string signal_class;
+    std::size_t width;
+    // the name in the scope, and the bit range, if any
+    std::string reference, suffix;
+  };
+
+  std::vector<signalt> signals;
+  std::vector<waveform_scopet> scopes;
+};
+
+/// The scope of the top module, with the variables of the trace
+/// that can be shown, and the scopes of the submodules
+waveform_scopet waveform_hierarchy(const trans_tracet &, const namespacet &);
+
+/// Appends the value of the variable in the timeframe to the string,
+/// as bits with the most significant bit first and x for unknown bits.
+/// Returns false, and appends nothing, when the value is unknown.
+bool waveform_value(
+  const trans_tracet &,
+  const namespacet &,
+  std::size_t variable,
+  std::size_t timeframe,
+  std::string &);
+
+/// Writes traces as value change dumps.
+/// The scope hierarchy and the identifier codes are computed for the
+/// first trace, and are reused for all further traces over the same
+/// variables, e.g., the traces of a random simulation.
+/// Identifier codes are short base-94 strings.
+/// Only the values that change are written, and the output is
+/// collected in a large buffer that is written with one call
+/// per flush.
+class vcd_writert
+{
+public:
+  /// write the trace as a complete VCD file
+  void
+  operator()(const trans_tracet &, const namespacet &, std::ostream &);
+
+protected:
+  // the identifiers of the variables the definitions were built for
+  std::vector<irep_idt> identifiers;
+
+  // the $scope/$var section, ending in $enddefinitions
+  std::string definitions;
+
+  // one entry per variable of the trace, empty if not declared
+  std::vector<std::string> codes;
+  std::size_t number_of_codes = 0;
+
+  std::string buffer;
+  static constexpr std::size_t buffer_size = 1 << 20;
+
+  void flush(std::ostream &);
+  bool same_design(const trans_tracet &) const;
+  void build_definitions(const trans_tracet &, const namespacet &);
+  void definitions_rec(const waveform_scopet &, std::size_t depth);
+  void write_value(
+    const trans_tracet &,
+    const namespacet &,
+    std::size_t v,
+    std::size_t t);
+
+  // the code for the given number
+  static std::string identifier_code(std::size_t);
+};
+
+#endif // CPROVER_TRANS_NETLIST_VCD_WRITER_H
@@ -28,7 +28,8 @@ trans_tracet compute_trans_trace(
   const decision_proceduret &decision_procedure,
   std::size_t no_timeframes,
   const namespacet &ns,
-  const irep_idt &module)
+  const irep_idt &module,
+  const std::optional<std::unordered_set<irep_idt>> &variables)
 {
   trans_tracet dest;
 
@@ -38,47 +39,58 @@ trans_tracet compute_trans_trace(
     dest.mode=id2string(symbol.mode);
   }
 
-  dest.states.resize(no_timeframes);
+  const symbol_tablet &symbol_table = ns.get_symbol_table();
+
+  // the variables, once for all timeframes
+  std::vector<const symbolt *> symbols;
+
+  for(auto it=symbol_table.symbol_module_map.lower_bound(module);
+      it!=symbol_table.symbol_module_map.upper_bound(module);
+      it++)
+  {
+    const symbolt &symbol=ns.lookup(it->second);
+
+    if(!symbol.is_type &&
+       !symbol.is_property &&
+       symbol.type.id()!=ID_module &&
+       symbol.type.id()!=ID_module_instance)
+    {
+      if(symbol.is_macro && !symbol.value.is_constant())
+        continue;
+
+      if(variables.has_value() && variables->count(symbol.name) == 0)
+        continue;
+
+      dest.add_variable(
+        symbol.symbol_expr(), trans_tracet::packed_width(symbol.type));
+      symbols.push_back(&symbol);
+    }
+  }
+
+  dest.set_no_timeframes(no_timeframes);
 
   for(std::size_t t = 0; t < no_timeframes; t++)
   {
-    const symbol_tablet &symbol_table=ns.get_symbol_table();
-
-    DATA_INVARIANT(t < dest.states.size(), "t is in range");
-    trans_tracet::statet &state=dest.states[t];
-    
-    for(auto it=symbol_table.symbol_module_map.lower_bound(module);
-        it!=symbol_table.symbol_module_map.upper_bound(module);
-        it++)
+    for(std::size_t v = 0; v < symbols.size(); v++)
     {
-      const symbolt &symbol=ns.lookup(it->second);
+      const symbolt &symbol = *symbols[v];
 
-      if(!symbol.is_type &&
-         !symbol.is_property &&
-         symbol.type.id()!=ID_module &&
-         symbol.type.id()!=ID_module_instance)
+      if(symbol.is_macro)
+      {
+        dest.set_value(v, t, symbol.value);
+      }
+      else
       {
-        if(symbol.is_macro)
-        {
-          if(symbol.value.is_constant())
-          {
-            state.assignments.emplace_back(symbol.symbol_expr(), symbol.value);
-          }
-        }
-        else
-        {
-          exprt indexed_symbol_expr(ID_symbol, symbol.type);
-
-          indexed_symbol_expr.set(
-            ID_identifier, timeframe_identifier(t, symbol.name));
-
-          exprt value_expr = decision_procedure.get(indexed_symbol_expr);
-          if(value_expr == indexed_symbol_expr)
-            value_expr = nil_exprt();
-
-          state.assignments.emplace_back(
-            symbol.symbol_expr(), std::move(value_expr));
-        }
+        exprt indexed_symbol_expr(ID_symbol, symbol.type);
+
+        indexed_symbol_expr.set(
+          ID_identifier, timeframe_identifier(t, symbol.name));
+
+        exprt value_expr = decision_procedure.get(indexed_symbol_expr);
+        if(value_expr == indexed_symbol_expr)
+          value_expr = nil_exprt();
+
+        dest.set_value(v, t, std::move(value_expr));
       }
     }
   }
@@ -103,20 +115,40 @@ trans_tracet compute_trans_trace(
   const decision_proceduret &solver,
   std::size_t no_timeframes,
   const namespacet &ns,
-  const irep_idt &module)
+  const irep_idt &module,
+  const std::optional<std::unordered_set<irep_idt>> &variables)
 {
-  trans_tracet trace = compute_trans_trace(solver, no_timeframes, ns, module);
+  trans_tracet trace =
+    compute_trans_trace(solver, no_timeframes, ns, module, variables);
 
-  // check the properties that got violated
+  compute_property_failed(prop_handles, solver, trace);
 
-  for(std::size_t t = 0; t < no_timeframes; t++)
+  return trace;
+}
+
+/*******************************************************************\
+
+Function: compute_property_failed
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: check the properties that got violated
+
+\*******************************************************************/
+
+void compute_property_failed(
+  const exprt::operandst &prop_handles,
+  const decision_proceduret &solver,
+  trans_tracet &trace)
+{
+  for(std::size_t t = 0; t < trace.no_timeframes(); t++)
   {
     DATA_INVARIANT(
       t < prop_handles.size(),
       "There must be exactly one prop_handles element per time frame");
     auto result = solver.get(prop_handles[t]);
-    trace.states[t].property_failed = result.is_false();
+    trace.property_failed[t] = result.is_false();
   }
-
-  return trace;
 }
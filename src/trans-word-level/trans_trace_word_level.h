@@ -13,13 +13,17 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "../trans-netlist/trans_trace.h"
 
-// word-level without properties
+#include <unordered_set>
+
+// word-level without properties;
+// when given, only the values of the given variables are read
 
 trans_tracet compute_trans_trace(
   const decision_proceduret &,
   std::size_t no_timeframes,
   const namespacet &,
-  const irep_idt &module);
+  const irep_idt &module,
+  const std::optional<std::unordered_set<irep_idt>> &variables = {});
 
 // word-level with properties
 
@@ -28,6 +32,13 @@ trans_tracet compute_trans_trace(
   const decision_proceduret &solver,
   std::size_t no_timeframes,
   const namespacet &ns,
-  const irep_idt &module);
+  const irep_idt &module,
+  const std::optional<std::unordered_set<irep_idt>> &variables = {});
+
+// set the timeframes in which the property fails
+void compute_property_failed(
+  const exprt::operandst &prop_handles,
+  const decision_proceduret &,
+  trans_tracet &);
 
 #endif
@@ -8,6 +8,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "unwind.h"
 
+#include <util/ebmc_statistics.h>
 #include <util/expr_util.h>
 #include <util/find_symbols.h>
 #include <util/namespace.h>
@@ -75,6 +76,8 @@ void unwind(
         message.progress() << "Transition " << t << "->" << t + 1
                            << messaget::eom;
 
+      ebmc_phaset phase("timeframe " + std::to_string(t));
+
       decision_procedure.set_to_true(instantiate(op_trans, t, no_timeframes));
     }
 }
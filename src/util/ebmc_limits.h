@@ -0,0 +1,217 @@
+/*******************************************************************\
+
+Module: Resource Limits
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Limits on time and memory, for --timeout, --per-property-timeout
+/// and --memout
+
+#ifndef HW_CBMC_UTIL_EBMC_LIMITS_H
+#define HW_CBMC_UTIL_EBMC_LIMITS_H
+
+#include <util/ebmc_statistics.h>
+#include <util/irep.h>
+
+#include <chrono>
+#include <map>
+#include <optional>
+#include <string>
+
+/// Thrown by ebmc_limitst::check when a limit is exceeded
+class ebmc_limit_exceededt
+{
+public:
+  explicit ebmc_limit_exceededt(std::string _reason)
+    : reason(std::move(_reason))
+  {
+  }
+
+  std::string reason;
+};
+
+/// The limits on the run time and the memory of the process, and on
+/// the time spent on one property. The limits are not enforced
+/// preemptively; the engines check them between their steps, e.g.,
+/// between solver calls, timeframes or fixpoint iterations, and give
+/// up on the property that they are working on.
+class ebmc_limitst
+{
+public:
+  using clockt = std::chrono::steady_clock;
+
+  std::optional<clockt::duration> timeout;
+  std::optional<clockt::time_point> deadline;
+  std::optional<clockt::duration> property_timeout;
+  std::optional<clockt::time_point> property_deadline;
+  std::optional<std::size_t> memout; // kilobytes
+
+  void set_timeout(double seconds)
+  {
+    timeout = to_duration(seconds);
+    restart_timeout();
+  }
+
+  /// Starts the clock of --timeout again, e.g., for the next request
+  /// of --server.
+  void restart_timeout()
+  {
+    if(timeout.has_value())
+      deadline = clockt::now() + *timeout;
+  }
+
+  void set_property_timeout(double seconds)
+  {
+    property_timeout = to_duration(seconds);
+  }
+
+  /// why a limit is exceeded, if one is
+  std::optional<std::string> exceeded() const
+  {
+    if(memory_exceeded())
+      return "memout";
+
+    return time_exceeded();
+  }
+
+  /// Like exceeded(), but reads the memory usage, which takes a
+  /// system call, at most once per poll_interval. For the checks
+  /// in the inner loops of the engines.
+  std::optional<std::string> poll()
+  {
+    auto now = clockt::now();
+
+    if(!last_poll.has_value() || now - *last_poll >= poll_interval)
+    {
+      last_poll = now;
+      if(memory_exceeded())
+        return "memout";
+    }
+
+    return time_exceeded(now);
+  }
+
+  /// whether a limit that applies to the whole run is exceeded
+  bool run_exceeded() const
+  {
+    auto reason = exceeded();
+    return reason.has_value() && *reason != "property timeout";
+  }
+
+  /// throws ebmc_limit_exceededt when a limit is exceeded
+  void check() const
+  {
+    auto reason = exceeded();
+    if(reason.has_value())
+      throw ebmc_limit_exceededt{*reason};
+  }
+
+protected:
+  static constexpr std::chrono::milliseconds poll_interval{100};
+  std::optional<clockt::time_point> last_poll;
+
+  static clockt::duration to_duration(double seconds)
+  {
+    return std::chrono::duration_cast<clockt::duration>(
+      std::chrono::duration<double>(seconds));
+  }
+
+  bool memory_exceeded() const
+  {
+    return memout.has_value() && ebmc_statisticst::peak_rss() > *memout;
+  }
+
+  std::optional<std::string> time_exceeded() const
+  {
+    if(!deadline.has_value() && !property_deadline.has_value())
+      return {};
+
+    return time_exceeded(clockt::now());
+  }
+
+  std::optional<std::string> time_exceeded(clockt::time_point now) const
+  {
+    if(deadline.has_value() && now >= *deadline)
+      return "timeout";
+
+    if(property_deadline.has_value() && now >= *property_deadline)
+      return "property timeout";
+
+    return {};
+  }
+};
+
+/// the limits of this process
+inline ebmc_limitst &ebmc_limits()
+{
+  static ebmc_limitst limits;
+  return limits;
+}
+
+/// Starts the clock of --per-property-timeout when constructed,
+/// and restores the enclosing clock when destroyed. For engines
+/// that work on one property at a time; see ebmc_property_timest
+/// for the engines that work on several properties in turns.
+class ebmc_property_clockt
+{
+public:
+  ebmc_property_clockt()
+    : limits(ebmc_limits()), saved(limits.property_deadline)
+  {
+    if(limits.property_timeout.has_value())
+    {
+      auto deadline = ebmc_limitst::clockt::now() + *limits.property_timeout;
+
+      // a nested clock can't extend the enclosing one
+      if(!saved.has_value() || deadline < *saved)
+        limits.property_deadline = deadline;
+    }
+  }
+
+  ebmc_property_clockt(const ebmc_property_clockt &) = delete;
+  ebmc_property_clockt &operator=(const ebmc_property_clockt &) = delete;
+
+  ~ebmc_property_clockt()
+  {
+    limits.property_deadline = saved;
+  }
+
+protected:
+  ebmc_limitst &limits;
+  std::optional<ebmc_limitst::clockt::time_point> saved;
+};
+
+/// The solver time spent on each property, for --per-property-timeout
+/// in engines that work on several properties in turns, e.g., with
+/// one solver call per property and timeframe. The time of a solver
+/// call is charged to each of the properties that it is about.
+class ebmc_property_timest
+{
+public:
+  using clockt = ebmc_limitst::clockt;
+
+  /// whether the property has used up its time
+  bool exceeded(const irep_idt &identifier) const
+  {
+    const auto &timeout = ebmc_limits().property_timeout;
+    if(!timeout.has_value())
+      return false;
+
+    auto it = spent.find(identifier);
+    auto time = it == spent.end() ? clockt::duration::zero() : it->second;
+    return time >= *timeout;
+  }
+
+  void charge(const irep_idt &identifier, clockt::duration time)
+  {
+    spent[identifier] += time;
+  }
+
+protected:
+  std::map<irep_idt, clockt::duration> spent;
+};
+
+#endif // HW_CBMC_UTIL_EBMC_LIMITS_H
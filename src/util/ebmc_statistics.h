@@ -0,0 +1,169 @@
+/*******************************************************************\
+
+Module: Phase Timers and Counters
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Hierarchical phase timers and counters, for --stats-json
+
+#ifndef HW_CBMC_UTIL_EBMC_STATISTICS_H
+#define HW_CBMC_UTIL_EBMC_STATISTICS_H
+
+#include <util/json.h>
+
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#  include <sys/resource.h>
+#endif
+
+/// A tree of phases. Each phase records the wall-clock time, the CPU
+/// time, and the peak resident set size at the end of the phase, and
+/// any number of named counters. Phases entered repeatedly under the
+/// same parent with the same name are accumulated.
+class ebmc_statisticst
+{
+public:
+  struct phaset
+  {
+    explicit phaset(std::string _name, phaset *_parent)
+      : name(std::move(_name)), parent(_parent)
+    {
+    }
+
+    std::string name;
+    phaset *parent;
+    std::size_t entered = 0;
+    double wall_time = 0, cpu_time = 0; // seconds
+    std::size_t peak_rss = 0;           // kilobytes
+    std::map<std::string, double> counters;
+
+    // in the order they were first entered
+    std::vector<std::unique_ptr<phaset>> children;
+
+    phaset &child(const std::string &child_name)
+    {
+      for(auto &c : children)
+        if(c->name == child_name)
+          return *c;
+      children.push_back(std::make_unique<phaset>(child_name, this));
+      return *children.back();
+    }
+
+    json_objectt json() const
+    {
+      json_objectt result;
+      result["name"] = json_stringt{name};
+      result["entered"] = json_numbert{std::to_string(entered)};
+      result["wallTime"] = json_numbert{std::to_string(wall_time)};
+      result["cpuTime"] = json_numbert{std::to_string(cpu_time)};
+      result["peakRSS"] = json_numbert{std::to_string(peak_rss)};
+
+      if(!counters.empty())
+      {
+        json_objectt json_counters;
+        for(auto &[counter_name, value] : counters)
+          json_counters[counter_name] = json_numbert{std::to_string(value)};
+        result["counters"] = std::move(json_counters);
+      }
+
+      if(!children.empty())
+      {
+        json_arrayt json_children;
+        for(auto &c : children)
+          json_children.push_back(c->json());
+        result["phases"] = std::move(json_children);
+      }
+
+      return result;
+    }
+  };
+
+  phaset root{"ebmc", nullptr};
+  phaset *current = &root;
+
+  /// add to a counter of the current phase
+  void count(const std::string &name, double value = 1)
+  {
+    current->counters[name] += value;
+  }
+
+  /// peak resident set size of the process so far, in kilobytes
+  static std::size_t peak_rss()
+  {
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+      return 0;
+#  ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // bytes on macOS
+#  else
+    return usage.ru_maxrss;
+#  endif
+#endif
+  }
+
+  json_objectt json() const
+  {
+    auto result = root.json();
+    result["peakRSS"] = json_numbert{std::to_string(peak_rss())};
+    return result;
+  }
+};
+
+/// the statistics of this process
+inline ebmc_statisticst &ebmc_statistics()
+{
+  static ebmc_statisticst statistics;
+  return statistics;
+}
+
+/// Records a phase, nested in the phase that is current
+/// when the object is constructed, until it is destroyed.
+class ebmc_phaset
+{
+public:
+  explicit ebmc_phaset(const std::string &name)
+    : statistics(ebmc_statistics()),
+      phase(statistics.current->child(name)),
+      wall_start(std::chrono::steady_clock::now()),
+      cpu_start(std::clock())
+  {
+    phase.entered++;
+    statistics.current = &phase;
+  }
+
+  ebmc_phaset(const ebmc_phaset &) = delete;
+  ebmc_phaset &operator=(const ebmc_phaset &) = delete;
+
+  ~ebmc_phaset()
+  {
+    auto wall_stop = std::chrono::steady_clock::now();
+    auto cpu_stop = std::clock();
+
+    phase.wall_time +=
+      std::chrono::duration<double>(wall_stop - wall_start).count();
+    phase.cpu_time += double(cpu_stop - cpu_start) / CLOCKS_PER_SEC;
+    phase.peak_rss = ebmc_statisticst::peak_rss();
+
+    statistics.current = phase.parent;
+  }
+
+protected:
+  ebmc_statisticst &statistics;
+  ebmc_statisticst::phaset &phase;
+  std::chrono::steady_clock::time_point wall_start;
+  std::clock_t cpu_start;
+};
+
+#endif // HW_CBMC_UTIL_EBMC_STATISTICS_H
@@ -0,0 +1,94 @@
+/*******************************************************************\
+
+Module: Memory-Mapped Input Files
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Memory-Mapped Input Files
+
+#include "mapped_file.h"
+
+#include <util/unicode.h>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#ifndef _WIN32
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+mapped_filet::mapped_filet(const std::string &file_name)
+{
+#ifndef _WIN32
+  int fd = open(file_name.c_str(), O_RDONLY);
+
+  if(fd != -1)
+  {
+    struct stat buf;
+
+    if(fstat(fd, &buf) == 0 && S_ISREG(buf.st_mode))
+    {
+      _is_open = true;
+      _size = buf.st_size;
+
+      // mmap does not accept empty files
+      if(_size != 0)
+      {
+        void *address = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if(address != MAP_FAILED)
+        {
+          // we read the file front to back
+          madvise(address, _size, MADV_SEQUENTIAL);
+          _data = static_cast<const char *>(address);
+          is_mapped = true;
+        }
+      }
+    }
+
+    close(fd);
+
+    if(is_mapped || (_is_open && _size == 0))
+      return;
+  }
+#endif
+
+  // fall back to reading the file
+  std::ifstream in(widen_if_needed(file_name), std::ios::binary);
+
+  if(!in)
+  {
+    _is_open = false;
+    _size = 0;
+    return;
+  }
+
+  std::ostringstream buffer;
+  buffer << in.rdbuf();
+  fallback = buffer.str();
+
+  _is_open = true;
+  _data = fallback.data();
+  _size = fallback.size();
+}
+
+mapped_filet::~mapped_filet()
+{
+#ifndef _WIN32
+  if(is_mapped)
+    munmap(const_cast<char *>(_data), _size);
+#endif
+}
+
+bool memory_streambuft::contains(char ch) const
+{
+  return size != 0 && std::memchr(data, ch, size) != nullptr;
+}
@@ -0,0 +1,92 @@
+/*******************************************************************\
+
+Module: Memory-Mapped Input Files
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Memory-Mapped Input Files
+
+#ifndef CPROVER_VERILOG_MAPPED_FILE_H
+#define CPROVER_VERILOG_MAPPED_FILE_H
+
+#include <istream>
+#include <streambuf>
+#include <string>
+
+/// A read-only view of the contents of a file.
+/// The file is memory-mapped where the platform supports it,
+/// and read into memory otherwise.
+class mapped_filet final
+{
+public:
+  mapped_filet() = default;
+  explicit mapped_filet(const std::string &file_name);
+  ~mapped_filet();
+
+  mapped_filet(const mapped_filet &) = delete;
+  mapped_filet &operator=(const mapped_filet &) = delete;
+
+  /// false if the file could not be opened
+  bool is_open() const
+  {
+    return _is_open;
+  }
+
+  const char *data() const
+  {
+    return _data;
+  }
+
+  std::size_t size() const
+  {
+    return _size;
+  }
+
+protected:
+  bool _is_open = false;
+  const char *_data = nullptr;
+  std::size_t _size = 0;
+  bool is_mapped = false;
+  std::string fallback; // when mapping is not possible
+};
+
+/// A stream buffer that reads directly from a given memory region,
+/// without copying it.
+class memory_streambuft : public std::streambuf
+{
+public:
+  memory_streambuft(const char *_data, std::size_t _size)
+    : data(_data), size(_size)
+  {
+    // std::streambuf wants non-const pointers; we never write.
+    char *begin = const_cast<char *>(_data);
+    setg(begin, begin, begin + _size);
+  }
+
+  /// true if the given character occurs in the memory region
+  bool contains(char) const;
+
+  const char *data;
+  std::size_t size;
+};
+
+/// An input stream over a memory-mapped file
+class mapped_istreamt : public std::istream
+{
+public:
+  explicit mapped_istreamt(const mapped_filet &file)
+    : std::istream(nullptr), streambuf(file.data(), file.size())
+  {
+    rdbuf(&streambuf);
+    if(!file.is_open())
+      setstate(std::ios::failbit);
+  }
+
+protected:
+  memory_streambuft streambuf;
+};
+
+#endif // CPROVER_VERILOG_MAPPED_FILE_H
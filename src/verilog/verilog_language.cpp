@@ -8,6 +8,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <sstream>
 
+#include <util/ebmc_statistics.h>
 #include <util/suffix.h>
 #include <util/symbol_table.h>
 
@@ -15,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "verilog_typecheck.h"
 #include "verilog_synthesis.h"
 #include "expr2verilog.h"
+#include "mapped_file.h"
 #include "verilog_parser.h"
 #include "verilog_preprocessor.h"
 
@@ -60,11 +62,6 @@ bool verilog_languaget::parse(
   const std::string &path,
   message_handlert &message_handler)
 {
-  std::stringstream str;
-
-  if(preprocess(instream, path, str, message_handler))
-    return true;
-
   verilog_standardt standard;
 
   if(has_suffix(path, ".sv") || force_systemverilog)
@@ -77,13 +74,29 @@ bool verilog_languaget::parse(
   verilog_parsert verilog_parser(standard, message_handler);
 
   verilog_parser.set_file(path);
-  verilog_parser.in=&str;
   verilog_parser.grammar=verilog_parsert::LANGUAGE;
 
+  // Memory-mapped files without any compiler directive
+  // are given to the parser directly.
+  auto memory_streambuf = dynamic_cast<memory_streambuft *>(instream.rdbuf());
+
+  bool direct =
+    memory_streambuf != nullptr && !memory_streambuf->contains('`');
+
+  // Otherwise, the preprocessor runs as the parser consumes its output.
+  verilog_preprocessor_streambuft preprocessor_streambuf(
+    instream, message_handler, path, include_paths, initial_defines);
+  std::istream preprocessed(&preprocessor_streambuf);
+
+  verilog_parser.in = direct ? &instream : &preprocessed;
+
   verilog_scanner_init();
 
   bool result=verilog_parser.parse();
 
+  if(preprocessor_streambuf.has_errors())
+    result = true;
+
   parse_tree.swap(verilog_parser.parse_tree);
 
   parse_tree.build_item_map();
@@ -185,13 +198,19 @@ bool verilog_languaget::typecheck(
 {
   if(module=="") return false;
 
-  if(verilog_typecheck(
-       parse_tree, symbol_table, module, warn_implicit_nets, message_handler))
-    return true;
+  {
+    ebmc_phaset phase("typecheck");
+
+    if(verilog_typecheck(
+         parse_tree, symbol_table, module, warn_implicit_nets, message_handler))
+      return true;
+  }
 
   messaget message(message_handler);
   message.debug() << "Synthesis " << module << messaget::eom;
 
+  ebmc_phaset phase("synthesis");
+
   if(verilog_synthesis(
        symbol_table,
        module,
@@ -8,6 +8,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "verilog_preprocessor.h"
 
+#include <util/ebmc_statistics.h>
 #include <util/unicode.h>
 
 #include "expr2verilog.h"
@@ -182,8 +183,28 @@ Function: verilog_preprocessort::preprocessor
 
 void verilog_preprocessort::preprocessor()
 {
-  bool error_found = false;
+  start();
 
+  while(step())
+    ;
+
+  finish();
+}
+
+/*******************************************************************\
+
+Function: verilog_preprocessort::start
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: set up the initial defines and the context of the input file
+
+\*******************************************************************/
+
+void verilog_preprocessort::start()
+{
   try
   {
     // set up the initial defines
@@ -206,56 +227,32 @@ void verilog_preprocessort::preprocessor()
 
     // the first context is the input file
     context_stack.emplace_back(false, &in, widen_if_needed(filename));
+  }
+  catch(const verilog_preprocessor_errort &e)
+  {
+    error() << e.what() << eom;
+    error_found = true;
+  }
+}
 
-    while(!context_stack.empty())
-    {
-      while(!tokenizer().eof())
-      {
-        // Emit line directive to get parser line count
-        // back in sync with preprocessor line count.
-        if(
-          condition && context().is_file() &&
-          parser_line_no != tokenizer().line_no())
-        {
-          emit_line_directive(0); // 'neither'
-        }
-
-        // Read a token.
-        auto token = tokenizer().next_token();
-        if(token == '`')
-        {
-          try
-          {
-            directive();
-          }
-          catch(const verilog_preprocessor_errort &e)
-          {
-            error().source_location = context().make_source_location();
-            error() << e.what() << eom;
-            error_found = true;
-          }
-        }
-        else if(condition)
-        {
-          auto a_it = context().define_arguments.find(token.text);
-          if(a_it == context().define_arguments.end())
-          {
-            // Not an argument, just emit
-            out << token;
-
-            // track parser line number
-            if(token == '\n')
-              parser_line_no++;
-          }
-          else
-          {
-            // Create a new context for the define argument.
-            // We then continue in that context.
-            context_stack.emplace_back(a_it->second);
-          }
-        }
-      }
+/*******************************************************************\
+
+Function: verilog_preprocessort::step
+
+  Inputs:
+
+ Outputs: false once the input is exhausted
+
+ Purpose: process the next token
 
+\*******************************************************************/
+
+bool verilog_preprocessort::step()
+{
+  try
+  {
+    while(!context_stack.empty() && tokenizer().eof())
+    {
       const bool is_file = context().is_file();
       context_stack.pop_back();
 
@@ -263,6 +260,55 @@ void verilog_preprocessort::preprocessor()
       if(!context_stack.empty() && is_file)
         emit_line_directive(2); // 'exit'
     }
+
+    if(context_stack.empty())
+      return false;
+
+    // Emit line directive to get parser line count
+    // back in sync with preprocessor line count.
+    if(
+      condition && context().is_file() &&
+      parser_line_no != tokenizer().line_no())
+    {
+      emit_line_directive(0); // 'neither'
+    }
+
+    // Read a token.
+    auto token = tokenizer().next_token();
+    if(token == '`')
+    {
+      try
+      {
+        directive();
+      }
+      catch(const verilog_preprocessor_errort &e)
+      {
+        error().source_location = context().make_source_location();
+        error() << e.what() << eom;
+        error_found = true;
+      }
+    }
+    else if(condition)
+    {
+      auto a_it = context().define_arguments.find(token.text);
+      if(a_it == context().define_arguments.end())
+      {
+        // Not an argument, just emit
+        out << token;
+
+        // track parser line number
+        if(token == '\n')
+          parser_line_no++;
+      }
+      else
+      {
+        // Create a new context for the define argument.
+        // We then continue in that context.
+        context_stack.emplace_back(a_it->second);
+      }
+    }
+
+    return true;
   }
   catch(const verilog_preprocessor_errort &e)
   {
@@ -270,14 +316,74 @@ void verilog_preprocessort::preprocessor()
       error().source_location = context().make_source_location();
     error() << e.what() << eom;
     error_found = true;
+    context_stack.clear();
+    return false;
   }
+}
+
+/*******************************************************************\
+
+Function: verilog_preprocessort::finish
+
+  Inputs:
+
+ Outputs:
 
+ Purpose: throw if any error was found
+
+\*******************************************************************/
+
+void verilog_preprocessort::finish()
+{
   if(error_found)
     throw 0;
 }
 
 /*******************************************************************\
 
+Function: verilog_preprocessor_streambuft::underflow
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: produce the next chunk of preprocessed text
+
+\*******************************************************************/
+
+auto verilog_preprocessor_streambuft::underflow() -> int_type
+{
+  if(gptr() < egptr())
+    return traits_type::to_int_type(*gptr());
+
+  ebmc_phaset phase("preprocess");
+
+  if(!started)
+  {
+    preprocessor.start();
+    started = true;
+  }
+
+  chunk.str(std::string());
+
+  while(!done && static_cast<std::size_t>(chunk.tellp()) < chunk_size)
+  {
+    if(!preprocessor.step())
+      done = true;
+  }
+
+  buffer = chunk.str();
+
+  if(buffer.empty())
+    return traits_type::eof();
+
+  setg(buffer.data(), buffer.data(), buffer.data() + buffer.size());
+
+  return traits_type::to_int_type(*gptr());
+}
+
+/*******************************************************************\
+
 Function: verilog_preprocessort::parse_define_parameters
 
   Inputs:
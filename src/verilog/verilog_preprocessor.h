@@ -11,12 +11,25 @@
 #include <filesystem>
 #include <list>
 #include <map>
+#include <sstream>
+#include <streambuf>
 
 class verilog_preprocessort:public preprocessort
 {
 public:
   virtual void preprocessor();
 
+  // For streaming: start(), then step() until it returns false,
+  // then finish(), which throws if there were errors.
+  void start();
+  bool step();
+  void finish();
+
+  bool has_errors() const
+  {
+    return error_found;
+  }
+
   verilog_preprocessort(
     std::istream &_in,
     std::ostream &_out,
@@ -38,6 +51,8 @@ protected:
   const std::list<std::string> &include_paths;
   const std::list<std::string> &initial_defines;
 
+  bool error_found = false;
+
   using tokent = verilog_preprocessor_token_sourcet::tokent;
 
   struct definet
@@ -173,4 +188,44 @@ protected:
   }
 };
 
+/// A stream buffer that runs the preprocessor on demand, as the
+/// consumer reads, without materializing the full preprocessed text.
+class verilog_preprocessor_streambuft : public std::streambuf
+{
+public:
+  verilog_preprocessor_streambuft(
+    std::istream &_in,
+    message_handlert &_message_handler,
+    const std::string &_filename,
+    const std::list<std::string> &_include_paths,
+    const std::list<std::string> &_initial_defines)
+    : preprocessor(
+        _in,
+        chunk,
+        _message_handler,
+        _filename,
+        _include_paths,
+        _initial_defines)
+  {
+  }
+
+  bool has_errors() const
+  {
+    return preprocessor.has_errors();
+  }
+
+protected:
+  // declared before the preprocessor, which writes into it
+  std::ostringstream chunk;
+  verilog_preprocessort preprocessor;
+
+  std::string buffer;
+  bool started = false, done = false;
+
+  // the preprocessor output is handed out in chunks of this size
+  static constexpr std::size_t chunk_size = 1 << 16;
+
+  int_type underflow() override;
+};
+
 #endif
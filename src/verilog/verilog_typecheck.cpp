@@ -2023,3 +2023,29 @@ bool verilog_typecheck(
 
   return verilog_typecheck.typecheck_main();
 }
+
+/*******************************************************************\
+
+Function: verilog_release_module_sources
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void verilog_release_module_sources(symbol_table_baset &symbol_table)
+{
+  std::vector<irep_idt> modules;
+
+  for(const auto &[identifier, symbol] : symbol_table.symbols)
+  {
+    if(symbol.mode == ID_Verilog && symbol.type.id() == ID_module)
+      modules.push_back(identifier);
+  }
+
+  for(const auto &identifier : modules)
+    symbol_table.get_writeable_ref(identifier).type.remove(ID_module_source);
+}
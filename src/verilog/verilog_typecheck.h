@@ -38,6 +38,11 @@ bool verilog_typecheck(
   verilog_standardt,
   message_handlert &);
 
+/// The module symbols keep their parse tree for instantiating
+/// parameterized modules. This drops them, and is to be called
+/// once type checking is complete.
+void verilog_release_module_sources(symbol_table_baset &);
+
 /*******************************************************************\
 
    Class: verilog_typecheckt
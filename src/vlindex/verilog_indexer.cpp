@@ -13,6 +13,7 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <util/suffix.h>
 #include <util/unicode.h>
 
+#include <verilog/mapped_file.h>
 #include <verilog/verilog_preprocessor.h>
 
 #include "vlindex_parser.h"
@@ -61,12 +62,24 @@ void verilog_indexert::operator()(
   const irep_idt &file_name,
   enum verilog_standardt standard)
 {
-  // run the preprocessor
-  const auto preprocessed_string = preprocess(id2string(file_name));
-  std::istringstream preprocessed(preprocessed_string);
+  // We deliberately fail silently on files that cannot be opened.
+  // Errors on invalid file names are expected to be raised later.
+  mapped_filet mapped_file(id2string(file_name));
+  mapped_istreamt in_stream(mapped_file);
 
-  // set up the tokenizer
   console_message_handlert message_handler;
+
+  // The preprocessor runs as the parser consumes its output.
+  const std::list<std::string> include_paths, initial_defines;
+  verilog_preprocessor_streambuft preprocessor_streambuf(
+    in_stream,
+    message_handler,
+    id2string(file_name),
+    include_paths,
+    initial_defines);
+  std::istream preprocessed(&preprocessor_streambuf);
+
+  // set up the tokenizer
   verilog_indexer_parsert parser(
     preprocessed, *this, standard, message_handler);
   verilog_scanner_init();
@@ -76,35 +89,6 @@ void verilog_indexert::operator()(
   file_map[file_name].number_of_lines = parser.verilog_parser.get_line_no();
 }
 
-std::string verilog_indexert::preprocess(const std::string &file_name)
-{
-  std::stringstream preprocessed;
-
-  auto in_stream = std::ifstream(widen_if_needed(file_name));
-
-  if(!in_stream)
-  {
-    // We deliberately fail silently.
-    // Errors on invalid file names are expected to be raised
-    // later.
-    return std::string();
-  }
-
-  console_message_handlert message_handler;
-  verilog_preprocessort preprocessor(
-    in_stream, preprocessed, message_handler, file_name, {}, {});
-
-  try
-  {
-    preprocessor.preprocessor();
-  }
-  catch(...)
-  {
-  }
-
-  return preprocessed.str();
-}
-
 std::vector<std::filesystem::path> verilog_files()
 {
   std::vector<std::filesystem::path> result;
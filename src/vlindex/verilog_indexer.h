@@ -102,9 +102,6 @@ public:
   std::size_t total_number_of_files() const;
   std::size_t total_number_of_symlinked_files() const;
   std::size_t total_number_of_lines() const;
-
-protected:
-  std::string preprocess(const std::string &file_name);
 };
 
 class cmdlinet;